@@ -128,6 +128,9 @@
 #  define NEBTYPE_RETENTIONDATA_STARTSAVE          1602
 #  define NEBTYPE_RETENTIONDATA_ENDSAVE            1603
 
+/* Configuration load. */
+#  define NEBTYPE_CONFIGURATIONLOAD_END            1700
+
 /* State change. */
 #  define NEBTYPE_STATECHANGE_START                1800    /* NOT IMPLEMENTED. */
 #  define NEBTYPE_STATECHANGE_END                  1801
@@ -263,6 +266,17 @@ void           broker_command_data(
                  int attr,
                  command_struct* cmd,
                  struct timeval const* timestamp);
+void           broker_configuration_load(
+                 int type,
+                 int flags,
+                 int attr,
+                 int reload,
+                 double total_time,
+                 double paused_time,
+                 unsigned int phase_count,
+                 char const* const* phase_names,
+                 double const* phase_times,
+                 struct timeval const* timestamp);
 void           broker_custom_variable(
                  int type,
                  int flags,
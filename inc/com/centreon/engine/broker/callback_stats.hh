@@ -0,0 +1,86 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_BROKER_CALLBACK_STATS_HH
+#  define CCE_BROKER_CALLBACK_STATS_HH
+
+#  include <list>
+#  include <ostream>
+#  include <string>
+#  if !defined(__GNUC__) || !(defined(__i386__) || defined(__x86_64__))
+#    include <sys/time.h>
+#  endif // !GCC on x86
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace              broker {
+  /**
+   *  Cost accounting of the callbacks made to broker modules.
+   *
+   *  Counters are stored in the callback list itself and are updated
+   *  by neb_make_callbacks() when enable_neb_callback_stats is set.
+   */
+  namespace            callback_stats {
+    /**
+     *  @struct entry callback_stats.hh
+     *  @brief Aggregated cost of one callback type of one module.
+     */
+    struct             entry {
+      int              callback_type;
+      unsigned long long
+                       calls;
+      unsigned long long
+                       cancels;
+      double           max_time;
+      std::string      module;
+      unsigned long long
+                       overrides;
+      double           total_time;
+    };
+
+    void               get(std::list<entry>& entries);
+    void               log();
+    void               reset();
+    std::ostream&      save(std::ostream& os);
+
+    /**
+     *  Read the cheapest monotonic tick counter available. Ticks are
+     *  converted to seconds only when statistics are reported.
+     *
+     *  @return Current tick count.
+     */
+    inline unsigned long long ticks() throw () {
+#  if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+      unsigned int lo;
+      unsigned int hi;
+      __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+      return ((static_cast<unsigned long long>(hi) << 32) | lo);
+#  else
+      timeval tv;
+      gettimeofday(&tv, NULL);
+      return (tv.tv_sec * 1000000ull + tv.tv_usec);
+#  endif // GCC on x86
+    }
+  }
+}
+
+CCE_END()
+
+#endif // !CCE_BROKER_CALLBACK_STATS_HH
@@ -0,0 +1,111 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_ADMISSION_HH
+#  define CCE_CHECKS_ADMISSION_HH
+
+#  include <deque>
+#  include <string>
+#  include <utility>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/service.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace                checks {
+  /**
+   *  @class admission admission.hh
+   *  @brief Limit the number of concurrent service checks.
+   *
+   *  Service checks are admitted by the event loop before they are
+   *  run. A check is admitted if the global limit
+   *  (max_concurrent_checks or the adaptive limit), the limit of its host
+   *  (max_concurrent_checks_per_host) and the limit of its command
+   *  (max_concurrent_checks_per_command) are not reached. Otherwise it
+   *  waits in the queue of the first limit reached and its event is
+   *  moved back to the current time as soon as a slot is released.
+   *  Queues are first in, first out.
+   */
+  class                  admission {
+  public:
+    bool                 acquire(service* svc, bool force = false);
+    unsigned int         deferred() const throw ();
+    static admission&    instance();
+    static void          load();
+    void                 release(
+                           std::string const& host_name,
+                           std::string const& service_description);
+    static void          unload();
+
+  private:
+    typedef std::pair<std::string, std::string>
+                         service_id;
+
+    /**
+     *  @struct slots admission.hh
+     *  @brief Running and waiting checks of one limit.
+     */
+    struct               slots {
+                         slots() : limit(0), running(0) {}
+
+      unsigned int       limit;
+      unsigned int       running;
+      std::deque<service_id>
+                         waiting;
+    };
+
+    /**
+     *  @struct holder admission.hh
+     *  @brief Limits held by an admitted service check.
+     */
+    struct               holder {
+      std::string        command;
+      std::string        host;
+    };
+
+                         admission();
+                         admission(admission const& right);
+                         ~admission() throw ();
+    admission&           operator=(admission const& right);
+    void                 _defer(slots& s, service_id const& id);
+    static bool          _is_available(
+                           slots const& s,
+                           service_id const& id);
+    void                 _release(
+                           umap<std::string, slots>& keys,
+                           std::string const& key,
+                           unsigned int limit);
+    void                 _wake(slots& s);
+
+    umap<service_id, holder>
+                         _admitted;
+    umap<std::string, slots>
+                         _commands;
+    umap<service_id, slots*>
+                         _deferred;
+    slots                _global;
+    umap<std::string, slots>
+                         _hosts;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CHECKS_ADMISSION_HH
@@ -20,7 +20,10 @@
 #ifndef CCE_CHECKS_CHECKER_HH
 #  define CCE_CHECKS_CHECKER_HH
 
+#  include <list>
 #  include <queue>
+#  include <string>
+#  include <vector>
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/checks.hh"
 #  include "com/centreon/engine/commands/command.hh"
@@ -44,6 +47,8 @@ namespace                checks {
   class                  checker
     : public commands::command_listener {
   public:
+    unsigned long long   coalesced_checks() const throw ();
+    unsigned long long   executed_checks() const throw ();
     static checker&      instance();
     static void          load();
     void                 push_check_result(
@@ -75,12 +80,42 @@ namespace                checks {
     static void          unload();
 
   private:
+    /**
+     *  @struct flight checker.hh
+     *  @brief Command line in execution and the checks waiting for it.
+     */
+    struct               flight {
+      std::string        command_line;
+      time_t             start_time;
+      std::list<check_result>
+                         waiters;
+    };
+
                          checker();
                          checker(checker const& right);
                          ~checker() throw ();
     checker&             operator=(checker const& right);
     void                 finished(commands::result const& res) throw ();
+    void                 finished_batch(
+                           std::vector<commands::result> const& results)
+                           throw ();
+    bool                 _attach(
+                           std::string const& processed_cmd,
+                           check_result const& info);
     int                  _execute_sync(host* hst);
+    void                 _register(
+                           unsigned long id,
+                           std::string const& processed_cmd);
+    static void          _to_check_result(
+                           commands::result const& res,
+                           check_result& result);
+
+    unsigned long long   _coalesced;
+    unsigned long long   _executed;
+    umap<unsigned long, flight>
+                         _flights;
+    umap<std::string, unsigned long>
+                         _flights_by_cmd;
 
     umap<unsigned long, check_result>
                          _list_id;
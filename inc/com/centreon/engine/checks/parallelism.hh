@@ -0,0 +1,78 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_PARALLELISM_HH
+#  define CCE_CHECKS_PARALLELISM_HH
+
+#  include <ctime>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace                checks {
+  /**
+   *  @class parallelism parallelism.hh
+   *  @brief Adapt the number of concurrent service checks.
+   *
+   *  When use_adaptive_concurrent_checks is set, the limit of
+   *  concurrent service checks is adjusted periodically between
+   *  min_concurrent_checks and max_concurrent_checks. It starts at
+   *  max_concurrent_checks. It grows while
+   *  checks wait for a slot and start late, and it shrinks when the
+   *  run queue of the system is overloaded or when the last increase
+   *  lowered the check completion rate.
+   */
+  class                  parallelism {
+  public:
+    void                 check_completed() throw ();
+    void                 check_deferred() throw ();
+    void                 check_started(double latency) throw ();
+    double               completion_rate() const throw ();
+    static parallelism&  instance();
+    double               latency() const throw ();
+    unsigned int         limit() const throw ();
+    static void          load();
+    double               run_queue_load() const throw ();
+    static void          unload();
+    void                 update(time_t now);
+    void                 update(time_t now, double run_queue_load);
+
+  private:
+                         parallelism();
+                         parallelism(parallelism const& right);
+                         ~parallelism() throw ();
+    parallelism&         operator=(parallelism const& right);
+    static void          _bounds(unsigned int& min, unsigned int& max);
+
+    unsigned long        _completed;
+    unsigned long        _deferred;
+    double               _completion_rate;
+    int                  _last_action;
+    time_t               _last_update;
+    double               _latency;
+    double               _latency_sum;
+    unsigned int         _limit;
+    double               _run_queue_load;
+    unsigned long        _started;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CHECKS_PARALLELISM_HH
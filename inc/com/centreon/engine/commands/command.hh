@@ -21,6 +21,7 @@
 #  define CCE_COMMANDS_COMMAND_HH
 
 #  include <string>
+#  include <vector>
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/commands/command_listener.hh"
 #  include "com/centreon/engine/commands/result.hh"
@@ -66,6 +67,9 @@ namespace                      commands {
                                  std::string const& command_line);
     void                       set_listener(
                                  command_listener* listener) throw ();
+    static void                split(
+                                 std::string const& command_line,
+                                 std::vector<std::string>& args);
 
   protected:
                                command(command const& right);
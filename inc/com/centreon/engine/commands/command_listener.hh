@@ -20,6 +20,7 @@
 #ifndef CCE_COMMANDS_COMMAND_LISTENER_HH
 #  define CCE_COMMANDS_COMMAND_LISTENER_HH
 
+#  include <vector>
 #  include "com/centreon/engine/commands/result.hh"
 #  include "com/centreon/engine/namespace.hh"
 
@@ -36,6 +37,23 @@ namespace        commands {
   public:
     virtual      ~command_listener() throw () {}
     virtual void finished(result const& res) throw () = 0;
+
+    /**
+     *  Notify the completion of several commands at once. Listeners
+     *  that synchronize their result queue can override it to do it
+     *  once per batch.
+     *
+     *  @param[in] results  Results of the completed commands.
+     */
+    virtual void finished_batch(
+                   std::vector<result> const& results) throw () {
+      for (std::vector<result>::const_iterator
+             it(results.begin()), end(results.end());
+           it != end;
+           ++it)
+        finished(*it);
+      return ;
+    }
   };
 }
 
@@ -0,0 +1,97 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_HANDLER_RUNNER_HH
+#  define CCE_COMMANDS_HANDLER_RUNNER_HH
+
+#  include <deque>
+#  include <string>
+#  include <sys/time.h>
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/engine/commands/command_listener.hh"
+#  include "com/centreon/engine/commands/raw.hh"
+#  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace                commands {
+  /**
+   *  @class handler_runner handler_runner.hh
+   *  @brief Run event handlers and obsessive commands asynchronously.
+   *
+   *  Commands are started without waiting for their completion. The
+   *  completion is logged and sent to the event broker from the main
+   *  loop by reap(). The number of concurrent commands is limited by
+   *  the max_concurrent_event_handlers option.
+   */
+  class                  handler_runner
+    : public command_listener {
+  public:
+    /**
+     *  @struct job handler_runner.hh
+     *  @brief Command to run and what is needed to report it.
+     */
+    struct               job {
+                         job();
+
+      std::string        command_line;
+      std::string        command_name;
+      int                handler_type;
+      std::string        host_name;
+      std::string        service_description;
+      timeval            start_time;
+      int                state;
+      int                state_type;
+      unsigned int       timeout;
+      std::string        timeout_message;
+    };
+
+    static handler_runner&
+                         instance();
+    static void          load();
+    void                 reap();
+    unsigned int         running() const throw ();
+    void                 run(job const& j);
+    static void          unload();
+    unsigned int         waiting() const throw ();
+
+  private:
+                         handler_runner();
+                         handler_runner(handler_runner const& right);
+                         ~handler_runner() throw ();
+    handler_runner&      operator=(handler_runner const& right);
+    void                 _complete(job& j, result const& res);
+    void                 _launch(job& j);
+    void                 finished(result const& res) throw ();
+
+    umap<unsigned long, result>
+                         _finished;
+    concurrency::mutex   _mut_finished;
+    umap<unsigned long, job>
+                         _running;
+    std::deque<job>      _waiting;
+    raw                  _raw;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_COMMANDS_HANDLER_RUNNER_HH
@@ -0,0 +1,63 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_NATIVE_HH
+#  define CCE_COMMANDS_NATIVE_HH
+
+#  include <string>
+#  include "com/centreon/engine/commands/command.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace               commands {
+  /**
+   *  @class native native.hh
+   *  @brief Native is a specific implementation of command.
+   *
+   *  Native commands call a check plugin loaded in the engine instead
+   *  of executing a process. The first word of the command line is the
+   *  path of the plugin shared object, the following ones are its
+   *  arguments. Checks are run by the native_pool workers.
+   */
+  class                 native : public command {
+  public:
+                        native(
+                          std::string const& name,
+                          std::string const& command_line,
+                          command_listener* listener = NULL);
+                        native(native const& right);
+                        ~native() throw ();
+    native&             operator=(native const& right);
+    command*            clone() const;
+    unsigned long       run(
+                          std::string const& process_cmd,
+                          nagios_macros& macros,
+                          unsigned int timeout);
+    void                run(
+                          std::string const& process_cmd,
+                          nagios_macros& macros,
+                          unsigned int timeout,
+                          result& res);
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_COMMANDS_NATIVE_HH
@@ -0,0 +1,67 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_NATIVE_CHECK_HH
+#  define CCE_COMMANDS_NATIVE_CHECK_HH
+
+/*
+** Native check plugins are shared objects loaded by the engine and
+** run by its worker threads, without forking. A plugin must declare
+** its API version with NATIVE_CHECK_API_VERSION() and export the
+** native_check() function. This header can be included from C.
+*/
+
+/* Plugin version information. */
+#  define NATIVE_CHECK_API_VERSION(x) int __native_check_api_version = x;
+#  define CURRENT_NATIVE_CHECK_API_VERSION 1
+
+/**
+ *  @struct native_check_args native_check.hh "com/centreon/engine/commands/native_check.hh"
+ *  @brief Arguments given to a native check.
+ *
+ *  argv[0] is the plugin path, like for an executable plugin. The
+ *  output buffer must be filled with a nul-terminated string of at
+ *  most output_size bytes. A check that can last should poll the
+ *  cancelled flag, which is set when its timeout expires or when the
+ *  engine stops, and return as soon as possible afterwards.
+ */
+typedef struct          native_check_args_struct {
+  int                   argc;
+  char const* const*    argv;
+  int const volatile*   cancelled;
+  char*                 output;
+  unsigned int          output_size;
+  unsigned int          timeout;
+}                       native_check_args;
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif /* C++ */
+
+/*
+** Run the check and return its state (0 to 3). This function is
+** called concurrently from several threads and must be reentrant.
+*/
+int native_check(native_check_args* args);
+
+#  ifdef __cplusplus
+}
+#  endif /* C++ */
+
+#endif // !CCE_COMMANDS_NATIVE_CHECK_HH
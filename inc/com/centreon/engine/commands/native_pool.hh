@@ -0,0 +1,138 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_NATIVE_POOL_HH
+#  define CCE_COMMANDS_NATIVE_POOL_HH
+
+#  include <deque>
+#  include <list>
+#  include <string>
+#  include <utility>
+#  include <vector>
+#  include "com/centreon/concurrency/condvar.hh"
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/commands/command_listener.hh"
+#  include "com/centreon/engine/commands/native_check.hh"
+#  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/library.hh"
+#  include "com/centreon/shared_ptr.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace                commands {
+  /**
+   *  @class native_pool native_pool.hh
+   *  @brief Run native check plugins on worker threads.
+   *
+   *  Checks are queued and run by at most native_check_workers
+   *  threads, which are started on demand. A watchdog thread reports
+   *  the checks whose timeout expired, sets their cancelled flag and
+   *  drops their late result. Plugins stay loaded until the pool is
+   *  unloaded, so a running check never loses its code. A plugin
+   *  that ignores its cancelled flag keeps its worker busy and
+   *  delays the engine shutdown.
+   */
+  class                  native_pool {
+  public:
+    typedef int          (*check_func)(native_check_args*);
+
+    check_func           find(std::string const& path);
+    static native_pool&  instance();
+    static void          load();
+    void                 run(
+                           unsigned long command_id,
+                           check_func func,
+                           std::vector<std::string> const& args,
+                           unsigned int timeout,
+                           command_listener* listener);
+    unsigned int         running() const;
+    static void          unload();
+    unsigned int         waiting() const;
+    unsigned int         workers() const;
+
+  private:
+    struct               job {
+      std::vector<std::string>
+                         args;
+      int volatile       cancelled;
+      unsigned long      command_id;
+      unsigned long long deadline;
+      bool               delivered;
+      check_func         func;
+      command_listener*  listener;
+      timestamp          start_time;
+      unsigned int       timeout;
+    };
+
+    struct               plugin {
+      check_func         func;
+      shared_ptr<library>
+                         lib;
+    };
+
+    class                worker : public concurrency::thread {
+    public:
+                         worker(
+                           native_pool& pool,
+                           void (native_pool::*routine)());
+                         ~worker() throw ();
+
+    private:
+                         worker(worker const& right);
+      worker&            operator=(worker const& right);
+      void               _run();
+
+      native_pool&       _pool;
+      void               (native_pool::*_routine)();
+    };
+
+    typedef std::pair<command_listener*, result>
+                         delivery;
+
+                         native_pool();
+                         native_pool(native_pool const& right);
+                         ~native_pool() throw ();
+    native_pool&         operator=(native_pool const& right);
+    static void          _execute(job& j, result& res);
+    static void          _timeout(job const& j, result& res);
+    void                 _watch();
+    void                 _work();
+
+    std::list<job*>      _running;
+    unsigned int         _idle;
+    mutable concurrency::mutex
+                         _lock;
+    concurrency::condvar _cv_watch;
+    concurrency::condvar _cv_work;
+    concurrency::mutex   _mut_plugins;
+    umap<std::string, plugin>
+                         _plugins;
+    bool                 _quit;
+    std::deque<job*>     _waiting;
+    worker*              _watchdog;
+    std::list<worker*>   _workers;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_COMMANDS_NATIVE_POOL_HH
@@ -20,14 +20,9 @@
 #ifndef CCE_COMMANDS_RAW_HH
 #  define CCE_COMMANDS_RAW_HH
 
-#  include <list>
 #  include <string>
-#  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/commands/command.hh"
 #  include "com/centreon/engine/namespace.hh"
-#  include "com/centreon/process.hh"
-#  include "com/centreon/process_listener.hh"
-#  include "com/centreon/unordered_hash.hh"
 
 CCE_BEGIN()
 
@@ -36,11 +31,10 @@ namespace               commands {
    *  @class raw raw.hh
    *  @brief Raw is a specific implementation of command.
    *
-   *  Raw is a specific implementation of command.
+   *  Raw is a specific implementation of command. Asynchronous runs
+   *  are handed to the process reactor, which owns the children.
    */
-  class                 raw
-    : public command,
-      public process_listener {
+  class                 raw : public command {
   public:
                         raw(
                           std::string const& name,
@@ -59,17 +53,6 @@ namespace               commands {
                           nagios_macros& macros,
                           unsigned int timeout,
                           result& res);
-
-  private:
-    void                data_is_available(process& p) throw ();
-    void                data_is_available_err(process& p) throw ();
-    void                finished(process& p) throw ();
-    process*            _get_free_process();
-
-    concurrency::mutex  _lock;
-    umap<process*, unsigned long>
-                        _processes_busy;
-    std::list<process*> _processes_free;
   };
 }
 
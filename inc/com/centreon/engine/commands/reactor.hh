@@ -0,0 +1,140 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_REACTOR_HH
+#  define CCE_COMMANDS_REACTOR_HH
+
+#  include <string>
+#  include <sys/types.h>
+#  include <utility>
+#  include <vector>
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/commands/command_listener.hh"
+#  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace                commands {
+  /**
+   *  @class reactor reactor.hh
+   *  @brief Run child processes and collect their output.
+   *
+   *  Children are spawned without SIGCHLD notification, so that only
+   *  the reactor reaps them. One thread watches their stdout and
+   *  stderr pipes and their pidfd on a single epoll set, reads output
+   *  as it arrives and enforces timeouts with a timer wheel. Results
+   *  completed in the same iteration are delivered to each listener
+   *  as one batch. Child slots and their buffers are reused.
+   */
+  class                  reactor {
+  public:
+    static reactor&      instance();
+    static void          load();
+    void                 run(
+                           unsigned long command_id,
+                           std::vector<std::string> const& args,
+                           unsigned int timeout,
+                           command_listener* listener);
+    unsigned int         running() const;
+    unsigned long long   spawned() const;
+    static void          unload();
+    unsigned long long   wakeups() const;
+
+  private:
+    struct               child {
+      unsigned long      command_id;
+      unsigned long long deadline;
+      std::string        err;
+      bool               exited;
+      int                fd_err;
+      int                fd_out;
+      int                fd_pid;
+      bool               group;
+      unsigned int       index;
+      command_listener*  listener;
+      child*             next;
+      std::string        out;
+      pid_t              pid;
+      child*             prev;
+      unsigned int       slot;
+      timestamp          start_time;
+      int                status;
+      bool               timed_out;
+    };
+
+    class                loop : public concurrency::thread {
+    public:
+                         loop(reactor& r);
+                         ~loop() throw ();
+
+    private:
+                         loop(loop const& right);
+      loop&              operator=(loop const& right);
+      void               _run();
+
+      reactor&           _r;
+    };
+
+    typedef std::pair<command_listener*, std::vector<result> >
+                         batch;
+
+                         reactor();
+                         reactor(reactor const& right);
+                         ~reactor() throw ();
+    reactor&             operator=(reactor const& right);
+    void                 _arm(child* c);
+    void                 _close(int& fd);
+    void                 _complete(child* c);
+    void                 _deliver();
+    void                 _disarm(child* c);
+    void                 _expire(unsigned long long now);
+    static bool          _read(int fd, std::string& buffer);
+    void                 _reap(child* c);
+    void                 _run();
+    static unsigned long long
+                         _tick(unsigned long long msecs) throw ();
+    void                 _wake();
+
+    std::vector<batch>   _batches;
+    std::vector<child*>  _children;
+    int                  _dev_null;
+    int                  _epoll;
+    int                  _event;
+    std::vector<unsigned int>
+                         _free;
+    unsigned long long   _last_tick;
+    mutable concurrency::mutex
+                         _lock;
+    loop                 _loop;
+    std::vector<child*>  _polling;
+    bool                 _quit;
+    unsigned int         _running;
+    unsigned long long   _spawned;
+    bool                 _sleeping;
+    unsigned int         _timers;
+    unsigned long long   _wakeups;
+    std::vector<child*>  _wheel;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_COMMANDS_REACTOR_HH
@@ -102,6 +102,8 @@
 #  define CMD_CHANGE_HOST_MODATTR                            165
 #  define CMD_CHANGE_SVC_MODATTR                             166
 #  define CMD_RELOAD_PROCESS                                 200
+#  define CMD_DUMP_NEB_CALLBACK_STATS                        201
+#  define CMD_RESET_NEB_CALLBACK_STATS                       202
 #  define CMD_CUSTOM_COMMAND                                 999
 
 /* Service check types. */
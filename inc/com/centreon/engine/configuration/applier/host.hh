@@ -44,6 +44,9 @@ namespace          configuration {
                      configuration::state& s);
       void         modify_object(
                      shared_ptr<configuration::host> obj);
+      void         prepare_object(
+                     shared_ptr<configuration::host> obj,
+                     bool resolve);
       void         remove_object(
                      shared_ptr<configuration::host> obj);
       void         resolve_object(
@@ -31,6 +31,9 @@
 
 #  define NULL_IF_EMPTY(str) ((str).empty() ? NULL : (str).c_str())
 
+// Forward declaration.
+struct command_struct;
+
 CCE_BEGIN()
 
 namespace          configuration {
@@ -70,6 +73,9 @@ namespace          configuration {
       virtual void _remove_object(shared_ptr<T> obj) = 0;
     };
 
+    // Find the command of a "name!arguments" command line.
+    command_struct* find_command_of(char const* command_line);
+
     template <typename T>
     void modify_if_different(T& t1, T t2) {
       if (t1 != t2)
@@ -79,6 +85,8 @@ namespace          configuration {
 
     void modify_if_different(char*& s1, char const* s2);
 
+    void modify_interned_if_different(char*& s1, char const* s2);
+
     void modify_if_different(
            char** t1,
            std::vector<std::string> const& t2,
@@ -92,6 +100,35 @@ namespace          configuration {
           break ;
         }
     }
+
+    template<typename T>
+    void unregister_dependency(T** lst, T* ptr) {
+      for (T** node(lst); *node; node = &(*node)->next_dependency)
+        if (*node == ptr) {
+          (*node) = (*node)->next_dependency;
+          break ;
+        }
+      ptr->next_dependency = NULL;
+    }
+
+    template<typename T>
+    void unlink_object(T** lst, T* ptr) {
+      T* prev(ptr->prev);
+      if (!prev && (*lst != ptr)) {
+        // Object was not linked with its predecessor, walk the list.
+        for (prev = *lst; prev && (prev->next != ptr); prev = prev->next)
+          ;
+        if (!prev)
+          return ;
+      }
+      if (prev)
+        prev->next = ptr->next;
+      else
+        *lst = ptr->next;
+      if (ptr->next)
+        ptr->next->prev = prev;
+      return ;
+    }
   }
 }
 
@@ -0,0 +1,163 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_APPLIER_REFERENCE_INDEX_HH
+#  define CCE_CONFIGURATION_APPLIER_REFERENCE_INDEX_HH
+
+#  include <set>
+#  include <string>
+#  include "com/centreon/engine/configuration/applier/difference.hh"
+#  include "com/centreon/engine/configuration/command.hh"
+#  include "com/centreon/engine/configuration/host.hh"
+#  include "com/centreon/engine/configuration/hostdependency.hh"
+#  include "com/centreon/engine/configuration/service.hh"
+#  include "com/centreon/engine/configuration/servicedependency.hh"
+#  include "com/centreon/engine/configuration/state.hh"
+#  include "com/centreon/engine/configuration/timeperiod.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/shared_ptr.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace               configuration {
+  namespace             applier {
+    /**
+     *  @class reference_index reference_index.hh
+     *  @brief Reverse index of the references between objects.
+     *
+     *  For every referenced object, record the objects that refer to
+     *  it by name (command and time period users, host parents and
+     *  services, dependencies). On reload, this gives the objects to
+     *  resolve again when an object they refer to appears or goes
+     *  away, without walking the whole configuration.
+     */
+    class               reference_index {
+    public:
+      /**
+       *  @struct users reference_index.hh
+       *  @brief Objects referring to one object.
+       */
+      struct            users {
+        bool            empty() const throw ();
+        void            merge(users const& other);
+
+        set_string      commands;
+        set_hostdependency
+                        hostdependencies;
+        set_string      hosts;
+        set_servicedependency
+                        servicedependencies;
+        std::set<configuration::service::key_type>
+                        services;
+        set_string      timeperiods;
+      };
+
+                        reference_index();
+                        reference_index(reference_index const& right);
+                        ~reference_index() throw ();
+      reference_index&  operator=(reference_index const& right);
+      void              add(
+                          shared_ptr<configuration::command> const& obj);
+      void              add(
+                          shared_ptr<configuration::host> const& obj);
+      void              add(
+                          shared_ptr<configuration::hostdependency> const& obj);
+      void              add(
+                          shared_ptr<configuration::service> const& obj);
+      void              add(
+                          shared_ptr<configuration::servicedependency> const&
+                            obj);
+      void              add(
+                          shared_ptr<configuration::timeperiod> const& obj);
+      void              clear();
+      users const*      command_users(
+                          configuration::command::key_type const& k) const;
+      users const*      connector_users(
+                          std::string const& name) const;
+      users const*      host_users(
+                          configuration::host::key_type const& k) const;
+      void              remove(
+                          shared_ptr<configuration::command> const& obj);
+      void              remove(
+                          shared_ptr<configuration::host> const& obj);
+      void              remove(
+                          shared_ptr<configuration::hostdependency> const& obj);
+      void              remove(
+                          shared_ptr<configuration::service> const& obj);
+      void              remove(
+                          shared_ptr<configuration::servicedependency> const&
+                            obj);
+      void              remove(
+                          shared_ptr<configuration::timeperiod> const& obj);
+      void              select_changes(
+                          configuration::state const& new_cfg,
+                          difference<set_timeperiod> const& diff_timeperiods,
+                          difference<set_connector> const& diff_connectors,
+                          difference<set_command> const& diff_commands,
+                          difference<set_host> const& diff_hosts,
+                          difference<set_service> const& diff_services,
+                          difference<set_hostdependency> const&
+                            diff_hostdependencies,
+                          difference<set_servicedependency> const&
+                            diff_servicedependencies,
+                          configuration::state& changed) const;
+      users const*      service_users(
+                          configuration::service::key_type const& k) const;
+      users const*      timeperiod_users(
+                          configuration::timeperiod::key_type const& k) const;
+
+    private:
+      void              _update(
+                          configuration::command const& obj,
+                          bool add);
+      void              _update(
+                          configuration::host const& obj,
+                          bool add);
+      void              _update(
+                          shared_ptr<configuration::hostdependency> const& obj,
+                          bool add);
+      void              _update(
+                          configuration::service const& obj,
+                          bool add);
+      void              _update(
+                          shared_ptr<configuration::servicedependency> const&
+                            obj,
+                          bool add);
+      void              _update(
+                          configuration::timeperiod const& obj,
+                          bool add);
+
+      umap<std::string, users>
+                        _commands;
+      umap<std::string, users>
+                        _connectors;
+      umap<std::string, users>
+                        _hosts;
+      umap<configuration::service::key_type, users>
+                        _services;
+      umap<std::string, users>
+                        _timeperiods;
+    };
+  }
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_APPLIER_REFERENCE_INDEX_HH
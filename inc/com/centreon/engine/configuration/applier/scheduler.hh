@@ -20,6 +20,7 @@
 #ifndef CCE_CONFIGURATION_APPLIER_SCHEDULER_HH
 #  define CCE_CONFIGURATION_APPLIER_SCHEDULER_HH
 
+#  include <ctime>
 #  include <vector>
 #  include "com/centreon/engine/configuration/applier/difference.hh"
 #  include "com/centreon/engine/configuration/state.hh"
@@ -53,13 +54,27 @@ namespace                 configuration {
       static void         load();
       void                remove_host(configuration::host const& h);
       void                remove_service(configuration::service const& s);
+      time_t              spread_check(
+                            time_t last_check,
+                            time_t preferred,
+                            double execution_time);
       static void         unload();
 
     private:
+      /**
+       *  @struct load_slot scheduler.hh
+       *  @brief Projected check load of one second.
+       */
+      struct              load_slot {
+        time_t            time;
+        double            load;
+      };
+
                           scheduler();
                           scheduler(scheduler const&);
                           ~scheduler() throw ();
       scheduler&          operator=(scheduler const&);
+      void                _add_load(time_t start, double execution_time);
       void                _apply_misc_event();
       void                _calculate_host_inter_check_delay();
       void                _calculate_host_scheduling_params();
@@ -71,6 +86,7 @@ namespace                 configuration {
                             time_t start,
                             unsigned long interval,
                             void* data = NULL);
+      double              _get_load(time_t t) const throw ();
       void                _get_hosts(
                             set_host const& hst_added,
                             std::vector<host_struct*>& new_hosts,
@@ -96,6 +112,8 @@ namespace                 configuration {
       timed_event_struct* _evt_retention_save;
       timed_event_struct* _evt_sfreshness_check;
       timed_event_struct* _evt_status_save;
+      std::vector<load_slot>
+                          _load;
       unsigned int        _old_check_reaper_interval;
       int                 _old_command_check_interval;
       unsigned int        _old_host_freshness_check_interval;
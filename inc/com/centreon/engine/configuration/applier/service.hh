@@ -44,6 +44,9 @@ namespace             configuration {
                         configuration::state& s);
       void            modify_object(
                         shared_ptr<configuration::service> obj);
+      void            prepare_object(
+                        shared_ptr<configuration::service> obj,
+                        bool resolve);
       void            remove_object(
                         shared_ptr<configuration::service> obj);
       void            resolve_object(
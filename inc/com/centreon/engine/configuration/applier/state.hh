@@ -25,6 +25,7 @@
 #  include "com/centreon/concurrency/condvar.hh"
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/configuration/applier/difference.hh"
+#  include "com/centreon/engine/configuration/applier/reference_index.hh"
 #  include "com/centreon/engine/configuration/state.hh"
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/shared_ptr.hh"
@@ -102,6 +103,10 @@ namespace           configuration {
                     hostdependencies_find(configuration::hostdependency::key_type const& k) const;
       umultimap<std::string, shared_ptr<hostdependency_struct> >::iterator
                     hostdependencies_find(configuration::hostdependency::key_type const& k);
+      umap<std::string, shared_ptr<host_struct> >&
+                    prepared_hosts() throw ();
+      umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >&
+                    prepared_services() throw ();
       umap<std::pair<std::string, std::string>, shared_ptr<service_struct> > const&
                     services() const throw ();
       umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >&
@@ -153,6 +158,11 @@ namespace           configuration {
       void          _expand(
                       configuration::state& new_state,
                       std::set<shared_ptr<ConfigurationType> >& cfg);
+      template      <typename ConfigurationType,
+                     typename ApplierType>
+      void          _prepare(
+                      std::set<shared_ptr<ConfigurationType> > const& cfg,
+                      bool resolve);
       void          _processing(
                       configuration::state& new_cfg,
                       bool waiting_thread,
@@ -176,8 +186,14 @@ namespace           configuration {
                     _hostdependencies;
       concurrency::mutex
                     _lock;
+      umap<std::string, shared_ptr<host_struct> >
+                    _prepared_hosts;
+      umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >
+                    _prepared_services;
       processing_state
                     _processing_state;
+      reference_index
+                    _references;
       umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >
                     _services;
       umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency_struct> >
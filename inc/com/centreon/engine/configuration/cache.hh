@@ -0,0 +1,62 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_CACHE_HH
+#  define CCE_CONFIGURATION_CACHE_HH
+
+#  include <list>
+#  include <string>
+#  include "com/centreon/engine/configuration/object.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace          configuration {
+  /**
+   *  @class cache cache.hh "com/centreon/engine/configuration/cache.hh"
+   *  @brief Binary snapshot of resolved configuration objects.
+   *
+   *  The snapshot is only valid for the object files it was built
+   *  from: their paths, sizes, inodes and times are recorded when the
+   *  cache is created, before the files are parsed, and checked again
+   *  on load.
+   */
+  class            cache {
+  public:
+                   cache(
+                     std::string const& path,
+                     std::list<std::string> const& sources,
+                     unsigned int read_options);
+                   ~cache() throw ();
+    bool           load(list_object& objects);
+    void           save(list_object const& objects);
+
+  private:
+                   cache(cache const& right);
+    cache&         operator=(cache const& right);
+
+    std::string    _path;
+    std::string    _sources;
+    bool           _stable;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_CACHE_HH
@@ -0,0 +1,83 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_CACHE_READER_HH
+#  define CCE_CONFIGURATION_CACHE_READER_HH
+
+#  include <cstddef>
+#  include <list>
+#  include <map>
+#  include <string>
+#  include "com/centreon/engine/configuration/duration.hh"
+#  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/opt.hh"
+
+CCE_BEGIN()
+
+namespace          configuration {
+  /**
+   *  @class cache_reader cache_reader.hh "com/centreon/engine/configuration/cache_reader.hh"
+   *  @brief Read back properties written by cache_writer.
+   *
+   *  The reader does not own the data. Reading past its end throws.
+   */
+  class            cache_reader {
+  public:
+                   cache_reader(char const* data, std::size_t size);
+                   ~cache_reader() throw ();
+    bool           at_end() const throw ();
+    char const*    position() const throw ();
+    cache_reader&  operator>>(bool& value);
+    cache_reader&  operator>>(unsigned short& value);
+    cache_reader&  operator>>(int& value);
+    cache_reader&  operator>>(unsigned int& value);
+    cache_reader&  operator>>(long& value);
+    cache_reader&  operator>>(unsigned long& value);
+    cache_reader&  operator>>(unsigned long long& value);
+    cache_reader&  operator>>(duration& value);
+    cache_reader&  operator>>(group& value);
+    cache_reader&  operator>>(std::list<std::string>& value);
+    cache_reader&  operator>>(
+                     std::map<std::string, std::string>& value);
+    cache_reader&  operator>>(std::string& value);
+    template <typename T>
+    cache_reader&  operator>>(opt<T>& value) {
+      bool is_set;
+      *this >> is_set >> value.get();
+      if (is_set)
+        value.set(value.get());
+      else
+        value.reset();
+      return (*this);
+    }
+
+  private:
+                   cache_reader(cache_reader const& right);
+    cache_reader&  operator=(cache_reader const& right);
+    void           _read(void* data, std::size_t size);
+
+    char const*    _current;
+    char const*    _end;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_CACHE_READER_HH
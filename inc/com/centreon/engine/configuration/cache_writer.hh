@@ -0,0 +1,78 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_CACHE_WRITER_HH
+#  define CCE_CONFIGURATION_CACHE_WRITER_HH
+
+#  include <cstddef>
+#  include <list>
+#  include <map>
+#  include <string>
+#  include "com/centreon/engine/configuration/duration.hh"
+#  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/opt.hh"
+
+CCE_BEGIN()
+
+namespace          configuration {
+  /**
+   *  @class cache_writer cache_writer.hh "com/centreon/engine/configuration/cache_writer.hh"
+   *  @brief Serialize configuration properties for the cache.
+   *
+   *  Values are appended in native byte order, the cache is only
+   *  meant to be read back on the same host. Read them back in the
+   *  same order with cache_reader.
+   */
+  class            cache_writer {
+  public:
+                   cache_writer();
+                   ~cache_writer() throw ();
+    std::string const&
+                   data() const throw ();
+    cache_writer&  operator<<(bool value);
+    cache_writer&  operator<<(unsigned short value);
+    cache_writer&  operator<<(int value);
+    cache_writer&  operator<<(unsigned int value);
+    cache_writer&  operator<<(long value);
+    cache_writer&  operator<<(unsigned long value);
+    cache_writer&  operator<<(unsigned long long value);
+    cache_writer&  operator<<(duration const& value);
+    cache_writer&  operator<<(group const& value);
+    cache_writer&  operator<<(std::list<std::string> const& value);
+    cache_writer&  operator<<(
+                     std::map<std::string, std::string> const& value);
+    cache_writer&  operator<<(std::string const& value);
+    template <typename T>
+    cache_writer&  operator<<(opt<T> const& value) {
+      return (*this << value.is_set() << value.get());
+    }
+
+  private:
+                   cache_writer(cache_writer const& right);
+    cache_writer&  operator=(cache_writer const& right);
+    void           _write(void const* data, std::size_t size);
+
+    std::string    _data;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_CACHE_WRITER_HH
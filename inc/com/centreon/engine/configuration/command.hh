@@ -24,6 +24,7 @@
 #  include <string>
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/opt.hh"
 
 CCE_BEGIN()
 
@@ -44,12 +45,16 @@ namespace                  configuration {
                              command const& right) const throw ();
     void                   check_validity() const;
     key_type const&        key() const throw ();
+    void                   load(cache_reader& r);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    void                   save(cache_writer& w) const;
 
     std::string const&     command_line() const throw ();
+    std::string&           command_name() throw ();
     std::string const&     command_name() const throw ();
     std::string const&     connector() const throw ();
+    bool                   native() const throw ();
 
   private:
     struct                 setters {
@@ -59,10 +64,12 @@ namespace                  configuration {
     bool                   _set_command_line(std::string const& value);
     bool                   _set_command_name(std::string const& value);
     bool                   _set_connector(std::string const& value);
+    bool                   _set_native(bool value);
 
     std::string            _command_line;
     std::string            _command_name;
     std::string            _connector;
+    opt<bool>              _native;
     static setters const   _setters[];
   };
 
@@ -45,10 +45,13 @@ namespace                  configuration {
                              connector const& right) const throw ();
     void                   check_validity() const;
     key_type const&        key() const throw ();
+    void                   load(cache_reader& r);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    void                   save(cache_writer& w) const;
 
     std::string const&     connector_line() const throw ();
+    std::string&           connector_name() throw ();
     std::string const&     connector_name() const throw ();
 
   private:
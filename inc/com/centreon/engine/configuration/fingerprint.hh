@@ -0,0 +1,81 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_FINGERPRINT_HH
+#  define CCE_CONFIGURATION_FINGERPRINT_HH
+
+#  include <cstddef>
+#  include <list>
+#  include <map>
+#  include <string>
+#  include "com/centreon/engine/configuration/duration.hh"
+#  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/opt.hh"
+
+CCE_BEGIN()
+
+namespace        configuration {
+  /**
+   *  @class fingerprint fingerprint.hh "com/centreon/engine/configuration/fingerprint.hh"
+   *  @brief 128-bit hash of the content of a configuration object.
+   *
+   *  Properties are fed one after the other. Objects with different
+   *  fingerprints are different, objects with the same fingerprint
+   *  still need to be compared.
+   */
+  class          fingerprint {
+  public:
+                 fingerprint() throw ();
+                 fingerprint(fingerprint const& other) throw ();
+                 ~fingerprint() throw ();
+    fingerprint& operator=(fingerprint const& other) throw ();
+    bool         operator==(fingerprint const& other) const throw ();
+    bool         operator!=(fingerprint const& other) const throw ();
+    fingerprint& operator<<(bool value) throw ();
+    fingerprint& operator<<(unsigned short value) throw ();
+    fingerprint& operator<<(int value) throw ();
+    fingerprint& operator<<(unsigned int value) throw ();
+    fingerprint& operator<<(long value) throw ();
+    fingerprint& operator<<(duration const& value) throw ();
+    fingerprint& operator<<(group const& value) throw ();
+    fingerprint& operator<<(
+                   std::list<std::string> const& value) throw ();
+    fingerprint& operator<<(
+                   std::map<std::string, std::string> const& value) throw ();
+    fingerprint& operator<<(std::string const& value) throw ();
+    template <typename T>
+    fingerprint& operator<<(opt<T> const& value) throw () {
+      return (*this << value.get());
+    }
+    void         reset() throw ();
+
+  private:
+    void         _feed(void const* data, std::size_t size) throw ();
+
+    unsigned long long
+                 _high;
+    unsigned long long
+                 _low;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_FINGERPRINT_HH
@@ -59,8 +59,10 @@ namespace                     configuration {
     bool                      operator<(host const& other) const throw ();
     void                      check_validity() const;
     key_type const&           key() const throw ();
+    void                      load(cache_reader& r);
     void                      merge(object const& obj);
     bool                      parse(char const* key, char const* value);
+    void                      save(cache_writer& w) const;
 
     std::string const&        address() const throw ();
     std::string const&        alias() const throw ();
@@ -78,6 +80,7 @@ namespace                     configuration {
     unsigned int              freshness_threshold() const throw ();
     unsigned int              high_flap_threshold() const throw ();
     unsigned int              host_id() const throw();
+    std::string&              host_name() throw ();
     std::string const&        host_name() const throw ();
     unsigned int              initial_state() const throw ();
     unsigned int              low_flap_threshold() const throw ();
@@ -94,6 +97,7 @@ namespace                     configuration {
       bool (*                 func)(host&, char const*);
     };
 
+    void                      _compute_fingerprint(fingerprint& fp) const throw ();
     bool                      _set_address(std::string const& value);
     bool                      _set_alias(std::string const& value);
     bool                      _set_checks_active(bool value);
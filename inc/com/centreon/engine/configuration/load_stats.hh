@@ -0,0 +1,72 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_LOAD_STATS_HH
+#  define CCE_CONFIGURATION_LOAD_STATS_HH
+
+#  include <ctime>
+#  include <list>
+#  include <ostream>
+#  include <string>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace              configuration {
+  /**
+   *  Wall clock time spent in each phase of the last configuration
+   *  load, at startup or on reload.
+   *
+   *  The loading thread calls begin(), then phase() each time it
+   *  enters a new phase and finally end(). Only the last complete load
+   *  is published and it stays available until the next one ends.
+   */
+  namespace            load_stats {
+    /**
+     *  @struct entry load_stats.hh
+     *  @brief Time spent in one phase.
+     */
+    struct             entry {
+      double           duration;
+      std::string      phase;
+    };
+
+    /**
+     *  @struct report load_stats.hh
+     *  @brief Timings of one configuration load.
+     */
+    struct             report {
+      double           paused_time;
+      std::list<entry> phases;
+      bool             reload;
+      time_t           start_time;
+      double           total_time;
+    };
+
+    void               begin(bool reload);
+    void               end(double paused_time = 0.0);
+    bool               get(report& r);
+    void               phase(char const* name);
+    std::ostream&      save(std::ostream& os);
+  }
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_LOAD_STATS_HH
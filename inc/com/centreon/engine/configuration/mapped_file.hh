@@ -0,0 +1,65 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_MAPPED_FILE_HH
+#  define CCE_CONFIGURATION_MAPPED_FILE_HH
+
+#  include <cstddef>
+#  include <string>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace       configuration {
+  /**
+   *  @class mapped_file mapped_file.hh "com/centreon/engine/configuration/mapped_file.hh"
+   *  @brief Read a configuration file line by line without copies.
+   *
+   *  The file is mapped privately in memory. Lines are trimmed and
+   *  NUL-terminated in place, so callers can split them in place too.
+   *  Modifications are never written back to the file.
+   */
+  class         mapped_file {
+  public:
+                mapped_file();
+                ~mapped_file() throw ();
+    void        close() throw ();
+    char const* data() const throw ();
+    bool        next_line(
+                  char*& line,
+                  unsigned int& pos,
+                  bool join_continuations = false);
+    bool        open(std::string const& path);
+    std::size_t size() const throw ();
+
+  private:
+                mapped_file(mapped_file const& right);
+    mapped_file& operator=(mapped_file const& right);
+    bool        _next_range(char*& begin, char*& end, unsigned int& pos);
+
+    char*       _current;
+    char*       _data;
+    char*       _end;
+    std::string _last_line;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_MAPPED_FILE_HH
@@ -25,6 +25,7 @@
 #  include <map>
 #  include <set>
 #  include <string>
+#  include "com/centreon/engine/configuration/fingerprint.hh"
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/engine/string.hh"
 #  include "com/centreon/shared_ptr.hh"
@@ -36,6 +37,9 @@ typedef std::set<std::string>              set_string;
 CCE_BEGIN()
 
 namespace                  configuration {
+  class                    cache_reader;
+  class                    cache_writer;
+
   class                    object {
   public:
     enum                   object_type {
@@ -59,12 +63,16 @@ namespace                  configuration {
     virtual void           check_validity() const = 0;
     static shared_ptr<object>
                            create(std::string const& type_name);
+    fingerprint const&     get_fingerprint() const throw ();
+    virtual void           load(cache_reader& r);
     virtual void           merge(object const& obj) = 0;
     std::string const&     name() const throw ();
     virtual bool           parse(char const* key, char const* value);
     virtual bool           parse(std::string const& line);
+    virtual bool           parse_line(char* line);
     void                   resolve_template(
                              umap<std::string, shared_ptr<object> >& templates);
+    virtual void           save(cache_writer& w) const;
     bool                   should_register() const throw ();
     object_type            type() const throw ();
     std::string const&     type_name() const throw ();
@@ -92,10 +100,15 @@ namespace                  configuration {
       }
     };
 
+    virtual void           _compute_fingerprint(
+                             fingerprint& fp) const throw ();
+    void                   _invalidate_fingerprint() throw ();
     bool                   _set_name(std::string const& value);
     bool                   _set_should_register(bool value);
     bool                   _set_templates(std::string const& value);
 
+    mutable fingerprint    _fingerprint;
+    mutable bool           _has_fingerprint;
     bool                   _is_resolve;
     std::string            _name;
     static setters const   _setters[];
@@ -20,8 +20,11 @@
 #ifndef CCE_CONFIGURATION_PARSER_HH
 #  define CCE_CONFIGURATION_PARSER_HH
 
+#  include <cstddef>
 #  include <fstream>
 #  include <string>
+#  include <vector>
+#  include "com/centreon/concurrency/thread.hh"
 #  include "com/centreon/engine/configuration/command.hh"
 #  include "com/centreon/engine/configuration/connector.hh"
 #  include "com/centreon/engine/configuration/file_info.hh"
@@ -58,6 +61,43 @@ namespace              configuration {
   private:
     typedef void (parser::*store)(object_ptr obj);
 
+    /**
+     *  @class resolver parser.hh
+     *  @brief Resolve and check a range of registered objects.
+     *
+     *  Templates must already be resolved, so that resolvers only
+     *  read them and can run concurrently. Each resolver stops at the
+     *  first invalid object of its range.
+     */
+    class              resolver : public concurrency::thread {
+    public:
+                       resolver(
+                         std::vector<object*> const& objects,
+                         std::size_t begin,
+                         std::size_t end,
+                         map_object* templates);
+                       ~resolver() throw ();
+      std::string const&
+                       error() const throw ();
+      std::size_t      failed() const throw ();
+      bool             invalid() const throw ();
+      void             resolve();
+
+    private:
+                       resolver(resolver const& right);
+      resolver&        operator=(resolver const& right);
+      void             _run();
+
+      std::size_t      _begin;
+      std::size_t      _end;
+      std::string      _error;
+      std::size_t      _failed;
+      bool             _invalid;
+      std::vector<object*> const&
+                       _objects;
+      map_object*      _templates;
+    };
+
                        parser(parser const& right);
     parser&            operator=(parser const& right);
     void               _add_object(object_ptr obj);
@@ -66,6 +106,8 @@ namespace              configuration {
                          std::list<std::string> const& lst,
                          void (parser::*pfunc)(std::string const&));
     file_info const&   _get_file_info(object* obj) const;
+    void               _get_object_files(
+                         std::list<std::string>& files) const;
     template<typename T>
     void               _get_objects_by_list_name(
                          list_string const& lst,
@@ -83,8 +125,6 @@ namespace              configuration {
                          std::set<shared_ptr<T> >& to);
     std::string const& _map_object_type(
                          map_object const& objects) const throw ();
-    void               _parse_directory_configuration(
-                         std::string const& path);
     void               _parse_global_configuration(
                          std::string const& path,
                          bool is_main_file);
@@ -102,6 +142,7 @@ namespace              configuration {
     map_object         _map_objects[16];
     umap<object*, file_info>
                        _objects_info;
+    list_object        _parsed_objects;
     unsigned int       _read_options;
     static store       _store[];
     map_object         _templates[16];
@@ -63,8 +63,10 @@ namespace                        configuration {
     bool                         operator<(service const& other) const throw ();
     void                         check_validity() const;
     key_type                     key() const;
+    void                         load(cache_reader& r);
     void                         merge(object const& obj);
     bool                         parse(char const* key, char const* value);
+    void                         save(cache_writer& w) const;
 
     bool                         checks_active() const throw ();
     std::string const&           check_command() const throw ();
@@ -100,6 +102,7 @@ namespace                        configuration {
       bool (*                    func)(service&, char const*);
     };
 
+    void                         _compute_fingerprint(fingerprint& fp) const throw ();
     bool                         _set_check_command(std::string const& value);
     bool                         _set_checks_active(bool value);
     bool                         _set_check_freshness(bool value);
@@ -55,8 +55,10 @@ namespace                  configuration {
                              servicedependency const& right) const;
     void                   check_validity() const;
     key_type const&        key() const throw ();
+    void                   load(cache_reader& r);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    void                   save(cache_writer& w) const;
 
     void                   dependency_period(std::string const& period);
     std::string const&     dependency_period() const throw ();
@@ -65,6 +65,8 @@ namespace                           configuration {
     void                            cached_host_check_horizon(duration const& value);
     duration const&                 cached_service_check_horizon() const throw ();
     void                            cached_service_check_horizon(duration const& value);
+    unsigned int                    check_coalescing_window() const throw ();
+    void                            check_coalescing_window(unsigned int value);
     std::list<std::string> const&   cfg_dir() const throw ();
     std::list<std::string> const&   cfg_file() const throw ();
     std::list<std::string>&         cfg_include() throw ();
@@ -86,6 +88,8 @@ namespace                           configuration {
     void                            command_check_interval(duration const& value);
     std::string const&              command_file() const throw ();
     void                            command_file(std::string const& value);
+    std::string const&              configuration_cache_file() const throw ();
+    void                            configuration_cache_file(std::string const& value);
     set_connector const&            connectors() const throw ();
     set_connector&                  connectors() throw ();
     set_connector::const_iterator   connectors_find(connector::key_type const& k) const;
@@ -100,6 +104,8 @@ namespace                           configuration {
     void                            enable_event_handlers(bool value);
     bool                            enable_flap_detection() const throw ();
     void                            enable_flap_detection(bool value);
+    bool                            enable_neb_callback_stats() const throw ();
+    void                            enable_neb_callback_stats(bool value);
     bool                            enable_predictive_host_dependency_checks() const throw ();
     void                            enable_predictive_host_dependency_checks(bool value);
     bool                            enable_predictive_service_dependency_checks() const throw ();
@@ -152,12 +158,22 @@ namespace                           configuration {
     void                            low_host_flap_threshold(float value);
     float                           low_service_flap_threshold() const throw ();
     void                            low_service_flap_threshold(float value);
+    unsigned int                    max_concurrent_checks_per_command() const throw ();
+    void                            max_concurrent_checks_per_command(unsigned int value);
+    unsigned int                    max_concurrent_checks_per_host() const throw ();
+    void                            max_concurrent_checks_per_host(unsigned int value);
+    unsigned int                    max_concurrent_event_handlers() const throw ();
+    void                            max_concurrent_event_handlers(unsigned int value);
     unsigned long                   max_debug_file_size() const throw ();
     void                            max_debug_file_size(unsigned long value);
     unsigned long                   max_log_file_size() const throw ();
     void                            max_log_file_size(unsigned long value);
     unsigned int                    max_parallel_service_checks() const throw ();
     void                            max_parallel_service_checks(unsigned int value);
+    unsigned int                    min_concurrent_checks() const throw ();
+    void                            min_concurrent_checks(unsigned int value);
+    unsigned int                    native_check_workers() const throw ();
+    void                            native_check_workers(unsigned int value);
     bool                            obsess_over_hosts() const throw ();
     void                            obsess_over_hosts(bool value);
     bool                            obsess_over_services() const throw ();
@@ -197,6 +213,10 @@ namespace                           configuration {
     set_timeperiod::iterator        timeperiods_find(timeperiod::key_type const& k);
     duration const&                 time_change_threshold() const throw ();
     void                            time_change_threshold(duration const& value);
+    bool                            use_adaptive_concurrent_checks() const throw ();
+    void                            use_adaptive_concurrent_checks(bool value);
+    bool                            use_load_aware_scheduling() const throw ();
+    void                            use_load_aware_scheduling(bool value);
     std::vector<std::string> const& user() const throw ();
     void                            user(std::vector<std::string> const& value);
     void                            user(std::string const& key, std::string const& value);
@@ -279,6 +299,7 @@ namespace                           configuration {
     std::string                     _broker_module_directory;
     duration                        _cached_host_check_horizon;
     duration                        _cached_service_check_horizon;
+    unsigned int                    _check_coalescing_window;
     std::list<std::string>          _cfg_dir;
     std::list<std::string>          _cfg_file;
     std::list<std::string>          _cfg_include;
@@ -290,12 +311,14 @@ namespace                           configuration {
     set_command                     _commands;
     duration                        _command_check_interval;
     std::string                     _command_file;
+    std::string                     _configuration_cache_file;
     set_connector                   _connectors;
     std::string                     _debug_file;
     unsigned long long              _debug_level;
     unsigned int                    _debug_verbosity;
     bool                            _enable_event_handlers;
     bool                            _enable_flap_detection;
+    bool                            _enable_neb_callback_stats;
     bool                            _enable_predictive_host_dependency_checks;
     bool                            _enable_predictive_service_dependency_checks;
     unsigned long                   _event_broker_options;
@@ -321,9 +344,14 @@ namespace                           configuration {
     bool                            _log_service_retries;
     float                           _low_host_flap_threshold;
     float                           _low_service_flap_threshold;
+    unsigned int                    _max_concurrent_checks_per_command;
+    unsigned int                    _max_concurrent_checks_per_host;
+    unsigned int                    _max_concurrent_event_handlers;
     unsigned long                   _max_debug_file_size;
     unsigned long                   _max_log_file_size;
     unsigned int                    _max_parallel_service_checks;
+    unsigned int                    _min_concurrent_checks;
+    unsigned int                    _native_check_workers;
     bool                            _obsess_over_hosts;
     bool                            _obsess_over_services;
     std::string                     _ochp_command;
@@ -341,6 +369,8 @@ namespace                           configuration {
     std::string                     _status_file;
     set_timeperiod                  _timeperiods;
     duration                        _time_change_threshold;
+    bool                            _use_adaptive_concurrent_checks;
+    bool                            _use_load_aware_scheduling;
     std::vector<std::string>        _users;
     bool                            _use_setpgid;
     bool                            _use_syslog;
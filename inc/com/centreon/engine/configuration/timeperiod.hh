@@ -49,14 +49,18 @@ namespace                  configuration {
                              timeperiod const& right) const throw ();
     void                   check_validity() const;
     key_type const&        key() const throw ();
+    void                   load(cache_reader& r);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
     bool                   parse(std::string const& line);
+    bool                   parse_line(char* line);
+    void                   save(cache_writer& w) const;
 
     std::string const&     alias() const throw ();
     std::vector<std::list<daterange> > const&
                            exceptions() const throw ();
     list_string const&     exclude() const throw ();
+    std::string&           timeperiod_name() throw ();
     std::string const&     timeperiod_name() const throw ();
     std::vector<std::list<timerange> > const&
                            timeranges() const throw ();
@@ -56,8 +56,9 @@
 
 #  define NEBCALLBACK_ADAPTIVE_DEPENDENCY_DATA          39
 #  define NEBCALLBACK_ADAPTIVE_TIMEPERIOD_DATA          41
+#  define NEBCALLBACK_CONFIGURATION_LOAD_DATA           42
 
-#  define NEBCALLBACK_NUMITEMS                          42 /* Total number of callback types we have. */
+#  define NEBCALLBACK_NUMITEMS                          43 /* Total number of callback types we have. */
 
 #  ifdef __cplusplus
 extern "C" {
@@ -25,11 +25,20 @@
 #  include "com/centreon/engine/nebmodules.hh"
 
 // Module Structures
+typedef struct               nebcallback_stats_struct {
+  unsigned long long         calls;
+  unsigned long long         cancels;
+  unsigned long long         max_ticks;
+  unsigned long long         overrides;
+  unsigned long long         total_ticks;
+}                            nebcallback_stats;
+
 typedef struct               nebcallback_struct {
   void*                      callback_func;
   void*                      module_handle;
   int                        priority;
   struct nebcallback_struct* next;
+  nebcallback_stats          stats;
 }                            nebcallback;
 
 #  ifdef __cplusplus
@@ -54,8 +63,25 @@ int neb_make_callbacks(int callback_type, void* data);
 int neb_init_callback_list();
 int neb_free_callback_list();
 
+// Callback types having at least one registered callback.
+#  define NEB_CALLBACK_BITMAP_SIZE ((NEBCALLBACK_NUMITEMS + 31) / 32)
+extern unsigned int neb_callback_bitmap[NEB_CALLBACK_BITMAP_SIZE];
+
 #  ifdef __cplusplus
 }
 #  endif // C++
 
+/**
+ *  Check if some module subscribed to a callback type. This is much
+ *  cheaper than building the event that would be sent to no one.
+ *
+ *  @param[in] callback_type  Callback type.
+ *
+ *  @return Non-zero if at least one callback is registered.
+ */
+static inline int neb_has_callbacks(int callback_type) {
+  return (neb_callback_bitmap[callback_type / 32]
+          & (1u << (callback_type % 32)));
+}
+
 #endif // !CCE_NEBMODS_HH
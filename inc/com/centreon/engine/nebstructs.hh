@@ -132,6 +132,21 @@ typedef struct   nebstruct_comment_struct {
   void*          object_ptr; /* not implemented yet */
 }                nebstruct_comment_data;
 
+/* Configuration load structure. */
+typedef struct   nebstruct_configuration_load_struct {
+  int            type;
+  int            flags;
+  int            attr;
+  struct timeval timestamp;
+
+  int            reload;
+  double         total_time;
+  double         paused_time;
+  unsigned int   phase_count;
+  char const* const* phase_names;
+  double const*  phase_times;
+}                nebstruct_configuration_load_data;
+
 /* Custom variable structure. */
 typedef struct           nebstruct_custom_variable_struct {
   int                    type;
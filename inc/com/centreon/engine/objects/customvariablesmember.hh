@@ -21,6 +21,7 @@
 #  define CCE_OBJECTS_CUSTOMVARIABLESMEMBER_HH
 
 /* Forward declarations. */
+struct customvariablesindex_struct;
 struct host_struct;
 struct service_struct;
 
@@ -57,8 +58,17 @@ void                   remove_all_custom_variables_from_service(
 
 #    include <ostream>
 #    include <string>
+#    include <vector>
 #    include "com/centreon/engine/namespace.hh"
 
+/**
+ *  Lookup index of a custom variable list, sorted by variable name.
+ *  Members still belong to the list, the index only points to them.
+ */
+struct                                customvariablesindex_struct {
+  std::vector<customvariablesmember*> members;
+};
+
 bool          operator==(
                 customvariablesmember const& obj1,
                 customvariablesmember const& obj2) throw ();
@@ -74,6 +84,16 @@ std::ostream& operator<<(
 
 CCE_BEGIN()
 
+customvariablesmember*
+              find_customvariable(
+                customvariablesmember* lst,
+                customvariablesindex_struct const* index,
+                char const* name);
+void          index_customvariables(
+                customvariablesindex_struct*& index,
+                customvariablesmember* lst);
+void          unindex_customvariables(
+                customvariablesindex_struct*& index) throw ();
 bool          update_customvariable(
                 customvariablesmember* lst,
                 std::string const& key,
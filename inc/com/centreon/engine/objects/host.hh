@@ -25,7 +25,9 @@
 
 /* Forward declaration. */
 struct command_struct;
+struct customvariablesindex_struct;
 struct customvariablesmember_struct;
+struct hostdependency_struct;
 struct hostsmember_struct;
 struct objectlist_struct;
 struct servicesmember_struct;
@@ -104,6 +106,16 @@ typedef struct                  host_struct {
   timeperiod_struct*            check_period_ptr;
   struct host_struct*           next;
   struct host_struct*           nexthash;
+
+  /* Fields added after the original layout. Append new fields here
+     so that compiled modules keep working. */
+  hostdependency_struct*        dependencies;
+  unsigned long                 dependencies_epoch;
+  unsigned int                  dependencies_result;
+  double                        average_execution_time;
+  customvariablesindex_struct*  custom_variables_index;
+  struct host_struct*           prev;
+  unsigned int                  scheduling_index;
 }                               host;
 
 /* Other HOST structure. */
@@ -161,6 +173,7 @@ int   number_of_total_parent_hosts(host* hst);
 #    include <ostream>
 #    include <string>
 #    include "com/centreon/engine/namespace.hh"
+#    include "com/centreon/shared_ptr.hh"
 
 bool          operator==(
                 host const& obj1,
@@ -172,8 +185,36 @@ std::ostream& operator<<(std::ostream& os, host const& obj);
 
 CCE_BEGIN()
 
+shared_ptr<host>
+              create_host(
+                unsigned int host_id,
+                char const* name,
+                char const* alias,
+                char const* address,
+                char const* check_period,
+                int initial_state,
+                double check_interval,
+                double retry_interval,
+                int max_attempts,
+                unsigned int check_timeout,
+                char const* check_command,
+                int checks_enabled,
+                char const* event_handler,
+                int event_handler_enabled,
+                int flap_detection_enabled,
+                double low_flap_threshold,
+                double high_flap_threshold,
+                int flap_detection_on_up,
+                int flap_detection_on_down,
+                int flap_detection_on_unreachable,
+                int check_freshness,
+                int freshness_threshold,
+                int should_be_drawn,
+                int obsess_over_host,
+                char const* timezone);
 host&         find_host(std::string const& name);
 bool          is_host_exist(std::string const& name) throw ();
+host*         register_host(shared_ptr<host> const& obj);
 
 CCE_END()
 
@@ -20,6 +20,8 @@
 #ifndef CCE_OBJECTS_HOSTDEPENDENCY_HH
 #  define CCE_OBJECTS_HOSTDEPENDENCY_HH
 
+#  include <time.h>
+
 /* Forward declaration. */
 struct host_struct;
 struct timeperiod_struct;
@@ -41,6 +43,12 @@ typedef struct                  hostdependency_struct {
   timeperiod_struct*            dependency_period_ptr;
   struct hostdependency_struct* next;
   struct hostdependency_struct* nexthash;
+
+  /* Fields added after the original layout. Append new fields here
+     so that compiled modules keep working. */
+  time_t                        period_check_time;
+  int                           period_valid;
+  struct hostdependency_struct* next_dependency;
 }                               hostdependency;
 
 #  ifdef __cplusplus
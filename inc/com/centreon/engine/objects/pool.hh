@@ -0,0 +1,183 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_OBJECTS_POOL_HH
+#  define CCE_OBJECTS_POOL_HH
+
+#  include <cstddef>
+#  include "com/centreon/concurrency/locker.hh"
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class node_pool pool.hh "com/centreon/engine/objects/pool.hh"
+ *  @brief Allocator of small object list nodes.
+ *
+ *  Nodes of type T are carved out of slabs of contiguous memory
+ *  instead of being allocated one by one, and released nodes are
+ *  reused. Slabs are only freed by purge(), when no node of the pool
+ *  is in use anymore. Pools are locked because list nodes of new
+ *  objects are allocated by the configuration loading thread while
+ *  the main loop runs.
+ *
+ *  Allocated memory is not initialized, T must be a plain structure.
+ */
+template <typename T>
+class                  node_pool {
+public:
+  /**
+   *  Allocate a node.
+   *
+   *  @return Uninitialized node.
+   */
+  static T*            allocate() {
+    concurrency::locker lock(&_lock());
+    if (!_free)
+      _grow();
+    node* n(_free);
+    _free = n->next;
+    ++_used;
+    return (reinterpret_cast<T*>(n));
+  }
+
+  /**
+   *  Free all slabs if no node is in use.
+   */
+  static void          purge() throw () {
+    concurrency::locker lock(&_lock());
+    if (_used)
+      return ;
+    while (_slabs) {
+      slab* next(_slabs->next);
+      delete _slabs;
+      _slabs = next;
+    }
+    _free = NULL;
+    _slab_count = 0;
+    return ;
+  }
+
+  /**
+   *  Give a node back to the pool.
+   *
+   *  @param[in] obj  Node returned by allocate(), can be NULL.
+   */
+  static void          release(T* obj) throw () {
+    if (!obj)
+      return ;
+    concurrency::locker lock(&_lock());
+    node* n(reinterpret_cast<node*>(obj));
+    n->next = _free;
+    _free = n;
+    --_used;
+    return ;
+  }
+
+  /**
+   *  Get the number of slabs allocated.
+   *
+   *  @return Number of slabs.
+   */
+  static unsigned long slabs() throw () {
+    concurrency::locker lock(&_lock());
+    return (_slab_count);
+  }
+
+  /**
+   *  Get the number of nodes in use.
+   *
+   *  @return Number of nodes allocated and not released.
+   */
+  static unsigned long used() throw () {
+    concurrency::locker lock(&_lock());
+    return (_used);
+  }
+
+private:
+  union                node {
+    node*              next;
+    char               data[sizeof(T)];
+    double             align_double;
+    long long          align_long;
+    void*              align_ptr;
+  };
+
+  enum {
+    slab_size = 16384,
+    nodes_per_slab = (slab_size - sizeof(void*)) / sizeof(node) > 0
+                     ? (slab_size - sizeof(void*)) / sizeof(node)
+                     : 1
+  };
+
+  struct               slab {
+    slab*              next;
+    node               nodes[nodes_per_slab];
+  };
+
+  /**
+   *  Allocate a new slab and add its nodes to the free list, in
+   *  address order.
+   */
+  static void          _grow() {
+    slab* s(new slab);
+    s->next = _slabs;
+    _slabs = s;
+    ++_slab_count;
+    for (unsigned int i(nodes_per_slab); i > 0; --i) {
+      s->nodes[i - 1].next = _free;
+      _free = s->nodes + i - 1;
+    }
+    return ;
+  }
+
+  /**
+   *  Get the lock of the pool. It is never destroyed so that nodes
+   *  can be released at exit.
+   *
+   *  @return Pool lock.
+   */
+  static concurrency::mutex&
+                       _lock() {
+    static concurrency::mutex* m(new concurrency::mutex);
+    return (*m);
+  }
+
+                       node_pool();
+                       ~node_pool();
+
+  static node*         _free;
+  static unsigned long _slab_count;
+  static slab*         _slabs;
+  static unsigned long _used;
+};
+
+template <typename T>
+typename node_pool<T>::node* node_pool<T>::_free(NULL);
+template <typename T>
+unsigned long node_pool<T>::_slab_count(0);
+template <typename T>
+typename node_pool<T>::slab* node_pool<T>::_slabs(NULL);
+template <typename T>
+unsigned long node_pool<T>::_used(0);
+
+CCE_END()
+
+#endif // !CCE_OBJECTS_POOL_HH
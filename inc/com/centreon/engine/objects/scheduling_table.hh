@@ -0,0 +1,111 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_OBJECTS_SCHEDULING_TABLE_HH
+#  define CCE_OBJECTS_SCHEDULING_TABLE_HH
+
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class scheduling_table scheduling_table.hh "com/centreon/engine/objects/scheduling_table.hh"
+ *  @brief Contiguous array of the hosts or services of the engine.
+ *
+ *  The scheduling parameters computation and the freshness loops
+ *  visit every host or service. Walking the object list loads one
+ *  object after the other, because the address of the next object is
+ *  only known once the current one is in cache. Walking this array
+ *  lets the processor fetch many objects at once. The table only
+ *  holds pointers: fields are always read from the objects, so
+ *  writing them directly never desynchronizes the table.
+ *
+ *  Objects are registered by register_host() and register_service(),
+ *  unregistered by their deleter, and store their position in the
+ *  table (plus one) in scheduling_index.
+ */
+template <typename T>
+class                  scheduling_table {
+public:
+  /**
+   *  Register an object.
+   *
+   *  @param[in,out] obj  Object.
+   */
+  static void          add(T* obj) {
+    if (!obj->scheduling_index) {
+      _objects.push_back(obj);
+      obj->scheduling_index = _objects.size();
+    }
+    return ;
+  }
+
+  /**
+   *  Get an object.
+   *
+   *  @param[in] index  Position of the object, lower than size().
+   *
+   *  @return Object.
+   */
+  static T*            at(unsigned int index) throw () {
+    return (_objects[index]);
+  }
+
+  /**
+   *  Unregister an object. The last object takes its place.
+   *
+   *  @param[in,out] obj  Object.
+   */
+  static void          remove(T* obj) throw () {
+    if (!obj->scheduling_index)
+      return ;
+    unsigned int index(obj->scheduling_index - 1);
+    if (index + 1 < _objects.size()) {
+      _objects[index] = _objects.back();
+      _objects[index]->scheduling_index = index + 1;
+    }
+    _objects.pop_back();
+    obj->scheduling_index = 0;
+    return ;
+  }
+
+  /**
+   *  Get the number of registered objects.
+   *
+   *  @return Number of objects.
+   */
+  static unsigned int  size() throw () {
+    return (_objects.size());
+  }
+
+private:
+                       scheduling_table();
+                       ~scheduling_table();
+
+  static std::vector<T*>
+                       _objects;
+};
+
+template <typename T>
+std::vector<T*>        scheduling_table<T>::_objects;
+
+CCE_END()
+
+#endif // !CCE_OBJECTS_SCHEDULING_TABLE_HH
@@ -25,9 +25,11 @@
 
 /* Forward declaration. */
 struct command_struct;
+struct customvariablesindex_struct;
 struct customvariablesmember_struct;
 struct host_struct;
 struct objectlist_struct;
+struct servicedependency_struct;
 struct timeperiod_struct;
 
 typedef struct                  service_struct {
@@ -101,6 +103,16 @@ typedef struct                  service_struct {
   timeperiod_struct*            check_period_ptr;
   struct service_struct*        next;
   struct service_struct*        nexthash;
+
+  /* Fields added after the original layout. Append new fields here
+     so that compiled modules keep working. */
+  servicedependency_struct*     dependencies;
+  unsigned long                 dependencies_epoch;
+  unsigned int                  dependencies_result;
+  double                        average_execution_time;
+  customvariablesindex_struct*  custom_variables_index;
+  struct service_struct*        prev;
+  unsigned int                  scheduling_index;
 }                               service;
 
 #  ifdef __cplusplus
@@ -142,6 +154,7 @@ int      get_service_count();
 #    include <ostream>
 #    include <string>
 #    include "com/centreon/engine/namespace.hh"
+#    include "com/centreon/shared_ptr.hh"
 
 bool          operator==(
                 service const& obj1,
@@ -153,11 +166,40 @@ std::ostream& operator<<(std::ostream& os, service const& obj);
 
 CCE_BEGIN()
 
+shared_ptr<service>
+              create_service(
+                unsigned int host_id,
+                char const* host_name,
+                unsigned int service_id,
+                char const* description,
+                char const* check_period,
+                int initial_state,
+                int max_attempts,
+                unsigned int check_timeout,
+                double check_interval,
+                double retry_interval,
+                int is_volatile,
+                char const* event_handler,
+                int event_handler_enabled,
+                char const* check_command,
+                int checks_enabled,
+                int flap_detection_enabled,
+                double low_flap_threshold,
+                double high_flap_threshold,
+                int flap_detection_on_ok,
+                int flap_detection_on_warning,
+                int flap_detection_on_unknown,
+                int flap_detection_on_critical,
+                int check_freshness,
+                int freshness_threshold,
+                int obsess_over_service,
+                char const* timezone);
 service&      find_service(
                 std::string const& host_name,
                 std::string const& service_description);
 bool          is_service_exist(
                 std::pair<std::string, std::string> const& id);
+service*      register_service(shared_ptr<service> const& obj);
 
 CCE_END()
 
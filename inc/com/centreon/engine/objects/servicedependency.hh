@@ -20,6 +20,8 @@
 #ifndef CCE_OBJECTS_SERVICEDEPENDENCY_HH
 #  define CCE_OBJECTS_SERVICEDEPENDENCY_HH
 
+#  include <time.h>
+
 /* Forward declaration. */
 struct service_struct;
 struct timeperiod_struct;
@@ -44,6 +46,12 @@ typedef struct                     servicedependency_struct {
   timeperiod_struct*               dependency_period_ptr;
   struct servicedependency_struct* next;
   struct servicedependency_struct* nexthash;
+
+  /* Fields added after the original layout. Append new fields here
+     so that compiled modules keep working. */
+  time_t                           period_check_time;
+  int                              period_valid;
+  struct servicedependency_struct* next_dependency;
 }                                  servicedependency;
 
 #  ifdef __cplusplus
@@ -72,6 +72,24 @@ namespace                 string {
     return (buf);
   }
 
+  // Interned strings are shared: their buffer is immutable and must
+  // never be written to, only released with release() or replaced
+  // with setintern(). release() deletes strings that come from dup().
+  char*                   intern(char const* value);
+  void                    release(char*& buf) throw ();
+
+  inline char const*      setintern(char*& buf, char const* value) {
+    char* tmp(intern(value));
+    release(buf);
+    return ((buf = tmp));
+  }
+
+  inline char const*      setintern(
+                            char*& buf,
+                            std::string const& value) {
+    return (setintern(buf, value.c_str()));
+  }
+
   inline char const*      setstr(char*& buf, char const* value = NULL) {
     delete[] buf;
     return ((buf = string::dup(value)));
@@ -925,43 +925,43 @@ int cmd_change_object_char_var(int cmd, char* args) {
     break;
 
   case CMD_CHANGE_HOST_EVENT_HANDLER:
-    delete[] temp_host->event_handler;
-    temp_host->event_handler = temp_ptr;
+    string::setintern(temp_host->event_handler, temp_ptr);
+    delete[] temp_ptr;
     temp_host->event_handler_ptr = temp_command;
     attr = MODATTR_EVENT_HANDLER_COMMAND;
     break;
 
   case CMD_CHANGE_HOST_CHECK_COMMAND:
-    delete[] temp_host->host_check_command;
-    temp_host->host_check_command = temp_ptr;
+    string::setintern(temp_host->host_check_command, temp_ptr);
+    delete[] temp_ptr;
     temp_host->check_command_ptr = temp_command;
     attr = MODATTR_CHECK_COMMAND;
     break;
 
   case CMD_CHANGE_HOST_CHECK_TIMEPERIOD:
-    delete[] temp_host->check_period;
-    temp_host->check_period = temp_ptr;
+    string::setintern(temp_host->check_period, temp_ptr);
+    delete[] temp_ptr;
     temp_host->check_period_ptr = temp_timeperiod;
     attr = MODATTR_CHECK_TIMEPERIOD;
     break;
 
   case CMD_CHANGE_SVC_EVENT_HANDLER:
-    delete[] temp_service->event_handler;
-    temp_service->event_handler = temp_ptr;
+    string::setintern(temp_service->event_handler, temp_ptr);
+    delete[] temp_ptr;
     temp_service->event_handler_ptr = temp_command;
     attr = MODATTR_EVENT_HANDLER_COMMAND;
     break;
 
   case CMD_CHANGE_SVC_CHECK_COMMAND:
-    delete[] temp_service->service_check_command;
-    temp_service->service_check_command = temp_ptr;
+    string::setintern(temp_service->service_check_command, temp_ptr);
+    delete[] temp_ptr;
     temp_service->check_command_ptr = temp_command;
     attr = MODATTR_CHECK_COMMAND;
     break;
 
   case CMD_CHANGE_SVC_CHECK_TIMEPERIOD:
-    delete[] temp_service->check_period;
-    temp_service->check_period = temp_ptr;
+    string::setintern(temp_service->check_period, temp_ptr);
+    delete[] temp_ptr;
     temp_service->check_period_ptr = temp_timeperiod;
     attr = MODATTR_CHECK_TIMEPERIOD;
     break;
@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/broker/callback_stats.hh"
 #include "com/centreon/engine/flapping.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -110,6 +111,12 @@ processing::processing() {
   _lst_command["DISABLE_HOST_FRESHNESS_CHECKS"] =
     command_info(CMD_DISABLE_HOST_FRESHNESS_CHECKS,
                  &_redirector<&disable_host_freshness_checks>);
+  _lst_command["DUMP_NEB_CALLBACK_STATS"] =
+    command_info(CMD_DUMP_NEB_CALLBACK_STATS,
+                 &_redirector<&broker::callback_stats::log>);
+  _lst_command["RESET_NEB_CALLBACK_STATS"] =
+    command_info(CMD_RESET_NEB_CALLBACK_STATS,
+                 &_redirector<&broker::callback_stats::reset>);
 
   // host-related commands.
   _lst_command["ENABLE_HOST_SVC_CHECKS"] =
@@ -48,7 +48,8 @@ void broker_adaptive_dependency_data(
        void* data,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_DEPENDENCY_DATA)
+      || !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -86,7 +87,8 @@ void broker_adaptive_host_data(
        unsigned long modattrs,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_HOST_DATA)
+      || !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -129,7 +131,8 @@ void broker_adaptive_program_data(
        unsigned long modsattrs,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_PROGRAM_DATA)
+      || !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -171,7 +174,8 @@ void broker_adaptive_service_data(
        unsigned long modattrs,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_SERVICE_DATA)
+      || !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -208,7 +212,8 @@ void broker_adaptive_timeperiod_data(
        int command_type,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_TIMEPERIOD_DATA)
+      || !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -239,7 +244,8 @@ void broker_aggregated_status_data(
        int attr,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_AGGREGATED_STATUS_DATA)
+      || !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -271,7 +277,8 @@ void broker_command_data(
        command* cmd,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_COMMAND_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_COMMAND_DATA)
+      || !(config->event_broker_options() & BROKER_COMMAND_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -287,6 +294,54 @@ void broker_command_data(
   return;
 }
 
+/**
+ *  Send configuration load timings to broker.
+ *
+ *  @param[in] type        Type.
+ *  @param[in] flags       Flags.
+ *  @param[in] attr        Attributes.
+ *  @param[in] reload      Non-zero if this load was a reload.
+ *  @param[in] total_time  Total load time in seconds.
+ *  @param[in] paused_time Time the main loop was stopped in seconds.
+ *  @param[in] phase_count Number of phases.
+ *  @param[in] phase_names Phase names.
+ *  @param[in] phase_times Phase durations in seconds.
+ *  @param[in] timestamp   Timestamp.
+ */
+void broker_configuration_load(
+       int type,
+       int flags,
+       int attr,
+       int reload,
+       double total_time,
+       double paused_time,
+       unsigned int phase_count,
+       char const* const* phase_names,
+       double const* phase_times,
+       struct timeval const* timestamp) {
+  // Config check.
+  if (!neb_has_callbacks(NEBCALLBACK_CONFIGURATION_LOAD_DATA)
+      || !(config->event_broker_options() & BROKER_PROGRAM_STATE))
+    return;
+
+  // Fill struct with relevant data.
+  nebstruct_configuration_load_data ds;
+  ds.type = type;
+  ds.flags = flags;
+  ds.attr = attr;
+  ds.timestamp = get_broker_timestamp(timestamp);
+  ds.reload = reload;
+  ds.total_time = total_time;
+  ds.paused_time = paused_time;
+  ds.phase_count = phase_count;
+  ds.phase_names = phase_names;
+  ds.phase_times = phase_times;
+
+  // Make callback.
+  neb_make_callbacks(NEBCALLBACK_CONFIGURATION_LOAD_DATA, &ds);
+  return;
+}
+
 /**
  *  Sends host custom variables updates to broker.
  *
@@ -307,7 +362,8 @@ void broker_custom_variable(
        char const* varvalue,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_CUSTOMVARIABLE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_CUSTOM_VARIABLE_DATA)
+      || !(config->event_broker_options() & BROKER_CUSTOMVARIABLE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -368,7 +424,8 @@ int broker_event_handler(
       char* output,
       struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_EVENT_HANDLERS))
+  if (!neb_has_callbacks(NEBCALLBACK_EVENT_HANDLER_DATA)
+      || !(config->event_broker_options() & BROKER_EVENT_HANDLERS))
     return (OK);
   if (!data)
     return (ERROR);
@@ -448,7 +505,8 @@ void broker_external_command(
        char* command_args,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_EXTERNALCOMMAND_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_EXTERNAL_COMMAND_DATA)
+      || !(config->event_broker_options() & BROKER_EXTERNALCOMMAND_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -492,7 +550,8 @@ void broker_flapping_data(
        double low_threshold,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_FLAPPING_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_FLAPPING_DATA)
+      || !(config->event_broker_options() & BROKER_FLAPPING_DATA))
     return;
   if (!data)
     return;
@@ -574,7 +633,8 @@ int broker_host_check(
       char* perfdata,
       struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_HOST_CHECKS))
+  if (!neb_has_callbacks(NEBCALLBACK_HOST_CHECK_DATA)
+      || !(config->event_broker_options() & BROKER_HOST_CHECKS))
     return (OK);
   if (!hst)
     return (ERROR);
@@ -641,7 +701,8 @@ void broker_host_status(
        host* hst,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_HOST_STATUS_DATA)
+      || !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -677,7 +738,8 @@ void broker_log_data(
        time_t entry_time,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_LOGGED_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_LOG_DATA)
+      || !(config->event_broker_options() & BROKER_LOGGED_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -713,7 +775,8 @@ void broker_module_data(
        char const* args,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_MODULE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_MODULE_DATA)
+      || !(config->event_broker_options() & BROKER_MODULE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -748,7 +811,8 @@ void broker_program_state(
        int attr,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_PROGRAM_STATE))
+  if (!neb_has_callbacks(NEBCALLBACK_PROCESS_DATA)
+      || !(config->event_broker_options() & BROKER_PROGRAM_STATE))
     return;
 
   // Fill struct with relevant data.
@@ -777,7 +841,8 @@ void broker_program_status(
        int attr,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_PROGRAM_STATUS_DATA)
+      || !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -832,7 +897,8 @@ void broker_relation_data(
        service* dep_svc,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_RELATION_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_RELATION_DATA)
+      || !(config->event_broker_options() & BROKER_RELATION_DATA))
     return;
   if (!hst || !dep_hst)
     return;
@@ -867,7 +933,8 @@ void broker_retention_data(
        int attr,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_RETENTION_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_RETENTION_DATA)
+      || !(config->event_broker_options() & BROKER_RETENTION_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -920,7 +987,8 @@ int broker_service_check(
       char* cmdline,
       struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_SERVICE_CHECKS))
+  if (!neb_has_callbacks(NEBCALLBACK_SERVICE_CHECK_DATA)
+      || !(config->event_broker_options() & BROKER_SERVICE_CHECKS))
     return (OK);
   if (!svc)
     return (ERROR);
@@ -990,7 +1058,8 @@ void broker_service_status(
        service* svc,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_SERVICE_STATUS_DATA)
+      || !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1032,7 +1101,8 @@ void broker_statechange_data(
        int max_attempts,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATECHANGE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_STATE_CHANGE_DATA)
+      || !(config->event_broker_options() & BROKER_STATECHANGE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1097,7 +1167,8 @@ void broker_system_command(
        char* output,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_SYSTEM_COMMANDS))
+  if (!neb_has_callbacks(NEBCALLBACK_SYSTEM_COMMAND_DATA)
+      || !(config->event_broker_options() & BROKER_SYSTEM_COMMANDS))
     return;
   if (!cmd)
     return;
@@ -1138,7 +1209,8 @@ void broker_timed_event(
        timed_event* event,
        struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_TIMED_EVENTS))
+  if (!neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA)
+      || !(config->event_broker_options() & BROKER_TIMED_EVENTS))
     return;
   if (!event)
     return;
@@ -0,0 +1,204 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <sys/time.h>
+#include <utility>
+#include "com/centreon/engine/broker/callback_stats.hh"
+#include "com/centreon/engine/broker/handle.hh"
+#include "com/centreon/engine/broker/loader.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/shared_ptr.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+/**
+ *  Get the current wall clock time in microseconds.
+ *
+ *  @return Microseconds since the Epoch.
+ */
+static unsigned long long now_usec() {
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  return (tv.tv_sec * 1000000ull + tv.tv_usec);
+}
+
+// Reference points used to convert ticks to seconds.
+static unsigned long long _base_ticks(broker::callback_stats::ticks());
+static unsigned long long _base_usec(now_usec());
+
+/**
+ *  Get the duration of one tick.
+ *
+ *  @return Seconds per tick.
+ */
+static double seconds_per_tick() {
+  unsigned long long elapsed_ticks(
+                       broker::callback_stats::ticks() - _base_ticks);
+  unsigned long long elapsed_usec(now_usec() - _base_usec);
+  if (!elapsed_ticks || !elapsed_usec)
+    return (0.0);
+  return (elapsed_usec / 1000000.0 / elapsed_ticks);
+}
+
+/**
+ *  Get a printable name of a module handle.
+ *
+ *  @param[in] mod  Module handle as given to neb_register_callback().
+ *
+ *  @return Module name, filename or address.
+ */
+static std::string module_name(void* mod) {
+  std::list<shared_ptr<broker::handle> > const&
+    modules(broker::loader::instance().get_modules());
+  for (std::list<shared_ptr<broker::handle> >::const_iterator
+         it(modules.begin()), end(modules.end());
+       it != end;
+       ++it)
+    if (it->get() == mod)
+      return ((*it)->get_name().empty()
+              ? (*it)->get_filename()
+              : (*it)->get_name());
+  std::ostringstream oss;
+  oss << "unknown (" << mod << ")";
+  return (oss.str());
+}
+
+/**
+ *  Get callback statistics aggregated per module and callback type.
+ *
+ *  @param[out] entries  Statistics entries, sorted by callback type.
+ */
+void broker::callback_stats::get(std::list<entry>& entries) {
+  double spt(seconds_per_tick());
+  for (int type(0); type < NEBCALLBACK_NUMITEMS; ++type) {
+    std::map<void*, entry> by_module;
+    for (nebcallback* cb(neb_callback_list[type]); cb; cb = cb->next) {
+      if (!cb->stats.calls)
+        continue ;
+      std::map<void*, entry>::iterator
+        it(by_module.find(cb->module_handle));
+      if (it == by_module.end()) {
+        entry e;
+        e.callback_type = type;
+        e.calls = 0;
+        e.cancels = 0;
+        e.max_time = 0.0;
+        e.module = module_name(cb->module_handle);
+        e.overrides = 0;
+        e.total_time = 0.0;
+        it = by_module.insert(std::make_pair(cb->module_handle, e)).first;
+      }
+      entry& e(it->second);
+      e.calls += cb->stats.calls;
+      e.cancels += cb->stats.cancels;
+      e.overrides += cb->stats.overrides;
+      e.total_time += cb->stats.total_ticks * spt;
+      if (cb->stats.max_ticks * spt > e.max_time)
+        e.max_time = cb->stats.max_ticks * spt;
+    }
+    for (std::map<void*, entry>::const_iterator
+           it(by_module.begin()), end(by_module.end());
+         it != end;
+         ++it)
+      entries.push_back(it->second);
+  }
+  return ;
+}
+
+/**
+ *  Write callback statistics in the log file.
+ */
+void broker::callback_stats::log() {
+  std::list<entry> entries;
+  get(entries);
+  if (entries.empty())
+    logger(log_info_message, basic)
+      << "NEB callback statistics: no callback was measured";
+  for (std::list<entry>::const_iterator
+         it(entries.begin()), end(entries.end());
+       it != end;
+       ++it)
+    logger(log_info_message, basic)
+      << "NEB callback statistics: module '" << it->module
+      << "', type " << it->callback_type
+      << ": calls=" << it->calls
+      << ", total=" << it->total_time
+      << "s, average=" << it->total_time * 1000000.0 / it->calls
+      << "us, max=" << it->max_time * 1000000.0
+      << "us, cancels=" << it->cancels
+      << ", overrides=" << it->overrides;
+  return ;
+}
+
+/**
+ *  Reset all callback statistics.
+ */
+void broker::callback_stats::reset() {
+  for (int type(0); type < NEBCALLBACK_NUMITEMS; ++type)
+    for (nebcallback* cb(neb_callback_list[type]); cb; cb = cb->next) {
+      cb->stats.calls = 0;
+      cb->stats.cancels = 0;
+      cb->stats.max_ticks = 0;
+      cb->stats.overrides = 0;
+      cb->stats.total_ticks = 0;
+    }
+  _base_ticks = ticks();
+  _base_usec = now_usec();
+  logger(dbg_eventbroker, basic)
+    << "NEB callback statistics were reset";
+  return ;
+}
+
+/**
+ *  Write callback statistics in the status file format.
+ *
+ *  @param[out] os  Output stream.
+ *
+ *  @return os.
+ */
+std::ostream& broker::callback_stats::save(std::ostream& os) {
+  std::list<entry> entries;
+  get(entries);
+  std::ios_base::fmtflags flags(os.flags());
+  std::streamsize precision(os.precision());
+  os << std::fixed << std::setprecision(6);
+  for (std::list<entry>::const_iterator
+         it(entries.begin()), end(entries.end());
+       it != end;
+       ++it)
+    os << "nebcallbackstatus {\n"
+          "\tmodule=" << it->module << "\n"
+          "\tcallback_type=" << it->callback_type << "\n"
+          "\tcalls=" << it->calls << "\n"
+          "\ttotal_time=" << it->total_time << "\n"
+          "\tmax_time=" << it->max_time << "\n"
+          "\tcancels=" << it->cancels << "\n"
+          "\toverrides=" << it->overrides << "\n"
+          "\t}\n\n";
+  os.flags(flags);
+  os.precision(precision);
+  return (os);
+}
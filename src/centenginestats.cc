@@ -26,6 +26,8 @@
 #  include <getopt.h>
 #endif // HAVE_GETOPT_H
 #include <iostream>
+#include <list>
+#include <string>
 #include <unistd.h>
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/string.hh"
@@ -39,6 +41,8 @@ using namespace com::centreon::engine;
 #define STATUS_PROGRAM_DATA        2
 #define STATUS_HOST_DATA           3
 #define STATUS_SERVICE_DATA        4
+#define STATUS_NEBCALLBACK_DATA    5
+#define STATUS_CONFIGURATION_LOAD_DATA 6
 
 // Files to be processed.
 static char* main_config_file(NULL);
@@ -195,6 +199,36 @@ int total_external_command_buffer_slots = 0;
 int used_external_command_buffer_slots = 0;
 int high_external_command_buffer_slots = 0;
 
+unsigned long long active_checks_executed = 0;
+unsigned long long active_checks_coalesced = 0;
+unsigned int active_checks_limit = 0;
+double active_checks_latency = 0.0;
+double active_checks_completion_rate = 0.0;
+double run_queue_load = 0.0;
+
+// Broker module callback statistics.
+struct nebcallback_stats_entry {
+  std::string module;
+  int callback_type;
+  unsigned long long calls;
+  double total_time;
+  double max_time;
+  unsigned long long cancels;
+  unsigned long long overrides;
+};
+std::list<nebcallback_stats_entry> nebcallback_stats;
+
+// Last configuration load timings.
+struct configuration_load_phase {
+  std::string phase;
+  double duration;
+};
+int have_configuration_load = false;
+int configuration_load_reload = false;
+double configuration_load_total_time = 0.0;
+double configuration_load_paused_time = 0.0;
+std::list<configuration_load_phase> configuration_load_phases;
+
 // Forward declarations.
 int display_stats();
 void get_time_breakdown(unsigned long, int*, int*, int*, int*);
@@ -518,12 +552,62 @@ int display_stats() {
          passive_service_checks_last_1min,
          passive_service_checks_last_5min,
          passive_service_checks_last_15min);
+  printf("Coalesced Active Checks:                %llu / %llu (%.2f%%)\n",
+         active_checks_coalesced,
+         active_checks_executed + active_checks_coalesced,
+         (active_checks_executed + active_checks_coalesced)
+         ? active_checks_coalesced * 100.0
+           / (active_checks_executed + active_checks_coalesced)
+         : 0.0);
+  if (active_checks_limit)
+    printf("Concurrent Check Limit:                 %u\n",
+           active_checks_limit);
+  else
+    printf("Concurrent Check Limit:                 unlimited\n");
+  printf("Check Latency/Completion Rate/Load:     %.3f sec / %.2f per sec / %.2f\n",
+         active_checks_latency,
+         active_checks_completion_rate,
+         run_queue_load);
   printf("\n");
   printf("External Commands Last 1/5/15 min:      %d / %d / %d\n",
          external_commands_last_1min,
 	 external_commands_last_5min,
          external_commands_last_15min);
   printf("\n");
+
+  if (!nebcallback_stats.empty()) {
+    printf("Broker Module Callbacks Calls/Avg/Max/Total/Cancel/Override:\n");
+    for (std::list<nebcallback_stats_entry>::const_iterator
+           it(nebcallback_stats.begin()), end(nebcallback_stats.end());
+         it != end;
+         ++it) {
+      double calls(it->calls ? it->calls : 1);
+      printf("   %s (type %d): %llu / %.3f us / %.3f us / %.3f sec / %.2f%% / %.2f%%\n",
+             it->module.c_str(),
+             it->callback_type,
+             it->calls,
+             it->total_time * 1000000.0 / calls,
+             it->max_time * 1000000.0,
+             it->total_time,
+             it->cancels * 100.0 / calls,
+             it->overrides * 100.0 / calls);
+    }
+    printf("\n");
+  }
+
+  if (have_configuration_load) {
+    printf("Last Configuration %s Total/Paused: %.3f sec / %.3f sec\n",
+           configuration_load_reload ? "Reload" : "Load  ",
+           configuration_load_total_time,
+           configuration_load_paused_time);
+    for (std::list<configuration_load_phase>::const_iterator
+           it(configuration_load_phases.begin()),
+           end(configuration_load_phases.end());
+         it != end;
+         ++it)
+      printf("   %-35s  %.3f sec\n", it->phase.c_str(), it->duration);
+    printf("\n");
+  }
   printf("\n");
 
   return (OK);
@@ -613,6 +697,22 @@ int read_status_file() {
       data_type = STATUS_INFO_DATA;
     else if (!strcmp(temp_buffer, "programstatus {"))
       data_type = STATUS_PROGRAM_DATA;
+    else if (!strcmp(temp_buffer, "nebcallbackstatus {")) {
+      data_type = STATUS_NEBCALLBACK_DATA;
+      nebcallback_stats_entry e;
+      e.callback_type = 0;
+      e.calls = 0;
+      e.total_time = 0.0;
+      e.max_time = 0.0;
+      e.cancels = 0;
+      e.overrides = 0;
+      nebcallback_stats.push_back(e);
+    }
+    else if (!strcmp(temp_buffer, "configurationloadstatus {")) {
+      data_type = STATUS_CONFIGURATION_LOAD_DATA;
+      have_configuration_load = true;
+      configuration_load_phases.clear();
+    }
 
     /* end of definition */
     else if (!strcmp(temp_buffer, "}")) {
@@ -915,6 +1015,18 @@ int read_status_file() {
           used_external_command_buffer_slots = atoi(val);
         else if (!strcmp(var, "high_external_command_buffer_slots"))
           high_external_command_buffer_slots = atoi(val);
+        else if (!strcmp(var, "active_checks_executed"))
+          active_checks_executed = strtoull(val, NULL, 10);
+        else if (!strcmp(var, "active_checks_coalesced"))
+          active_checks_coalesced = strtoull(val, NULL, 10);
+        else if (!strcmp(var, "active_checks_limit"))
+          active_checks_limit = strtoul(val, NULL, 10);
+        else if (!strcmp(var, "active_checks_latency"))
+          active_checks_latency = strtod(val, NULL);
+        else if (!strcmp(var, "active_checks_completion_rate"))
+          active_checks_completion_rate = strtod(val, NULL);
+        else if (!strcmp(var, "run_queue_load"))
+          run_queue_load = strtod(val, NULL);
         else if (!strcmp(var, "nagios_pid"))
           nagios_pid = strtoul(val, NULL, 10);
         else if (!strcmp(var, "active_scheduled_host_check_stats")) {
@@ -1028,6 +1140,44 @@ int read_status_file() {
           should_be_scheduled = (atoi(val) > 0) ? true : false;
 	    break;
 
+      case STATUS_NEBCALLBACK_DATA:
+        {
+          nebcallback_stats_entry& e(nebcallback_stats.back());
+          if (!strcmp(var, "module"))
+            e.module = val;
+          else if (!strcmp(var, "callback_type"))
+            e.callback_type = atoi(val);
+          else if (!strcmp(var, "calls"))
+            e.calls = strtoull(val, NULL, 10);
+          else if (!strcmp(var, "total_time"))
+            e.total_time = strtod(val, NULL);
+          else if (!strcmp(var, "max_time"))
+            e.max_time = strtod(val, NULL);
+          else if (!strcmp(var, "cancels"))
+            e.cancels = strtoull(val, NULL, 10);
+          else if (!strcmp(var, "overrides"))
+            e.overrides = strtoull(val, NULL, 10);
+        }
+        break;
+
+      case STATUS_CONFIGURATION_LOAD_DATA:
+        if (!strcmp(var, "reload"))
+          configuration_load_reload = (atoi(val) > 0) ? true : false;
+        else if (!strcmp(var, "total_time"))
+          configuration_load_total_time = strtod(val, NULL);
+        else if (!strcmp(var, "paused_time"))
+          configuration_load_paused_time = strtod(val, NULL);
+        else if (!strcmp(var, "phase")) {
+          configuration_load_phase p;
+          p.duration = 0.0;
+          if ((temp_ptr = strtok(val, ",")))
+            p.phase = temp_ptr;
+          if ((temp_ptr = strtok(NULL, ",")))
+            p.duration = strtod(temp_ptr, NULL);
+          configuration_load_phases.push_back(p);
+        }
+        break;
+
       case STATUS_SERVICE_DATA:
         if (!strcmp(var, "check_execution_time"))
           execution_time = strtod(val, NULL);
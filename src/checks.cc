@@ -31,13 +31,14 @@
 #include "com/centreon/engine/checks.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/checks/viability_failure.hh"
-#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/applier/scheduler.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/flapping.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
@@ -48,9 +49,27 @@
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::events;
-using namespace com::centreon::engine::configuration::applier;
 using namespace com::centreon::engine::logging;
 
+// Weight of the last execution time in the average execution time.
+static double const execution_time_smoothing(0.2);
+
+/**
+ *  Update an exponentially weighted moving average of execution times.
+ *
+ *  @param[in,out] average         Average execution time.
+ *  @param[in]     execution_time  Last execution time.
+ */
+static void update_average_execution_time(
+              double& average,
+              double execution_time) {
+  if (average <= 0.0)
+    average = execution_time;
+  else
+    average += (execution_time - average) * execution_time_smoothing;
+  return ;
+}
+
 /******************************************************************/
 /********************** CHECK REAPER FUNCTIONS ********************/
 /******************************************************************/
@@ -288,6 +307,9 @@ int handle_async_service_check_result(
                           / 1000.0) / 1000.0);
   if (temp_service->execution_time < 0.0)
     temp_service->execution_time = 0.0;
+  update_average_execution_time(
+    temp_service->average_execution_time,
+    temp_service->execution_time);
 
   /* get the last check time */
   temp_service->last_check = queued_check_result->start_time.tv_sec;
@@ -844,27 +866,17 @@ int handle_async_service_check_result(
 
         /* check services that THIS ONE depends on for notification AND execution */
         /* we do this because we might be sending out a notification soon and we want the dependency logic to be accurate */
-        std::pair<std::string, std::string>
-          id(std::make_pair(temp_service->host_name, temp_service->description));
-        umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> > const&
-          dependencies(state::instance().servicedependencies());
-        for (umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> >::const_iterator
-               it(dependencies.find(id)), end(dependencies.end());
-             it != end && it->first == id;
-             ++it) {
-          servicedependency* temp_dependency(&*it->second);
-
-          if (temp_dependency->dependent_service_ptr == temp_service
-              && temp_dependency->master_service_ptr != NULL) {
-            master_service = (service*)temp_dependency->master_service_ptr;
-            logger(dbg_checks, most)
-              << "Predictive check of service '"
-              << master_service->description << "' on host '"
-              << master_service->host_name << "' queued.";
-            add_object_to_objectlist(
-              &check_servicelist,
-              (void*)master_service);
-          }
+        for (servicedependency* temp_dependency(temp_service->dependencies);
+             temp_dependency;
+             temp_dependency = temp_dependency->next_dependency) {
+          master_service = temp_dependency->master_service_ptr;
+          logger(dbg_checks, most)
+            << "Predictive check of service '"
+            << master_service->description << "' on host '"
+            << master_service->host_name << "' queued.";
+          add_object_to_objectlist(
+            &check_servicelist,
+            (void*)master_service);
         }
       }
     }
@@ -933,7 +945,10 @@ int handle_async_service_check_result(
       temp_service->next_check = current_time;
 
     /* make sure we rescheduled the next service check at a valid time */
-    preferred_time = temp_service->next_check;
+    preferred_time = configuration::applier::scheduler::instance().spread_check(
+                       temp_service->last_check,
+                       temp_service->next_check,
+                       temp_service->average_execution_time);
     get_next_valid_time(
       preferred_time,
       &next_valid_time,
@@ -1239,40 +1254,68 @@ int check_service_check_viability(
   return ((perform_check == true) ? OK : ERROR);
 }
 
-/* checks service dependencies */
-unsigned int check_service_dependencies(service* svc) {
-  service* temp_service = NULL;
-  int state = STATE_OK;
-  time_t current_time = 0L;
-
-  logger(dbg_functions, basic)
-    << "check_service_dependencies()";
+/**
+ *  Check whether a dependency period is currently valid. The result
+ *  is cached until the clock moves to the next second.
+ *
+ *  @param[in,out] dep       Host or service dependency.
+ *  @param[in]     now       Current time.
+ *  @param[in]     timezone  Timezone of the dependent object.
+ *
+ *  @return true if the dependency is to be checked now.
+ */
+template <typename T>
+static bool is_dependency_period_valid(
+              T* dep,
+              time_t now,
+              char const* timezone) {
+  if (!dep->dependency_period)
+    return (true);
+  if (dep->period_check_time != now) {
+    dep->period_valid = (check_time_against_period(
+                           now,
+                           dep->dependency_period_ptr,
+                           timezone) != ERROR);
+    dep->period_check_time = now;
+  }
+  return (dep->period_valid);
+}
 
-  std::pair<std::string, std::string>
-    id(svc->host_name, svc->description);
-  umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> > const&
-    dependencies(state::instance().servicedependencies());
-  for (umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> >::const_iterator
-         it(dependencies.find(id)), end(dependencies.end());
-       it != end && it->first == id;
-       ++it) {
-    servicedependency* temp_dependency(&*it->second);
-
-    /* find the service we depend on... */
-    if ((temp_service = temp_dependency->master_service_ptr) == NULL)
-      continue;
+/**
+ *  Check the dependencies of a service. Results are memoized for the
+ *  duration of one top-level check so that inherited dependency
+ *  chains are walked only once.
+ *
+ *  @param[in] svc    Dependent service.
+ *  @param[in] epoch  Identifier of the top-level check.
+ *  @param[in] now    Current time.
+ *
+ *  @return DEPENDENCIES_OK or DEPENDENCIES_FAILED.
+ */
+static unsigned int check_service_dependencies(
+                      service* svc,
+                      unsigned long epoch,
+                      time_t now) {
+  if (svc->dependencies_epoch == epoch)
+    return (svc->dependencies_result);
+  svc->dependencies_epoch = epoch;
+  svc->dependencies_result = DEPENDENCIES_OK;
+
+  for (servicedependency* temp_dependency(svc->dependencies);
+       temp_dependency;
+       temp_dependency = temp_dependency->next_dependency) {
+    service* temp_service(temp_dependency->master_service_ptr);
 
     // Skip this dependency if it has a timeperiod
     // and the current time isn't valid.
-    time(&current_time);
-    if (temp_dependency->dependency_period != NULL
-        && check_time_against_period(
-             current_time,
-             temp_dependency->dependency_period_ptr,
-             svc->timezone) == ERROR)
+    if (!is_dependency_period_valid(
+           temp_dependency,
+           now,
+           svc->timezone))
       return (DEPENDENCIES_OK);
 
     /* get the status to use (use last hard state if its currently in a soft state) */
+    int state;
     if (temp_service->state_type == SOFT_STATE
         && config->soft_state_dependencies() == false)
       state = temp_service->last_hard_state;
@@ -1280,30 +1323,34 @@ unsigned int check_service_dependencies(service* svc) {
       state = temp_service->current_state;
 
     /* is the service we depend on in state that fails the dependency tests? */
-    if (state == STATE_OK && temp_dependency->fail_on_ok == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_WARNING
-        && temp_dependency->fail_on_warning == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_UNKNOWN
-        && temp_dependency->fail_on_unknown == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_CRITICAL
-        && temp_dependency->fail_on_critical == true)
-      return (DEPENDENCIES_FAILED);
-    if ((state == STATE_OK && temp_service->has_been_checked == false)
-        && temp_dependency->fail_on_pending == true)
-      return (DEPENDENCIES_FAILED);
-
-    /* immediate dependencies ok at this point - check parent dependencies if necessary */
-    if (temp_dependency->inherits_parent == true) {
-      if (check_service_dependencies(temp_service) != DEPENDENCIES_OK)
-        return (DEPENDENCIES_FAILED);
-    }
+    if ((state == STATE_OK && temp_dependency->fail_on_ok == true)
+        || (state == STATE_WARNING
+            && temp_dependency->fail_on_warning == true)
+        || (state == STATE_UNKNOWN
+            && temp_dependency->fail_on_unknown == true)
+        || (state == STATE_CRITICAL
+            && temp_dependency->fail_on_critical == true)
+        || ((state == STATE_OK && temp_service->has_been_checked == false)
+            && temp_dependency->fail_on_pending == true)
+        /* immediate dependencies ok at this point - check parent dependencies if necessary */
+        || (temp_dependency->inherits_parent == true
+            && check_service_dependencies(temp_service, epoch, now)
+               != DEPENDENCIES_OK))
+      return (svc->dependencies_result = DEPENDENCIES_FAILED);
   }
   return (DEPENDENCIES_OK);
 }
 
+/* checks service dependencies */
+unsigned int check_service_dependencies(service* svc) {
+  static unsigned long epoch(0);
+
+  logger(dbg_functions, basic)
+    << "check_service_dependencies()";
+
+  return (check_service_dependencies(svc, ++epoch, time(NULL)));
+}
+
 /* check freshness of service results */
 void check_service_result_freshness() {
   service* temp_service = NULL;
@@ -1324,9 +1371,10 @@ void check_service_result_freshness() {
   time(&current_time);
 
   /* check all services... */
-  for (temp_service = service_list;
-       temp_service != NULL;
-       temp_service = temp_service->next) {
+  for (unsigned int i(0), end(scheduling_table<service_struct>::size());
+       i < end;
+       ++i) {
+    temp_service = scheduling_table<service_struct>::at(i);
 
     /* skip services we shouldn't be checking for freshness */
     if (temp_service->check_freshness == false)
@@ -1657,41 +1705,41 @@ void schedule_host_check(host* hst, time_t check_time, int options) {
   return;
 }
 
-/* checks host dependencies */
-unsigned int check_host_dependencies(host* hst) {
-  host* temp_host = NULL;
-  int state = HOST_UP;
-  time_t current_time = 0L;
-
-  logger(dbg_functions, basic)
-    << "check_host_dependencies()";
-
-  std::string id(hst->name);
-  umultimap<std::string, shared_ptr<hostdependency> > const&
-    dependencies(state::instance().hostdependencies());
-
-  /* check all dependencies... */
-  for (umultimap<std::string, shared_ptr<hostdependency> >::const_iterator
-         it(dependencies.find(id)), end(dependencies.end());
-       it != end && it->first == id;
-       ++it) {
-         hostdependency* temp_dependency(&*it->second);
-
-    /* find the host we depend on... */
-    if ((temp_host = temp_dependency->master_host_ptr) == NULL)
-      continue;
+/**
+ *  Check the dependencies of a host. Results are memoized for the
+ *  duration of one top-level check so that inherited dependency
+ *  chains are walked only once.
+ *
+ *  @param[in] hst    Dependent host.
+ *  @param[in] epoch  Identifier of the top-level check.
+ *  @param[in] now    Current time.
+ *
+ *  @return DEPENDENCIES_OK or DEPENDENCIES_FAILED.
+ */
+static unsigned int check_host_dependencies(
+                      host* hst,
+                      unsigned long epoch,
+                      time_t now) {
+  if (hst->dependencies_epoch == epoch)
+    return (hst->dependencies_result);
+  hst->dependencies_epoch = epoch;
+  hst->dependencies_result = DEPENDENCIES_OK;
+
+  for (hostdependency* temp_dependency(hst->dependencies);
+       temp_dependency;
+       temp_dependency = temp_dependency->next_dependency) {
+    host* temp_host(temp_dependency->master_host_ptr);
 
     // Skip this dependency if it has a timeperiod
     // and the current time isn't valid.
-    time(&current_time);
-    if (temp_dependency->dependency_period != NULL
-        && check_time_against_period(
-             current_time,
-             temp_dependency->dependency_period_ptr,
-             hst->timezone) == ERROR)
+    if (!is_dependency_period_valid(
+           temp_dependency,
+           now,
+           hst->timezone))
       return (DEPENDENCIES_OK);
 
     /* get the status to use (use last hard state if its currently in a soft state) */
+    int state;
     if (temp_host->state_type == SOFT_STATE
         && config->soft_state_dependencies() == false)
       state = temp_host->last_hard_state;
@@ -1699,26 +1747,31 @@ unsigned int check_host_dependencies(host* hst) {
       state = temp_host->current_state;
 
     /* is the host we depend on in state that fails the dependency tests? */
-    if (state == HOST_UP && temp_dependency->fail_on_up == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == HOST_DOWN && temp_dependency->fail_on_down == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == HOST_UNREACHABLE
-        && temp_dependency->fail_on_unreachable == true)
-      return (DEPENDENCIES_FAILED);
-    if ((state == HOST_UP && temp_host->has_been_checked == false)
-        && temp_dependency->fail_on_pending == true)
-      return (DEPENDENCIES_FAILED);
-
-    /* immediate dependencies ok at this point - check parent dependencies if necessary */
-    if (temp_dependency->inherits_parent == true) {
-      if (check_host_dependencies(temp_host) != DEPENDENCIES_OK)
-        return (DEPENDENCIES_FAILED);
-    }
+    if ((state == HOST_UP && temp_dependency->fail_on_up == true)
+        || (state == HOST_DOWN && temp_dependency->fail_on_down == true)
+        || (state == HOST_UNREACHABLE
+            && temp_dependency->fail_on_unreachable == true)
+        || ((state == HOST_UP && temp_host->has_been_checked == false)
+            && temp_dependency->fail_on_pending == true)
+        /* immediate dependencies ok at this point - check parent dependencies if necessary */
+        || (temp_dependency->inherits_parent == true
+            && check_host_dependencies(temp_host, epoch, now)
+               != DEPENDENCIES_OK))
+      return (hst->dependencies_result = DEPENDENCIES_FAILED);
   }
   return (DEPENDENCIES_OK);
 }
 
+/* checks host dependencies */
+unsigned int check_host_dependencies(host* hst) {
+  static unsigned long epoch(0);
+
+  logger(dbg_functions, basic)
+    << "check_host_dependencies()";
+
+  return (check_host_dependencies(hst, ++epoch, time(NULL)));
+}
+
 /* check freshness of host results */
 void check_host_result_freshness() {
   host* temp_host = NULL;
@@ -1740,9 +1793,10 @@ void check_host_result_freshness() {
   time(&current_time);
 
   /* check all hosts... */
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
+  for (unsigned int i(0), end(scheduling_table<host_struct>::size());
+       i < end;
+       ++i) {
+    temp_host = scheduling_table<host_struct>::at(i);
 
     /* skip hosts we shouldn't be checking for freshness */
     if (temp_host->check_freshness == false)
@@ -2201,6 +2255,9 @@ int handle_async_host_check_result_3x(
 
   /* update the execution time for this check (millisecond resolution) */
   temp_host->execution_time = execution_time;
+  update_average_execution_time(
+    temp_host->average_execution_time,
+    execution_time);
 
   /* set the checked flag */
   temp_host->has_been_checked = true;
@@ -2733,24 +2790,16 @@ int process_host_check_result_3x(
             << "Propagating predictive dependency checks to hosts this "
             "one depends on...";
 
-          std::string id(hst->name);
-          umultimap<std::string, shared_ptr<hostdependency> > const&
-            dependencies(state::instance().hostdependencies());
-          for (umultimap<std::string, shared_ptr<hostdependency> >::const_iterator
-                 it(dependencies.find(id)), end(dependencies.end());
-                 it != end && it->first == id;
-                 ++it) {
-            hostdependency* temp_dependency(&*it->second);
-            if (temp_dependency->dependent_host_ptr == hst
-                && temp_dependency->master_host_ptr != NULL) {
-              master_host = (host*)temp_dependency->master_host_ptr;
-              logger(dbg_checks, more)
-                << "Check of host '"
-                << master_host->name << "' queued.";
-              add_object_to_objectlist(
-                &check_hostlist,
-                (void*)master_host);
-            }
+          for (hostdependency* temp_dependency(hst->dependencies);
+               temp_dependency;
+               temp_dependency = temp_dependency->next_dependency) {
+            master_host = temp_dependency->master_host_ptr;
+            logger(dbg_checks, more)
+              << "Check of host '"
+              << master_host->name << "' queued.";
+            add_object_to_objectlist(
+              &check_hostlist,
+              (void*)master_host);
           }
         }
       }
@@ -2797,7 +2846,10 @@ int process_host_check_result_3x(
       hst->next_check = next_check;
 
     /* make sure we rescheduled the next service check at a valid time */
-    preferred_time = hst->next_check;
+    preferred_time = configuration::applier::scheduler::instance().spread_check(
+                       hst->last_check,
+                       hst->next_check,
+                       hst->average_execution_time);
     get_next_valid_time(
       preferred_time,
       &next_valid_time,
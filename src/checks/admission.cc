@@ -0,0 +1,309 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/admission.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
+#include "com/centreon/engine/events/defines.hh"
+#include "com/centreon/engine/events/hash_timed_event.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static admission* _instance = NULL;
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Admit a service check or defer it.
+ *
+ *  @param[in] svc    Service about to be checked.
+ *  @param[in] force  Forced checks are always admitted.
+ *
+ *  @return True if the check can run now, false if it was deferred.
+ */
+bool admission::acquire(service* svc, bool force) {
+  service_id id(svc->host_name, svc->description);
+  if (_admitted.find(id) != _admitted.end())
+    return (true);
+
+  // Refresh limits.
+  std::string command(svc->check_command_ptr
+                      ? svc->check_command_ptr->name
+                      : "");
+  slots& host_slots(_hosts[id.first]);
+  slots& command_slots(_commands[command]);
+  _global.limit = parallelism::instance().limit();
+  _global.running = currently_running_service_checks;
+  host_slots.limit = config->max_concurrent_checks_per_host();
+  command_slots.limit = config->max_concurrent_checks_per_command();
+
+  // Wait in the queue of the first limit reached.
+  if (!force) {
+    slots* full(NULL);
+    if (!_is_available(_global, id))
+      full = &_global;
+    else if (!_is_available(host_slots, id))
+      full = &host_slots;
+    else if (!_is_available(command_slots, id))
+      full = &command_slots;
+    if (full) {
+      logger(dbg_events | dbg_checks, more)
+        << "Deferring check of service '" << id.second
+        << "' on host '" << id.first << "': "
+        << ((full == &_global)
+            ? "max concurrent checks"
+            : ((full == &host_slots)
+               ? "max concurrent checks per host"
+               : "max concurrent checks per command"))
+        << " (" << full->limit << ") reached";
+      if (full == &_global)
+        parallelism::instance().check_deferred();
+      _defer(*full, id);
+      return (false);
+    }
+  }
+
+  // Leave the waiting queue, the next check might use another slot.
+  umap<service_id, slots*>::iterator it(_deferred.find(id));
+  if (it != _deferred.end()) {
+    slots& s(*it->second);
+    _deferred.erase(it);
+    for (std::deque<service_id>::iterator
+           it_waiting(s.waiting.begin()), end(s.waiting.end());
+         it_waiting != end;
+         ++it_waiting)
+      if (*it_waiting == id) {
+        s.waiting.erase(it_waiting);
+        break ;
+      }
+    // This check is not counted yet by currently_running_service_checks.
+    if (&s == &_global)
+      ++_global.running;
+    _wake(s);
+  }
+
+  // Hold slots until the check result is processed.
+  ++host_slots.running;
+  ++command_slots.running;
+  holder& h(_admitted[id]);
+  h.command = command;
+  h.host = id.first;
+  return (true);
+}
+
+/**
+ *  Get the number of deferred service checks.
+ *
+ *  @return Number of checks waiting for a slot.
+ */
+unsigned int admission::deferred() const throw () {
+  return (_deferred.size());
+}
+
+/**
+ *  Get instance of the admission singleton.
+ *
+ *  @return This singleton.
+ */
+admission& admission::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void admission::load() {
+  if (!_instance)
+    _instance = new admission;
+  return ;
+}
+
+/**
+ *  Release the slots of a service check. This is called when an active
+ *  service check result was processed or when an admitted check did
+ *  not start.
+ *
+ *  @param[in] host_name            Host name.
+ *  @param[in] service_description  Service description.
+ */
+void admission::release(
+                  std::string const& host_name,
+                  std::string const& service_description) {
+  umap<service_id, holder>::iterator
+    it(_admitted.find(std::make_pair(host_name, service_description)));
+  if (it != _admitted.end()) {
+    _release(
+      _hosts,
+      it->second.host,
+      config->max_concurrent_checks_per_host());
+    _release(
+      _commands,
+      it->second.command,
+      config->max_concurrent_checks_per_command());
+    _admitted.erase(it);
+  }
+  _global.limit = parallelism::instance().limit();
+  _global.running = currently_running_service_checks;
+  _wake(_global);
+  return ;
+}
+
+/**
+ *  Unload singleton.
+ */
+void admission::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+admission::admission() {}
+
+/**
+ *  Destructor.
+ */
+admission::~admission() throw () {}
+
+/**
+ *  Put a service check in a waiting queue.
+ *
+ *  @param[in,out] s   Slots of the limit that was reached.
+ *  @param[in]     id  Service.
+ */
+void admission::_defer(slots& s, service_id const& id) {
+  umap<service_id, slots*>::iterator it(_deferred.find(id));
+  if (it == _deferred.end()) {
+    _deferred[id] = &s;
+    s.waiting.push_back(id);
+  }
+  else if (it->second != &s) {
+    // The check was woken up by a limit but is now blocked by another.
+    slots& previous(*it->second);
+    for (std::deque<service_id>::iterator
+           it_waiting(previous.waiting.begin()),
+           end(previous.waiting.end());
+         it_waiting != end;
+         ++it_waiting)
+      if (*it_waiting == id) {
+        previous.waiting.erase(it_waiting);
+        break ;
+      }
+    it->second = &s;
+    s.waiting.push_back(id);
+    _wake(previous);
+  }
+  _wake(s);
+  return ;
+}
+
+/**
+ *  Check if a service check can use a slot.
+ *
+ *  @param[in] s   Slots of a limit.
+ *  @param[in] id  Service.
+ *
+ *  @return True if a slot is available and no other check waits
+ *          before this one.
+ */
+bool admission::_is_available(slots const& s, service_id const& id) {
+  if (!s.limit)
+    return (true);
+  return ((s.running < s.limit)
+          && (s.waiting.empty() || (s.waiting.front() == id)));
+}
+
+/**
+ *  Release a slot of a per-host or per-command limit.
+ *
+ *  @param[in,out] keys   Slots of the limit.
+ *  @param[in]     key    Host name or command name.
+ *  @param[in]     limit  Current limit.
+ */
+void admission::_release(
+                  umap<std::string, slots>& keys,
+                  std::string const& key,
+                  unsigned int limit) {
+  umap<std::string, slots>::iterator it(keys.find(key));
+  if (it == keys.end())
+    return ;
+  slots& s(it->second);
+  if (s.running)
+    --s.running;
+  s.limit = limit;
+  if (!s.running && s.waiting.empty())
+    keys.erase(it);
+  else
+    _wake(s);
+  return ;
+}
+
+/**
+ *  Move the check event of the first waiting service to the current
+ *  time if a slot is available.
+ *
+ *  @param[in,out] s  Slots of a limit.
+ */
+void admission::_wake(slots& s) {
+  while (!s.waiting.empty()
+         && (!s.limit || (s.running < s.limit))) {
+    service_id const& id(s.waiting.front());
+    timed_event* evt(NULL);
+    service* svc(NULL);
+    if (is_service_exist(id)) {
+      svc = &find_service(id.first, id.second);
+      evt = quick_timed_event.find(
+                                events::hash_timed_event::low,
+                                events::hash_timed_event::service_check,
+                                svc);
+    }
+    if (evt) {
+      time_t now(time(NULL));
+      if (evt->run_time > now) {
+        remove_event(evt, &event_list_low, &event_list_low_tail);
+        evt->run_time = now;
+        svc->next_check = now;
+        reschedule_event(evt, &event_list_low, &event_list_low_tail);
+      }
+      break ;
+    }
+
+    // The service or its check was removed.
+    _deferred.erase(id);
+    s.waiting.pop_front();
+  }
+  return ;
+}
@@ -26,7 +26,9 @@
 #include "com/centreon/exceptions/interruption.hh"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/checks/admission.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
 #include "com/centreon/engine/checks/viability_failure.hh"
 #include "com/centreon/engine/commands/command.hh"
 #include "com/centreon/engine/commands/set.hh"
@@ -53,6 +55,25 @@ static checker* _instance = NULL;
 *                                     *
 **************************************/
 
+/**
+ *  Get the number of active checks that were attached to an identical
+ *  command already in execution.
+ *
+ *  @return Number of coalesced checks.
+ */
+unsigned long long checker::coalesced_checks() const throw () {
+  return (_coalesced);
+}
+
+/**
+ *  Get the number of active check commands that were executed.
+ *
+ *  @return Number of executed check commands.
+ */
+unsigned long long checker::executed_checks() const throw () {
+  return (_executed);
+}
+
 /**
  *  Get instance of the checker singleton.
  *
@@ -105,6 +126,33 @@ void checker::reap() {
       // Find the two parts.
       umap<unsigned long, check_result>::iterator
         it_partial(_to_reap_partial.begin());
+
+      // Fan out the result to the checks attached to this execution.
+      umap<unsigned long, flight>::iterator
+        it_flight(_flights.find(it_partial->first));
+      if (it_flight != _flights.end()) {
+        for (std::list<check_result>::iterator
+               it(it_flight->second.waiters.begin()),
+               end(it_flight->second.waiters.end());
+             it != end;
+             ++it) {
+          check_result result(*it);
+          result.finish_time.tv_sec = it_partial->second.finish_time.tv_sec;
+          result.finish_time.tv_usec = it_partial->second.finish_time.tv_usec;
+          result.early_timeout = it_partial->second.early_timeout;
+          result.return_code = it_partial->second.return_code;
+          result.exited_ok = it_partial->second.exited_ok;
+          result.output = string::dup(it_partial->second.output);
+          _to_reap.push(result);
+        }
+        umap<std::string, unsigned long>::iterator
+          it_cmd(_flights_by_cmd.find(it_flight->second.command_line));
+        if ((it_cmd != _flights_by_cmd.end())
+            && (it_cmd->second == it_flight->first))
+          _flights_by_cmd.erase(it_cmd);
+        _flights.erase(it_flight);
+      }
+
       umap<unsigned long, check_result>::iterator
         it_id(_list_id.find(it_partial->first));
       if (_list_id.end() == it_id) {
@@ -165,6 +213,14 @@ void checker::reap() {
             << "could not be found! Perhaps you forgot to define the "
             << "service in your config files ?";
         }
+
+        // Let deferred checks use the slots of this one.
+        if (SERVICE_CHECK_ACTIVE == result.check_type) {
+          parallelism::instance().check_completed();
+          admission::instance().release(
+            result.host_name,
+            result.service_description);
+        }
       }
       // Host check result.
       else {
@@ -425,6 +481,12 @@ void checker::run(
     start_time.tv_sec);
   update_check_stats(PARALLEL_HOST_CHECK_STATS, start_time.tv_sec);
 
+  // Share the result of an identical command already running.
+  if (_attach(processed_cmd, check_result_info)) {
+    clear_volatile_macros_r(&macros);
+    return;
+  }
+
   // Run command.
   bool retry;
   do {
@@ -435,8 +497,10 @@ void checker::run(
                               processed_cmd,
                               macros,
                               timeout));
-      if (id != 0)
+      if (id != 0) {
         _list_id[id] = check_result_info;
+        _register(id, processed_cmd);
+      }
     }
     catch (com::centreon::exceptions::interruption const& e) {
       (void)e;
@@ -658,6 +722,13 @@ void checker::run(
     ? ACTIVE_SCHEDULED_SERVICE_CHECK_STATS
     : ACTIVE_ONDEMAND_SERVICE_CHECK_STATS,
     start_time.tv_sec);
+  parallelism::instance().check_started(latency);
+
+  // Share the result of an identical command already running.
+  if (_attach(processed_cmd, check_result_info)) {
+    clear_volatile_macros_r(&macros);
+    return;
+  }
 
   bool retry;
   do {
@@ -668,8 +739,10 @@ void checker::run(
                               processed_cmd,
                               macros,
                               timeout));
-      if (id != 0)
+      if (id != 0) {
         _list_id[id] = check_result_info;
+        _register(id, processed_cmd);
+      }
     }
     catch (com::centreon::exceptions::interruption const& e) {
       (void)e;
@@ -901,7 +974,9 @@ void checker::unload() {
  *  Default constructor.
  */
 checker::checker()
-  : commands::command_listener() {
+  : commands::command_listener(),
+    _coalesced(0),
+    _executed(0) {
 
 }
 
@@ -915,6 +990,16 @@ checker::~checker() throw () {
       free_check_result(&_to_reap.front());
       _to_reap.pop();
     }
+    for (umap<unsigned long, flight>::iterator
+           it(_flights.begin()), end(_flights.end());
+         it != end;
+         ++it)
+      for (std::list<check_result>::iterator
+             it_waiter(it->second.waiters.begin()),
+             end_waiter(it->second.waiters.end());
+           it_waiter != end_waiter;
+           ++it_waiter)
+        free_check_result(&*it_waiter);
   }
   catch (...) {}
 }
@@ -931,17 +1016,7 @@ void checker::finished(commands::result const& res) throw () {
 
   // Find check result.
   check_result result;
-  memset(&result, 0, sizeof(result));
-
-  // Update check result.
-  result.finish_time.tv_sec = res.end_time.to_seconds();
-  result.finish_time.tv_usec = res.end_time.to_useconds()
-                               - result.finish_time.tv_sec * 1000000ull;
-  result.early_timeout = (res.exit_status == process::timeout);
-  result.return_code = res.exit_code;
-  result.exited_ok = ((res.exit_status == process::normal)
-                      || (res.exit_status == process::timeout));
-  result.output = string::dup(res.output);
+  _to_check_result(res, result);
 
   // Queue check result.
   concurrency::locker lock(&_mut_reap);
@@ -949,6 +1024,74 @@ void checker::finished(commands::result const& res) throw () {
   return;
 }
 
+/**
+ *  Slot to catch several results at once and add them to the reap
+ *  queue with a single lock.
+ *
+ *  @param[in] results The results of the executions.
+ */
+void checker::finished_batch(
+                std::vector<commands::result> const& results) throw () {
+  // Debug message.
+  logger(dbg_functions, basic)
+    << "checker::finished_batch: results=" << results.size();
+
+  concurrency::locker lock(&_mut_reap);
+  for (std::vector<commands::result>::const_iterator
+         it(results.begin()), end(results.end());
+       it != end;
+       ++it)
+    _to_check_result(*it, _to_reap_partial[it->command_id]);
+  return;
+}
+
+/**
+ *  Attach a check to an identical command line already in execution.
+ *  The check will get a copy of the result of the running command
+ *  instead of starting a new process.
+ *
+ *  @param[in] processed_cmd  Command line after macro processing.
+ *  @param[in] info           Check result base of the attached check.
+ *
+ *  @return True if the check was attached, false if it must run.
+ */
+bool checker::_attach(
+       std::string const& processed_cmd,
+       check_result const& info) {
+  unsigned int window(config->check_coalescing_window());
+  if (!window)
+    return (false);
+
+  // Find an execution of the same command line.
+  umap<std::string, unsigned long>::iterator
+    it_cmd(_flights_by_cmd.find(processed_cmd));
+  if (it_cmd == _flights_by_cmd.end())
+    return (false);
+  umap<unsigned long, flight>::iterator
+    it_flight(_flights.find(it_cmd->second));
+  if ((it_flight == _flights.end())
+      || (info.start_time.tv_sec - it_flight->second.start_time
+          >= static_cast<time_t>(window)))
+    return (false);
+
+  // Do not attach to a result that is already available.
+  {
+    concurrency::locker lock(&_mut_reap);
+    if (_to_reap_partial.find(it_flight->first)
+        != _to_reap_partial.end())
+      return (false);
+  }
+
+  it_flight->second.waiters.push_back(info);
+  ++_coalesced;
+  logger(dbg_checks, more)
+    << "Check of '" << info.host_name
+    << (info.service_description ? "/" : "")
+    << (info.service_description ? info.service_description : "")
+    << "' attached to running command ID (" << it_flight->first << ")";
+  return (true);
+}
+
 /**
  *  Run an host check with waiting check result.
  *
@@ -1234,3 +1377,44 @@ int checker::_execute_sync(host* hst) {
     << "** Sync host check done: state=" << return_result;
   return (return_result);
 }
+
+/**
+ *  Record a command execution that later identical checks can attach
+ *  to.
+ *
+ *  @param[in] id             Command ID.
+ *  @param[in] processed_cmd  Command line after macro processing.
+ */
+void checker::_register(
+       unsigned long id,
+       std::string const& processed_cmd) {
+  ++_executed;
+  if (!config->check_coalescing_window())
+    return ;
+  flight& f(_flights[id]);
+  f.command_line = processed_cmd;
+  f.start_time = time(NULL);
+  _flights_by_cmd[processed_cmd] = id;
+  return ;
+}
+
+/**
+ *  Convert a command result into a check result.
+ *
+ *  @param[in]  res     The result of the execution.
+ *  @param[out] result  The check result.
+ */
+void checker::_to_check_result(
+                commands::result const& res,
+                check_result& result) {
+  memset(&result, 0, sizeof(result));
+  result.finish_time.tv_sec = res.end_time.to_seconds();
+  result.finish_time.tv_usec = res.end_time.to_useconds()
+                               - result.finish_time.tv_sec * 1000000ull;
+  result.early_timeout = (res.exit_status == process::timeout);
+  result.return_code = res.exit_code;
+  result.exited_ok = ((res.exit_status == process::normal)
+                      || (res.exit_status == process::timeout));
+  result.output = string::dup(res.output);
+  return;
+}
@@ -0,0 +1,269 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <unistd.h>
+#include "com/centreon/engine/checks/parallelism.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static parallelism* _instance = NULL;
+
+// Seconds between two adjustments.
+static time_t const       adjust_interval(5);
+// Upper bound when max_concurrent_checks is unlimited.
+static unsigned int const default_max_limit(1024);
+// Run queue length per CPU above which the system is overloaded.
+static double const       max_run_queue_load(2.0);
+// Latency (in seconds) above which more checks should run.
+static double const       target_latency(1.0);
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Account for a completed service check.
+ */
+void parallelism::check_completed() throw () {
+  ++_completed;
+  return ;
+}
+
+/**
+ *  Account for a service check that waits for a slot of the global
+ *  limit.
+ */
+void parallelism::check_deferred() throw () {
+  ++_deferred;
+  return ;
+}
+
+/**
+ *  Account for a started service check.
+ *
+ *  @param[in] latency  Scheduling latency of the check.
+ */
+void parallelism::check_started(double latency) throw () {
+  ++_started;
+  _latency_sum += latency;
+  return ;
+}
+
+/**
+ *  Get the check completion rate measured by the last adjustment.
+ *
+ *  @return Completed checks per second.
+ */
+double parallelism::completion_rate() const throw () {
+  return (_completion_rate);
+}
+
+/**
+ *  Get instance of the parallelism singleton.
+ *
+ *  @return This singleton.
+ */
+parallelism& parallelism::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Get the average check latency measured by the last adjustment.
+ *
+ *  @return Latency in seconds.
+ */
+double parallelism::latency() const throw () {
+  return (_latency);
+}
+
+/**
+ *  Get the effective limit of concurrent service checks.
+ *
+ *  @return Maximum number of concurrent checks, 0 if unlimited.
+ */
+unsigned int parallelism::limit() const throw () {
+  if (!config->use_adaptive_concurrent_checks())
+    return (config->max_parallel_service_checks());
+  unsigned int min;
+  unsigned int max;
+  _bounds(min, max);
+  // Start from the maximum and let the adjustments lower it.
+  if (!_limit || (_limit > max))
+    return (max);
+  if (_limit < min)
+    return (min);
+  return (_limit);
+}
+
+/**
+ *  Load singleton.
+ */
+void parallelism::load() {
+  if (!_instance)
+    _instance = new parallelism;
+  return ;
+}
+
+/**
+ *  Get the run queue load per CPU measured by the last adjustment.
+ *
+ *  @return Run queue load.
+ */
+double parallelism::run_queue_load() const throw () {
+  return (_run_queue_load);
+}
+
+/**
+ *  Unload singleton.
+ */
+void parallelism::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Adjust the limit with the current system load.
+ *
+ *  @param[in] now  Current time.
+ */
+void parallelism::update(time_t now) {
+  if (now - _last_update < adjust_interval)
+    return ;
+  double load(0.0);
+  long cpus(sysconf(_SC_NPROCESSORS_ONLN));
+  if ((getloadavg(&load, 1) != 1) || (cpus <= 0))
+    load = 0.0;
+  else
+    load /= cpus;
+  update(now, load);
+  return ;
+}
+
+/**
+ *  Adjust the limit of concurrent checks.
+ *
+ *  @param[in] now             Current time.
+ *  @param[in] run_queue_load  Run queue length per CPU.
+ */
+void parallelism::update(time_t now, double run_queue_load) {
+  if (!_last_update) {
+    _last_update = now;
+    return ;
+  }
+  time_t elapsed(now - _last_update);
+  if (elapsed < adjust_interval)
+    return ;
+
+  // Measures of the last period.
+  double previous_rate(_completion_rate);
+  _completion_rate = static_cast<double>(_completed) / elapsed;
+  _latency = (_started ? _latency_sum / _started : 0.0);
+  _run_queue_load = run_queue_load;
+  // Checks waited for a slot during the period.
+  bool saturated(_deferred > 0);
+  _completed = 0;
+  _deferred = 0;
+  _latency_sum = 0.0;
+  _started = 0;
+  _last_update = now;
+  if (!config->use_adaptive_concurrent_checks()) {
+    _last_action = 0;
+    return ;
+  }
+
+  unsigned int current(limit());
+
+  // Additive increase, multiplicative decrease.
+  int action(0);
+  if (_run_queue_load > max_run_queue_load)
+    action = -1;
+  else if ((_last_action > 0)
+           && (_completion_rate < previous_rate * 0.9))
+    action = -1;
+  else if (saturated && (_latency > target_latency))
+    action = 1;
+  if (action > 0)
+    current += (current / 8 ? current / 8 : 1);
+  else if (action < 0)
+    current -= current / 4;
+  _last_action = action;
+  _limit = current;
+  _limit = limit();
+
+  if (action)
+    logger(dbg_checks, basic)
+      << "Concurrent check limit set to " << _limit
+      << " (latency=" << _latency
+      << "s, completion rate=" << _completion_rate
+      << "/s, run queue load=" << _run_queue_load << ")";
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+parallelism::parallelism()
+  : _completed(0),
+    _deferred(0),
+    _completion_rate(0.0),
+    _last_action(0),
+    _last_update(0),
+    _latency(0.0),
+    _latency_sum(0.0),
+    _limit(0),
+    _run_queue_load(0.0),
+    _started(0) {}
+
+/**
+ *  Destructor.
+ */
+parallelism::~parallelism() throw () {}
+
+/**
+ *  Get the configured bounds of the limit.
+ *
+ *  @param[out] min  Lower bound.
+ *  @param[out] max  Upper bound.
+ */
+void parallelism::_bounds(unsigned int& min, unsigned int& max) {
+  max = config->max_parallel_service_checks();
+  if (!max)
+    max = default_max_limit;
+  min = config->min_concurrent_checks();
+  if (!min)
+    min = 1;
+  if (min > max)
+    min = max;
+  return ;
+}
@@ -122,6 +122,64 @@ void commands::command::set_listener(
   return;
 }
 
+/**
+ *  Split a command line into arguments the way a shell would for
+ *  simple commands: words are separated by blanks, quotes group
+ *  words and a backslash escapes the next character outside single
+ *  quotes.
+ *
+ *  @param[in]  command_line  Processed command line.
+ *  @param[out] args          Arguments.
+ */
+void commands::command::split(
+                          std::string const& command_line,
+                          std::vector<std::string>& args) {
+  args.clear();
+  std::string arg;
+  bool in_arg(false);
+  char quote(0);
+  for (std::string::const_iterator
+         it(command_line.begin()), end(command_line.end());
+       it != end;
+       ++it) {
+    char c(*it);
+    if (quote == '\'') {
+      if (c == '\'')
+        quote = 0;
+      else
+        arg.push_back(c);
+    }
+    else if ((c == '\\') && (it + 1 != end)) {
+      arg.push_back(*++it);
+      in_arg = true;
+    }
+    else if (quote == '"') {
+      if (c == '"')
+        quote = 0;
+      else
+        arg.push_back(c);
+    }
+    else if ((c == '\'') || (c == '"')) {
+      quote = c;
+      in_arg = true;
+    }
+    else if ((c == ' ') || (c == '\t') || (c == '\n')) {
+      if (in_arg) {
+        args.push_back(arg);
+        arg.clear();
+        in_arg = false;
+      }
+    }
+    else {
+      arg.push_back(c);
+      in_arg = true;
+    }
+  }
+  if (in_arg)
+    args.push_back(arg);
+  return ;
+}
+
 /**
  *  Default copy constructor.
  *
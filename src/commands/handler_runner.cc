@@ -0,0 +1,345 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <utility>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/commands/handler_runner.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/defines.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/service.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static handler_runner* _instance = NULL;
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+handler_runner::job::job()
+  : handler_type(-1),
+    state(0),
+    state_type(0),
+    timeout(0) {
+  start_time.tv_sec = 0;
+  start_time.tv_usec = 0;
+}
+
+/**
+ *  Get instance of the handler runner singleton.
+ *
+ *  @return This singleton.
+ */
+handler_runner& handler_runner::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void handler_runner::load() {
+  if (!_instance)
+    _instance = new handler_runner;
+  return ;
+}
+
+/**
+ *  Process the commands that completed since the last call and start
+ *  the waiting ones that now fit within the concurrency limit. Must
+ *  be called from the main thread.
+ */
+void handler_runner::reap() {
+  umap<unsigned long, result> finished;
+  {
+    concurrency::locker lock(&_mut_finished);
+    if (_finished.empty() && _waiting.empty())
+      return ;
+    finished.swap(_finished);
+  }
+
+  for (umap<unsigned long, result>::const_iterator
+         it(finished.begin()), end(finished.end());
+       it != end;
+       ++it) {
+    umap<unsigned long, job>::iterator job_it(_running.find(it->first));
+    if (job_it == _running.end()) {
+      logger(log_runtime_warning, basic)
+        << "Warning: Result of unknown event handler command (id="
+        << it->first << ") was dropped";
+      continue ;
+    }
+    job j(job_it->second);
+    _running.erase(job_it);
+    _complete(j, it->second);
+  }
+
+  unsigned int max_running(config->max_concurrent_event_handlers());
+  while (!_waiting.empty()
+         && (!max_running || _running.size() < max_running)) {
+    job j(_waiting.front());
+    _waiting.pop_front();
+    _launch(j);
+  }
+  return ;
+}
+
+/**
+ *  Get the number of commands currently running.
+ *
+ *  @return Number of running commands.
+ */
+unsigned int handler_runner::running() const throw () {
+  return (_running.size());
+}
+
+/**
+ *  Run a command. It is started immediately if the concurrency limit
+ *  allows it, queued otherwise.
+ *
+ *  @param[in] j  Command to run. handler_type is one of the event
+ *                handler types, or -1 for obsessive commands.
+ */
+void handler_runner::run(job const& j) {
+  unsigned int max_running(config->max_concurrent_event_handlers());
+  if (max_running && (_running.size() >= max_running)) {
+    logger(dbg_eventhandlers, more)
+      << "Maximum concurrent event handlers (" << max_running
+      << ") reached, delaying command '" << j.command_line << "'";
+    _waiting.push_back(j);
+  }
+  else {
+    job copy(j);
+    _launch(copy);
+  }
+  return ;
+}
+
+/**
+ *  Unload singleton.
+ */
+void handler_runner::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Get the number of commands waiting for a free slot.
+ *
+ *  @return Number of waiting commands.
+ */
+unsigned int handler_runner::waiting() const throw () {
+  return (_waiting.size());
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+handler_runner::handler_runner()
+  : command_listener(),
+    _raw("system", "", this) {}
+
+/**
+ *  Destructor. The process reactor is unloaded first and kills the
+ *  commands that are still running, so their completion will never
+ *  be reported. Waiting commands are not started.
+ */
+handler_runner::~handler_runner() throw () {
+  try {
+    if (!_running.empty() || !_waiting.empty())
+      logger(dbg_eventhandlers, basic)
+        << "Dropping " << static_cast<unsigned int>(_running.size())
+        << " running and " << static_cast<unsigned int>(_waiting.size())
+        << " waiting event handler commands";
+  }
+  catch (...) {}
+}
+
+/**
+ *  Log and broadcast the completion of a command.
+ *
+ *  @param[in] j    Completed command.
+ *  @param[in] res  Command result.
+ */
+void handler_runner::_complete(job& j, result const& res) {
+  timeval end_time;
+  end_time.tv_sec = res.end_time.to_seconds();
+  end_time.tv_usec
+    = res.end_time.to_useconds() - end_time.tv_sec * 1000000ull;
+  double exectime((res.end_time - res.start_time).to_seconds());
+  int early_timeout(res.exit_status == process::timeout);
+  char* cmd(const_cast<char*>(j.command_line.c_str()));
+  char* output(const_cast<char*>(res.output.c_str()));
+
+  logger(dbg_commands, more)
+    << com::centreon::logging::setprecision(3)
+    << "Execution time=" << exectime
+    << " sec, early timeout=" << early_timeout
+    << ", result=" << res.exit_code << ", output=" << res.output;
+
+  // Send event broker.
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_END,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j.start_time,
+    end_time,
+    exectime,
+    j.timeout,
+    early_timeout,
+    res.exit_code,
+    cmd,
+    output,
+    NULL);
+
+  // Check to see if the command timed out.
+  if (early_timeout)
+    logger((j.handler_type < 0)
+           ? log_runtime_warning
+           : log_event_handler | log_runtime_warning, basic)
+      << "Warning: " << j.timeout_message << " timed out after "
+      << j.timeout << " seconds";
+
+  if (j.handler_type < 0)
+    return ;
+
+  // The object might have been removed by a reload in the meantime.
+  void* data(NULL);
+  if (j.service_description.empty()) {
+    if (is_host_exist(j.host_name))
+      data = &find_host(j.host_name);
+  }
+  else if (is_service_exist(std::make_pair(
+                              j.host_name,
+                              j.service_description)))
+    data = &find_service(j.host_name, j.service_description);
+  if (!data) {
+    logger(dbg_eventhandlers, more)
+      << "Event handler command '" << j.command_line
+      << "' completed but its object does not exist anymore";
+    return ;
+  }
+
+  // Send event data to broker.
+  broker_event_handler(
+    NEBTYPE_EVENTHANDLER_END,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j.handler_type,
+    data,
+    j.state,
+    j.state_type,
+    j.start_time,
+    end_time,
+    exectime,
+    j.timeout,
+    early_timeout,
+    res.exit_code,
+    j.command_name.c_str(),
+    cmd,
+    output,
+    NULL);
+  return ;
+}
+
+/**
+ *  Start a command.
+ *
+ *  @param[in] j  Command to start.
+ */
+void handler_runner::_launch(job& j) {
+  logger(dbg_commands, more)
+    << "Running command '" << j.command_line << "'...";
+
+  // Send event broker.
+  timeval end_time;
+  end_time.tv_sec = 0;
+  end_time.tv_usec = 0;
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_START,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j.start_time,
+    end_time,
+    0.0,
+    j.timeout,
+    false,
+    STATE_OK,
+    const_cast<char*>(j.command_line.c_str()),
+    NULL,
+    NULL);
+
+  try {
+    nagios_macros macros;
+    memset(&macros, 0, sizeof(macros));
+    unsigned long id(_raw.run(j.command_line, macros, j.timeout));
+    _running[id] = j;
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: can't execute command line '" << j.command_line
+      << "' : " << e.what();
+
+    // Report the failure as an immediate completion.
+    result res;
+    res.start_time = timestamp::now();
+    res.end_time = res.start_time;
+    res.exit_code = STATE_UNKNOWN;
+    res.exit_status = process::normal;
+    res.output = "(Execute command failed)";
+    _complete(j, res);
+  }
+  return ;
+}
+
+/**
+ *  Slot called by the process thread at the end of a command.
+ *
+ *  @param[in] res  Command result.
+ */
+void handler_runner::finished(result const& res) throw () {
+  logger(dbg_functions, basic)
+    << "handler_runner::finished: id=" << res.command_id;
+  try {
+    concurrency::locker lock(&_mut_finished);
+    _finished[res.command_id] = res;
+  }
+  catch (...) {}
+  return ;
+}
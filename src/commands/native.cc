@@ -0,0 +1,188 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/concurrency/condvar.hh"
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/commands/native.hh"
+#include "com/centreon/engine/commands/native_pool.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  @class native_waiter
+ *  @brief Wait for the result of a native check.
+ */
+class                  native_waiter : public command_listener {
+public:
+                       native_waiter() : _finished(false) {}
+                       ~native_waiter() throw () {}
+  void                 finished(result const& res) throw () {
+    concurrency::locker lock(&_lock);
+    _res = res;
+    _finished = true;
+    _cv.wake_all();
+  }
+  void                 wait(result& res) {
+    concurrency::locker lock(&_lock);
+    while (!_finished)
+      _cv.wait(&_lock);
+    res = _res;
+  }
+
+private:
+  concurrency::condvar _cv;
+  bool                 _finished;
+  concurrency::mutex   _lock;
+  result               _res;
+};
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] name         The command name.
+ *  @param[in] command_line The command line.
+ *  @param[in] listener     The listener who catch events.
+ */
+native::native(
+          std::string const& name,
+          std::string const& command_line,
+          command_listener* listener)
+  : command(name, command_line, listener) {}
+
+/**
+ *  Copy constructor
+ *
+ *  @param[in] right Object to copy.
+ */
+native::native(native const& right) : command(right) {}
+
+/**
+ *  Destructor. Running checks do not reference their command, they
+ *  are owned by the native pool.
+ */
+native::~native() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] right Object to copy.
+ *
+ *  @return This object.
+ */
+native& native::operator=(native const& right) {
+  if (this != &right)
+    command::operator=(right);
+  return (*this);
+}
+
+/**
+ *  Get a pointer on a copy of the same object.
+ *
+ *  @return Return a pointer on a copy object.
+ */
+commands::command* native::clone() const {
+  return (new native(*this));
+}
+
+/**
+ *  Run a command.
+ *
+ *  @param[in] args    The command arguments.
+ *  @param[in] macros  The macros data struct.
+ *  @param[in] timeout The command timeout.
+ *
+ *  @return The command id.
+ */
+unsigned long native::run(
+                        std::string const& processed_cmd,
+                        nagios_macros& macros,
+                        unsigned int timeout) {
+  (void)macros;
+  logger(dbg_commands, basic)
+    << "native::run: cmd='" << processed_cmd
+    << "', timeout=" << timeout;
+
+  std::vector<std::string> args;
+  split(processed_cmd, args);
+  if (args.empty())
+    throw (engine_error() << "Native command '" << _name
+           << "' has an empty command line");
+  native_pool& pool(native_pool::instance());
+  native_pool::check_func func(pool.find(args[0]));
+
+  unsigned long command_id(get_uniq_id());
+  pool.run(command_id, func, args, timeout, _listener);
+
+  logger(dbg_commands, basic)
+    << "native::run: check queued: id=" << command_id;
+  return (command_id);
+}
+
+/**
+ *  Run a command and wait the result.
+ *
+ *  @param[in]  args    The command arguments.
+ *  @param[in]  macros  The macros data struct.
+ *  @param[in]  timeout The command timeout.
+ *  @param[out] res     The result of the command.
+ */
+void native::run(
+               std::string const& processed_cmd,
+               nagios_macros& macros,
+               unsigned int timeout,
+               result& res) {
+  (void)macros;
+  logger(dbg_commands, basic)
+    << "native::run: cmd='" << processed_cmd
+    << "', timeout=" << timeout;
+
+  std::vector<std::string> args;
+  split(processed_cmd, args);
+  if (args.empty())
+    throw (engine_error() << "Native command '" << _name
+           << "' has an empty command line");
+  native_pool& pool(native_pool::instance());
+  native_pool::check_func func(pool.find(args[0]));
+
+  native_waiter waiter;
+  pool.run(get_uniq_id(), func, args, timeout, &waiter);
+  waiter.wait(res);
+
+  logger(dbg_commands, basic)
+    << "native::run: end check: "
+    "id=" << res.command_id << ", "
+    "start_time=" << res.start_time.to_mseconds() << ", "
+    "end_time=" << res.end_time.to_mseconds() << ", "
+    "exit_code=" << res.exit_code << ", "
+    "exit_status=" << res.exit_status << ", "
+    "output='" << res.output << "'";
+  return ;
+}
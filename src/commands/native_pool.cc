@@ -0,0 +1,434 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/commands/native_pool.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static native_pool* _instance = NULL;
+
+// Size of the output buffer given to plugins.
+static unsigned int const output_size(8192);
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Get the check function of a native plugin, loading the plugin
+ *  the first time it is used.
+ *
+ *  @param[in] path  Path of the plugin shared object.
+ *
+ *  @return Check function of the plugin.
+ */
+native_pool::check_func native_pool::find(std::string const& path) {
+  concurrency::locker lock(&_mut_plugins);
+  umap<std::string, plugin>::const_iterator it(_plugins.find(path));
+  if (it != _plugins.end())
+    return (it->second.func);
+
+  plugin p;
+  try {
+    p.lib = shared_ptr<library>(new library(path));
+    p.lib->load();
+    int api_version(*static_cast<int*>(
+          p.lib->resolve("__native_check_api_version")));
+    if (api_version != CURRENT_NATIVE_CHECK_API_VERSION)
+      throw (engine_error() << "plugin is using an old or unspecified "
+             "version of the native check API");
+    p.func = (check_func)p.lib->resolve_proc("native_check");
+  }
+  catch (std::exception const& e) {
+    throw (engine_error() << "Cannot load native check plugin '"
+           << path << "': " << e.what());
+  }
+  _plugins[path] = p;
+
+  logger(dbg_commands, basic)
+    << "Native check plugin '" << path << "' loaded";
+  return (p.func);
+}
+
+/**
+ *  Get instance of the native pool singleton.
+ *
+ *  @return This singleton.
+ */
+native_pool& native_pool::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void native_pool::load() {
+  if (!_instance)
+    _instance = new native_pool;
+  return ;
+}
+
+/**
+ *  Queue a check. A worker is started if none is available and the
+ *  native_check_workers limit allows it. The timeout runs from now,
+ *  so a check that waits too long for a worker is reported as timed
+ *  out without being run.
+ *
+ *  @param[in] command_id  Id of the result.
+ *  @param[in] func        Check function to call.
+ *  @param[in] args        Check arguments, plugin path included.
+ *  @param[in] timeout     Timeout in seconds, 0 for none.
+ *  @param[in] listener    Listener that will receive the result.
+ */
+void native_pool::run(
+                    unsigned long command_id,
+                    check_func func,
+                    std::vector<std::string> const& args,
+                    unsigned int timeout,
+                    command_listener* listener) {
+  job* j(new job);
+  j->args = args;
+  j->cancelled = 0;
+  j->command_id = command_id;
+  j->delivered = false;
+  j->func = func;
+  j->listener = listener;
+  j->start_time = timestamp::now();
+  j->timeout = timeout;
+  j->deadline = timeout
+    ? j->start_time.to_mseconds() + timeout * 1000ull
+    : 0;
+
+  unsigned int max_workers(config->native_check_workers());
+  if (!max_workers)
+    max_workers = 1;
+
+  concurrency::locker lock(&_lock);
+  _waiting.push_back(j);
+  if (!_watchdog) {
+    _watchdog = new worker(*this, &native_pool::_watch);
+    _watchdog->exec();
+  }
+  if ((_waiting.size() > _idle) && (_workers.size() < max_workers)) {
+    worker* w(new worker(*this, &native_pool::_work));
+    _workers.push_back(w);
+    ++_idle;
+    w->exec();
+    logger(dbg_commands, more)
+      << "Native check worker started (" << _workers.size() << "/"
+      << max_workers << ")";
+  }
+  _cv_work.wake_one();
+  _cv_watch.wake_one();
+  return ;
+}
+
+/**
+ *  Get the number of checks currently run by a worker.
+ *
+ *  @return Number of running checks.
+ */
+unsigned int native_pool::running() const {
+  concurrency::locker lock(&_lock);
+  return (_running.size());
+}
+
+/**
+ *  Unload singleton.
+ */
+void native_pool::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Get the number of checks waiting for a worker.
+ *
+ *  @return Number of waiting checks.
+ */
+unsigned int native_pool::waiting() const {
+  concurrency::locker lock(&_lock);
+  return (_waiting.size());
+}
+
+/**
+ *  Get the number of started workers.
+ *
+ *  @return Number of workers.
+ */
+unsigned int native_pool::workers() const {
+  concurrency::locker lock(&_lock);
+  return (_workers.size());
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] pool     Pool that owns this thread.
+ *  @param[in] routine  Pool method run by this thread.
+ */
+native_pool::worker::worker(
+                       native_pool& pool,
+                       void (native_pool::*routine)())
+  : _pool(pool), _routine(routine) {}
+
+/**
+ *  Destructor.
+ */
+native_pool::worker::~worker() throw () {}
+
+/**
+ *  Thread entry point.
+ */
+void native_pool::worker::_run() {
+  (_pool.*_routine)();
+  return ;
+}
+
+/**
+ *  Default constructor.
+ */
+native_pool::native_pool()
+  : _idle(0),
+    _quit(false),
+    _watchdog(NULL) {}
+
+/**
+ *  Destructor. Cancel the running checks and wait for them. Plugins
+ *  are unloaded once no worker can use them anymore.
+ */
+native_pool::~native_pool() throw () {
+  try {
+    {
+      concurrency::locker lock(&_lock);
+      _quit = true;
+      for (std::list<job*>::iterator
+             it(_running.begin()), end(_running.end());
+           it != end;
+           ++it)
+        (*it)->cancelled = 1;
+      _cv_work.wake_all();
+      _cv_watch.wake_all();
+    }
+    for (std::list<worker*>::iterator
+           it(_workers.begin()), end(_workers.end());
+         it != end;
+         ++it) {
+      (*it)->wait();
+      delete *it;
+    }
+    if (_watchdog) {
+      _watchdog->wait();
+      delete _watchdog;
+    }
+    for (std::deque<job*>::iterator
+           it(_waiting.begin()), end(_waiting.end());
+         it != end;
+         ++it)
+      delete *it;
+    _plugins.clear();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: Native check pool destructor failed: " << e.what();
+  }
+}
+
+/**
+ *  Run a check in the current thread.
+ *
+ *  @param[in,out] j    Check to run.
+ *  @param[out]    res  Check result.
+ */
+void native_pool::_execute(job& j, result& res) {
+  std::vector<char const*> argv;
+  argv.reserve(j.args.size() + 1);
+  for (std::vector<std::string>::const_iterator
+         it(j.args.begin()), end(j.args.end());
+       it != end;
+       ++it)
+    argv.push_back(it->c_str());
+  argv.push_back(NULL);
+  std::vector<char> output(output_size, '\0');
+
+  native_check_args args;
+  args.argc = j.args.size();
+  args.argv = &argv[0];
+  args.cancelled = &j.cancelled;
+  args.output = &output[0];
+  args.output_size = output_size;
+  args.timeout = j.timeout;
+
+  res.command_id = j.command_id;
+  res.start_time = timestamp::now();
+  res.exit_code = (j.func)(&args);
+  res.end_time = timestamp::now();
+  res.exit_status = process::normal;
+  output[output_size - 1] = '\0';
+  res.output = &output[0];
+  if ((res.exit_code < -1) || (res.exit_code > 3))
+    res.exit_code = STATE_UNKNOWN;
+  return ;
+}
+
+/**
+ *  Build the result of a check whose timeout expired.
+ *
+ *  @param[in]  j    Timed out check.
+ *  @param[out] res  Check result.
+ */
+void native_pool::_timeout(job const& j, result& res) {
+  res.command_id = j.command_id;
+  res.start_time = j.start_time;
+  res.end_time = timestamp::now();
+  res.exit_code = STATE_UNKNOWN;
+  res.exit_status = process::timeout;
+  res.output = "(Process Timeout)";
+  return ;
+}
+
+/**
+ *  Watchdog thread. Report the checks whose timeout expired, whether
+ *  they are still waiting for a worker or already running.
+ */
+void native_pool::_watch() {
+  concurrency::locker lock(&_lock);
+  while (!_quit) {
+    unsigned long long now(timestamp::now().to_mseconds());
+    unsigned long long next(0);
+    std::list<delivery> expired;
+
+    for (std::deque<job*>::iterator it(_waiting.begin());
+         it != _waiting.end();) {
+      job* j(*it);
+      if (j->deadline && (j->deadline <= now)) {
+        expired.push_back(delivery(j->listener, result()));
+        _timeout(*j, expired.back().second);
+        delete j;
+        it = _waiting.erase(it);
+      }
+      else {
+        if (j->deadline && (!next || (j->deadline < next)))
+          next = j->deadline;
+        ++it;
+      }
+    }
+    for (std::list<job*>::iterator
+           it(_running.begin()), end(_running.end());
+         it != end;
+         ++it) {
+      job* j(*it);
+      if (j->delivered || !j->deadline)
+        continue ;
+      if (j->deadline <= now) {
+        j->cancelled = 1;
+        j->delivered = true;
+        expired.push_back(delivery(j->listener, result()));
+        _timeout(*j, expired.back().second);
+      }
+      else if (!next || (j->deadline < next))
+        next = j->deadline;
+    }
+
+    if (!expired.empty()) {
+      lock.unlock();
+      for (std::list<delivery>::const_iterator
+             it(expired.begin()), end(expired.end());
+           it != end;
+           ++it) {
+        logger(dbg_commands, basic)
+          << "native_pool: check timed out: id="
+          << it->second.command_id;
+        if (it->first)
+          (it->first->finished)(it->second);
+      }
+      lock.relock();
+    }
+    else if (next)
+      _cv_watch.wait(&_lock, next - now);
+    else
+      _cv_watch.wait(&_lock);
+  }
+  return ;
+}
+
+/**
+ *  Worker thread. Run the waiting checks and deliver their result,
+ *  unless the watchdog already reported them as timed out.
+ */
+void native_pool::_work() {
+  concurrency::locker lock(&_lock);
+  for (;;) {
+    while (!_quit && _waiting.empty())
+      _cv_work.wait(&_lock);
+    if (_quit) {
+      --_idle;
+      break ;
+    }
+    job* j(_waiting.front());
+    _waiting.pop_front();
+    _running.push_back(j);
+    --_idle;
+    lock.unlock();
+
+    result res;
+    _execute(*j, res);
+
+    lock.relock();
+    _running.remove(j);
+    bool deliver(!j->delivered);
+    j->delivered = true;
+    ++_idle;
+    lock.unlock();
+
+    if (deliver) {
+      logger(dbg_commands, basic)
+        << "native_pool: check finished: id=" << res.command_id
+        << ", exit_code=" << res.exit_code
+        << ", output='" << res.output << "'";
+      if (j->listener)
+        (j->listener->finished)(res);
+    }
+    else
+      logger(dbg_commands, basic)
+        << "native_pool: late result of timed out check dropped: id="
+        << res.command_id;
+    delete j;
+    lock.relock();
+  }
+  return ;
+}
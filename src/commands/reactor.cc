@@ -0,0 +1,764 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/commands/reactor.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static reactor* _instance = NULL;
+
+// Epoll tags. Child events are tagged with their slot index and kind.
+static unsigned long long const event_tag(~0ull);
+static unsigned int const       kind_out(0);
+static unsigned int const       kind_err(1);
+static unsigned int const       kind_pid(2);
+
+// Timer wheel resolution and size.
+static unsigned int const       tick_msecs(100);
+static unsigned int const       wheel_size(512);
+
+// Stack of the spawned child until it calls execve().
+static unsigned int const       spawn_stack_size(32 * 1024);
+
+/**
+ *  @struct spawn_info
+ *  @brief Data shared with a child until it calls execve().
+ */
+struct                          spawn_info {
+  char* const*                  argv;
+  int                           dev_null;
+  int                           err;
+  int volatile                  error;
+  int                           out;
+  bool                          setpgid;
+};
+
+/**
+ *  Child side of the spawn. It runs in the memory of the engine while
+ *  the parent thread is suspended, so it only makes system calls.
+ *
+ *  @param[in] arg  spawn_info of the child.
+ *
+ *  @return Does not return.
+ */
+static int spawn_child(void* arg) {
+  spawn_info* si(static_cast<spawn_info*>(arg));
+
+  // Signals are blocked by the parent. Handlers of the engine must not
+  // run in the child, reset them before unblocking signals.
+  for (int sig(1); sig < NSIG; ++sig) {
+    struct sigaction sa;
+    if (!sigaction(sig, NULL, &sa)
+        && (sa.sa_handler != SIG_IGN)
+        && (sa.sa_handler != SIG_DFL)) {
+      sa.sa_handler = SIG_DFL;
+      sa.sa_flags = 0;
+      sigaction(sig, &sa, NULL);
+    }
+  }
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigprocmask(SIG_SETMASK, &mask, NULL);
+
+  if ((dup2(si->dev_null, STDIN_FILENO) < 0)
+      || (dup2(si->out, STDOUT_FILENO) < 0)
+      || (dup2(si->err, STDERR_FILENO) < 0)
+      || (si->setpgid && setpgid(0, 0))) {
+    si->error = errno;
+    _exit(127);
+  }
+#ifdef SYS_close_range
+  syscall(SYS_close_range, 3, ~0u, 0);
+#endif // SYS_close_range
+  execve(si->argv[0], si->argv, environ);
+  si->error = errno;
+  _exit(127);
+  return (127);
+}
+
+/**
+ *  Get a file descriptor that becomes readable when a child exits.
+ *
+ *  @param[in] pid  Child process ID.
+ *
+ *  @return pidfd, -1 if the system does not support it.
+ */
+static int open_pidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+  return (syscall(SYS_pidfd_open, pid, 0));
+#else
+  (void)pid;
+  return (-1);
+#endif // SYS_pidfd_open
+}
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Get instance of the reactor singleton.
+ *
+ *  @return This singleton.
+ */
+reactor& reactor::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void reactor::load() {
+  if (!_instance)
+    _instance = new reactor;
+  return ;
+}
+
+/**
+ *  Spawn a child process and watch it.
+ *
+ *  @param[in] command_id  Id of the result.
+ *  @param[in] args        Program path and arguments.
+ *  @param[in] timeout     Timeout in seconds, 0 for none.
+ *  @param[in] listener    Listener that will receive the result.
+ */
+void reactor::run(
+                unsigned long command_id,
+                std::vector<std::string> const& args,
+                unsigned int timeout,
+                command_listener* listener) {
+  if (args.empty())
+    throw (engine_error() << "Cannot execute an empty command line");
+
+  // Build execve() arguments.
+  std::vector<char*> argv;
+  argv.reserve(args.size() + 1);
+  for (std::vector<std::string>::const_iterator
+         it(args.begin()), end(args.end());
+       it != end;
+       ++it)
+    argv.push_back(const_cast<char*>(it->c_str()));
+  argv.push_back(NULL);
+
+  // Create output pipes.
+  int out[2];
+  int err[2];
+  if (pipe2(out, O_CLOEXEC)) {
+    char const* msg(strerror(errno));
+    throw (engine_error() << "Cannot create pipe: " << msg);
+  }
+  if (pipe2(err, O_CLOEXEC)) {
+    char const* msg(strerror(errno));
+    close(out[0]);
+    close(out[1]);
+    throw (engine_error() << "Cannot create pipe: " << msg);
+  }
+
+  // Spawn child. It shares our memory and we are suspended until it
+  // calls execve(), which makes spawning cheap and lets us know if
+  // execve() failed. It does not notify us with SIGCHLD, so that no
+  // one else can reap it.
+  spawn_info si;
+  si.argv = &argv[0];
+  si.dev_null = _dev_null;
+  si.err = err[1];
+  si.error = 0;
+  si.out = out[1];
+  si.setpgid = config->use_setpgid();
+  char stack[spawn_stack_size];
+  sigset_t all;
+  sigset_t old;
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+  pid_t pid(clone(
+              &spawn_child,
+              stack + sizeof(stack),
+              CLONE_VM | CLONE_VFORK,
+              &si));
+  int spawn_error(pid < 0 ? errno : si.error);
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+  close(out[1]);
+  close(err[1]);
+  if (spawn_error) {
+    if (pid > 0) {
+      int status;
+      while ((waitpid(pid, &status, __WALL) < 0) && (errno == EINTR))
+        ;
+    }
+    close(out[0]);
+    close(err[0]);
+    throw (engine_error() << "Cannot execute '" << args[0] << "': "
+           << strerror(spawn_error));
+  }
+  fcntl(out[0], F_SETFL, fcntl(out[0], F_GETFL) | O_NONBLOCK);
+  fcntl(err[0], F_SETFL, fcntl(err[0], F_GETFL) | O_NONBLOCK);
+  int fd_pid(open_pidfd(pid));
+
+  concurrency::locker lock(&_lock);
+
+  // Get a free child slot.
+  child* c;
+  if (_free.empty()) {
+    c = new child;
+    c->index = _children.size();
+    _children.push_back(c);
+  }
+  else {
+    c = _children[_free.back()];
+    _free.pop_back();
+  }
+  c->command_id = command_id;
+  c->deadline = 0;
+  c->exited = false;
+  c->fd_err = err[0];
+  c->fd_out = out[0];
+  c->fd_pid = fd_pid;
+  c->group = si.setpgid;
+  c->listener = listener;
+  c->next = NULL;
+  c->pid = pid;
+  c->prev = NULL;
+  c->slot = 0;
+  c->start_time = timestamp::now();
+  c->status = 0;
+  c->timed_out = false;
+  if (timeout)
+    c->deadline = c->start_time.to_mseconds() + timeout * 1000ull;
+
+  // Watch it.
+  epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = (static_cast<unsigned long long>(c->index) << 2)
+    | kind_out;
+  epoll_ctl(_epoll, EPOLL_CTL_ADD, c->fd_out, &ev);
+  ev.data.u64 = (static_cast<unsigned long long>(c->index) << 2)
+    | kind_err;
+  epoll_ctl(_epoll, EPOLL_CTL_ADD, c->fd_err, &ev);
+  if (c->fd_pid >= 0) {
+    ev.data.u64 = (static_cast<unsigned long long>(c->index) << 2)
+      | kind_pid;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, c->fd_pid, &ev);
+  }
+  else
+    _polling.push_back(c);
+  if (c->deadline)
+    _arm(c);
+  ++_running;
+  ++_spawned;
+
+  logger(dbg_commands, basic)
+    << "reactor::run: id=" << command_id << ", pid=" << pid
+    << ", timeout=" << timeout;
+
+  // The loop only needs to wake up to start ticking.
+  if (_sleeping && (c->deadline || (c->fd_pid < 0)))
+    _wake();
+  return ;
+}
+
+/**
+ *  Get the number of running children.
+ *
+ *  @return Number of children not reaped yet.
+ */
+unsigned int reactor::running() const {
+  concurrency::locker lock(&_lock);
+  return (_running);
+}
+
+/**
+ *  Get the number of children spawned since the reactor started.
+ *
+ *  @return Number of spawned children.
+ */
+unsigned long long reactor::spawned() const {
+  concurrency::locker lock(&_lock);
+  return (_spawned);
+}
+
+/**
+ *  Unload singleton.
+ */
+void reactor::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Get the number of times the reactor thread woke up.
+ *
+ *  @return Number of wakeups.
+ */
+unsigned long long reactor::wakeups() const {
+  concurrency::locker lock(&_lock);
+  return (_wakeups);
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] r  Reactor run by this thread.
+ */
+reactor::loop::loop(reactor& r) : _r(r) {}
+
+/**
+ *  Destructor.
+ */
+reactor::loop::~loop() throw () {}
+
+/**
+ *  Thread entry point.
+ */
+void reactor::loop::_run() {
+  _r._run();
+  return ;
+}
+
+/**
+ *  Default constructor.
+ */
+reactor::reactor()
+  : _dev_null(-1),
+    _epoll(-1),
+    _event(-1),
+    _last_tick(_tick(timestamp::now().to_mseconds())),
+    _loop(*this),
+    _quit(false),
+    _running(0),
+    _spawned(0),
+    _sleeping(false),
+    _timers(0),
+    _wakeups(0),
+    _wheel(wheel_size, static_cast<child*>(NULL)) {
+  _epoll = epoll_create1(EPOLL_CLOEXEC);
+  _event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  _dev_null = open("/dev/null", O_RDONLY | O_CLOEXEC);
+  epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = event_tag;
+  if ((_epoll < 0)
+      || (_event < 0)
+      || (_dev_null < 0)
+      || epoll_ctl(_epoll, EPOLL_CTL_ADD, _event, &ev)) {
+    char const* msg(strerror(errno));
+    if (_epoll >= 0)
+      close(_epoll);
+    if (_event >= 0)
+      close(_event);
+    if (_dev_null >= 0)
+      close(_dev_null);
+    throw (engine_error() << "Cannot create process reactor: " << msg);
+  }
+  _loop.exec();
+}
+
+/**
+ *  Destructor. Stop the reactor thread, then kill and reap the
+ *  children that are still running. Their result is dropped.
+ */
+reactor::~reactor() throw () {
+  try {
+    {
+      concurrency::locker lock(&_lock);
+      _quit = true;
+      _wake();
+    }
+    _loop.wait();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: Process reactor destructor failed: " << e.what();
+  }
+  for (std::vector<child*>::iterator
+         it(_children.begin()), end(_children.end());
+       it != end;
+       ++it) {
+    child* c(*it);
+    if (c->pid > 0) {
+      kill(c->group ? -c->pid : c->pid, SIGKILL);
+      int status;
+      while ((waitpid(c->pid, &status, __WALL) < 0) && (errno == EINTR))
+        ;
+      if (c->fd_out >= 0)
+        close(c->fd_out);
+      if (c->fd_err >= 0)
+        close(c->fd_err);
+      if (c->fd_pid >= 0)
+        close(c->fd_pid);
+    }
+    delete c;
+  }
+  close(_epoll);
+  close(_event);
+  close(_dev_null);
+}
+
+/**
+ *  Add a child to the timer wheel.
+ *
+ *  @param[in] c  Child with a deadline.
+ */
+void reactor::_arm(child* c) {
+  unsigned long long tick(_tick(c->deadline + tick_msecs - 1));
+  if (tick <= _last_tick)
+    tick = _last_tick + 1;
+  c->slot = tick % wheel_size;
+  c->prev = NULL;
+  c->next = _wheel[c->slot];
+  if (c->next)
+    c->next->prev = c;
+  _wheel[c->slot] = c;
+  ++_timers;
+  return ;
+}
+
+/**
+ *  Stop watching a file descriptor of a child and close it.
+ *
+ *  @param[in,out] fd  File descriptor, set to -1.
+ */
+void reactor::_close(int& fd) {
+  epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, NULL);
+  close(fd);
+  fd = -1;
+  return ;
+}
+
+/**
+ *  Build the result of a reaped child, queue it for delivery and
+ *  release its slot.
+ *
+ *  @param[in] c  Reaped child.
+ */
+void reactor::_complete(child* c) {
+  // Get what the child wrote before it exited. Output of background
+  // processes that keep the pipes open is not waited for.
+  if (c->fd_out >= 0) {
+    _read(c->fd_out, c->out);
+    _close(c->fd_out);
+  }
+  if (c->fd_err >= 0) {
+    _read(c->fd_err, c->err);
+    _close(c->fd_err);
+  }
+  if (c->fd_pid >= 0)
+    _close(c->fd_pid);
+  else
+    for (std::vector<child*>::iterator
+           it(_polling.begin()), end(_polling.end());
+         it != end;
+         ++it)
+      if (*it == c) {
+        _polling.erase(it);
+        break ;
+      }
+  if (c->deadline)
+    _disarm(c);
+
+  if (c->listener) {
+    // Find the batch of the listener.
+    batch* b(NULL);
+    for (std::vector<batch>::iterator
+           it(_batches.begin()), end(_batches.end());
+         it != end;
+         ++it)
+      if (it->first == c->listener) {
+        b = &*it;
+        break ;
+      }
+    if (!b) {
+      _batches.push_back(batch(c->listener, std::vector<result>()));
+      b = &_batches.back();
+    }
+
+    // Set result informations.
+    b->second.push_back(result());
+    result& res(b->second.back());
+    res.command_id = c->command_id;
+    res.start_time = c->start_time;
+    res.end_time = timestamp::now();
+    if (c->timed_out) {
+      res.exit_code = STATE_UNKNOWN;
+      res.exit_status = process::timeout;
+      res.output = "(Process Timeout)";
+    }
+    else {
+      res.output = c->out;
+      if ((c->status >= 0) && WIFEXITED(c->status)) {
+        res.exit_code = WEXITSTATUS(c->status);
+        res.exit_status = process::normal;
+        if (res.exit_code > 3)
+          res.exit_code = STATE_UNKNOWN;
+      }
+      else {
+        res.exit_code = STATE_UNKNOWN;
+        res.exit_status = process::crash;
+      }
+    }
+
+    logger(dbg_commands, basic)
+      << "reactor::finished: "
+      "id=" << res.command_id << ", "
+      "pid=" << c->pid << ", "
+      "start_time=" << res.start_time.to_mseconds() << ", "
+      "end_time=" << res.end_time.to_mseconds() << ", "
+      "exit_code=" << res.exit_code << ", "
+      "exit_status=" << res.exit_status << ", "
+      "output='" << res.output << "'";
+  }
+  if (!c->err.empty())
+    logger(dbg_commands, most)
+      << "reactor::finished: id=" << c->command_id
+      << ", error output='" << c->err << "'";
+
+  // Release slot, keeping its buffers.
+  c->err.clear();
+  c->listener = NULL;
+  c->out.clear();
+  c->pid = 0;
+  _free.push_back(c->index);
+  --_running;
+  return ;
+}
+
+/**
+ *  Deliver the queued results, one batch per listener. Must be called
+ *  from the reactor thread without holding the lock.
+ */
+void reactor::_deliver() {
+  for (std::vector<batch>::iterator
+         it(_batches.begin()), end(_batches.end());
+       it != end;
+       ++it)
+    if (!it->second.empty()) {
+      (it->first->finished_batch)(it->second);
+      it->second.clear();
+    }
+  return ;
+}
+
+/**
+ *  Remove a child from the timer wheel.
+ *
+ *  @param[in] c  Armed child.
+ */
+void reactor::_disarm(child* c) {
+  if (c->prev)
+    c->prev->next = c->next;
+  else if (_wheel[c->slot] == c)
+    _wheel[c->slot] = c->next;
+  else
+    return ;
+  if (c->next)
+    c->next->prev = c->prev;
+  c->next = NULL;
+  c->prev = NULL;
+  --_timers;
+  return ;
+}
+
+/**
+ *  Advance the timer wheel, kill the children whose deadline passed
+ *  and poll the children that have no pidfd.
+ *
+ *  @param[in] now  Current time in milliseconds.
+ */
+void reactor::_expire(unsigned long long now) {
+  unsigned long long current(_tick(now));
+  if (current > _last_tick + wheel_size)
+    _last_tick = current - wheel_size;
+  while (_last_tick < current) {
+    ++_last_tick;
+    child* c(_wheel[_last_tick % wheel_size]);
+    while (c) {
+      child* next(c->next);
+      if (_tick(c->deadline + tick_msecs - 1) <= _last_tick) {
+        _disarm(c);
+        c->deadline = 0;
+        c->timed_out = true;
+        kill(c->group ? -c->pid : c->pid, SIGKILL);
+        logger(dbg_commands, basic)
+          << "reactor: process timed out: id=" << c->command_id
+          << ", pid=" << c->pid;
+      }
+      c = next;
+    }
+  }
+
+  for (unsigned int i(_polling.size()); i > 0; --i) {
+    child* c(_polling[i - 1]);
+    _reap(c);
+    if (c->exited)
+      _complete(c);
+  }
+  return ;
+}
+
+/**
+ *  Read all the data available on a pipe.
+ *
+ *  @param[in]     fd      Non-blocking pipe.
+ *  @param[in,out] buffer  Data is appended to this buffer.
+ *
+ *  @return False if the writer closed the pipe.
+ */
+bool reactor::_read(int fd, std::string& buffer) {
+  char data[4096];
+  for (;;) {
+    ssize_t size(::read(fd, data, sizeof(data)));
+    if (size > 0)
+      buffer.append(data, size);
+    else if (!size)
+      return (false);
+    else if (errno != EINTR)
+      return (errno == EAGAIN);
+  }
+}
+
+/**
+ *  Reap a child if it exited.
+ *
+ *  @param[in] c  Child.
+ */
+void reactor::_reap(child* c) {
+  int status;
+  pid_t ret(waitpid(c->pid, &status, WNOHANG | __WALL));
+  if (ret == c->pid) {
+    c->exited = true;
+    c->status = status;
+  }
+  else if ((ret < 0) && (errno != EINTR)) {
+    logger(log_runtime_warning, basic)
+      << "Warning: Cannot get exit status of process " << c->pid
+      << ": " << strerror(errno);
+    c->exited = true;
+    c->status = -1;
+  }
+  return ;
+}
+
+/**
+ *  Reactor thread.
+ */
+void reactor::_run() {
+  epoll_event events[64];
+  concurrency::locker lock(&_lock);
+  while (!_quit) {
+    int timeout(-1);
+    if (_timers || !_polling.empty()) {
+      unsigned long long now(timestamp::now().to_mseconds());
+      unsigned long long next((_last_tick + 1) * tick_msecs);
+      timeout = (next > now) ? next - now : 0;
+    }
+    _sleeping = (timeout < 0);
+    lock.unlock();
+    int count(epoll_wait(
+                _epoll,
+                events,
+                sizeof(events) / sizeof(*events),
+                timeout));
+    lock.relock();
+    _sleeping = false;
+    ++_wakeups;
+
+    for (int i(0); i < count; ++i) {
+      if (events[i].data.u64 == event_tag) {
+        unsigned long long value;
+        while (::read(_event, &value, sizeof(value)) > 0)
+          ;
+        continue ;
+      }
+      child* c(_children[events[i].data.u64 >> 2]);
+      if (!c->pid)
+        continue ;
+      switch (events[i].data.u64 & 3) {
+      case kind_out:
+        if ((c->fd_out >= 0) && !_read(c->fd_out, c->out))
+          _close(c->fd_out);
+        break ;
+      case kind_err:
+        if ((c->fd_err >= 0) && !_read(c->fd_err, c->err))
+          _close(c->fd_err);
+        break ;
+      case kind_pid:
+        _reap(c);
+        if (c->exited)
+          _complete(c);
+        break ;
+      }
+    }
+    _expire(timestamp::now().to_mseconds());
+
+    lock.unlock();
+    _deliver();
+    lock.relock();
+  }
+  return ;
+}
+
+/**
+ *  Convert a time to a timer wheel tick.
+ *
+ *  @param[in] msecs  Time in milliseconds.
+ *
+ *  @return Tick.
+ */
+unsigned long long reactor::_tick(unsigned long long msecs) throw () {
+  return (msecs / tick_msecs);
+}
+
+/**
+ *  Wake the reactor thread up.
+ */
+void reactor::_wake() {
+  unsigned long long value(1);
+  if (::write(_event, &value, sizeof(value)) < 0)
+    logger(log_runtime_warning, basic)
+      << "Warning: Cannot wake process reactor up: " << strerror(errno);
+  return ;
+}
@@ -22,11 +22,14 @@
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
+#include <utility>
+#include <vector>
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
@@ -35,78 +38,154 @@ using namespace com::centreon::engine::logging;
 /**************** CONFIG VERIFICATION FUNCTIONS *****************/
 /****************************************************************/
 
-/* dfs status values */
-#define DFS_UNCHECKED                    0      /* default value */
-#define DFS_TEMP_CHECKED                 1      /* check just one time */
-#define DFS_OK                           2      /* no problem */
-#define DFS_NEAR_LOOP                    3      /* has trouble sons */
-#define DFS_LOOPY                        4      /* is a part of a loop */
-
-#define dfs_get_status(h) h->circular_path_checked
-#define dfs_unset_status(h) h->circular_path_checked = 0
-#define dfs_set_status(h, flag) h->circular_path_checked = (flag)
-#define dfs_host_status(h) (h ? dfs_get_status(h) : DFS_OK)
-
 /**
- * Modified version of Depth-first Search
- * http://en.wikipedia.org/wiki/Depth-first_search
+ *  Get the graph node of an object, creating it if necessary.
+ *
+ *  @param[in,out] nodes  Node id of each object.
+ *  @param[in]     obj    Object.
+ *
+ *  @return Node id of obj.
  */
-static int dfs_host_path(host* root) {
-  hostsmember* child(NULL);
-
-  if (!root)
-    return (DFS_NEAR_LOOP);
-
-  if (dfs_get_status(root) != DFS_UNCHECKED)
-    return (dfs_get_status(root));
-
-  /* Mark the root temporary checked */
-  dfs_set_status(root, DFS_TEMP_CHECKED);
-
-  /* We are scanning the children */
-  for (child = root->child_hosts; child != NULL; child = child->next) {
-    int child_status = dfs_get_status(child->host_ptr);
-
-    /* If a child is not checked, check it */
-    if (child_status == DFS_UNCHECKED)
-      child_status = dfs_host_path(child->host_ptr);
-
-    /* If a child already temporary checked, its a problem,
-     * loop inside, and its a acked status */
-    if (child_status == DFS_TEMP_CHECKED) {
-      dfs_set_status(child->host_ptr, DFS_LOOPY);
-      dfs_set_status(root, DFS_LOOPY);
-    }
+static unsigned int graph_node(
+                      umap<void*, unsigned int>& nodes,
+                      void* obj) {
+  umap<void*, unsigned int>::const_iterator it(nodes.find(obj));
+  if (it != nodes.end())
+    return (it->second);
+  unsigned int id(nodes.size());
+  nodes[obj] = id;
+  return (id);
+}
 
-    /* If a child already temporary checked, its a problem, loop inside */
-    if (child_status == DFS_NEAR_LOOP || child_status == DFS_LOOPY) {
-      /* if a node is know to be part of a loop, do not let it be less */
-      if (dfs_get_status(root) != DFS_LOOPY)
-        dfs_set_status(root, DFS_NEAR_LOOP);
+/**
+ *  Find the strongly connected components of a graph with Tarjan's
+ *  algorithm. Edges are first stored in contiguous adjacency arrays
+ *  and the depth-first search is iterative, so that large and deep
+ *  graphs are processed in linear time without exhausting the stack.
+ *
+ *  @param[in]  nodes      Number of nodes.
+ *  @param[in]  edges      Edges, as (from, to) node pairs.
+ *  @param[out] component  Component of each node.
+ *  @param[out] size       Number of nodes of each component.
+ */
+static void find_components(
+              unsigned int nodes,
+              std::vector<std::pair<unsigned int, unsigned int> > const& edges,
+              std::vector<unsigned int>& component,
+              std::vector<unsigned int>& size) {
+  // Adjacency arrays: successors of node n are
+  // targets[offsets[n]] to targets[offsets[n + 1] - 1].
+  std::vector<unsigned int> offsets(nodes + 1, 0);
+  for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator
+         it(edges.begin()), end(edges.end());
+       it != end;
+       ++it)
+    ++offsets[it->first + 1];
+  for (unsigned int i(0); i < nodes; ++i)
+    offsets[i + 1] += offsets[i];
+  std::vector<unsigned int> targets(edges.size());
+  {
+    std::vector<unsigned int> pos(offsets.begin(), offsets.end() - 1);
+    for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator
+           it(edges.begin()), end(edges.end());
+         it != end;
+         ++it)
+      targets[pos[it->first]++] = it->second;
+  }
 
-      /* we already saw this child, it's a problem */
-      dfs_set_status(child->host_ptr, DFS_LOOPY);
+  // Tarjan's algorithm.
+  static unsigned int const unvisited(static_cast<unsigned int>(-1));
+  std::vector<unsigned int> index(nodes, unvisited);
+  std::vector<unsigned int> lowlink(nodes, 0);
+  std::vector<bool> on_stack(nodes, false);
+  std::vector<unsigned int> stack;
+  std::vector<std::pair<unsigned int, unsigned int> > path;
+  unsigned int counter(0);
+  component.assign(nodes, 0);
+  size.clear();
+  for (unsigned int root(0); root < nodes; ++root) {
+    if (index[root] != unvisited)
+      continue ;
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    on_stack[root] = true;
+    path.push_back(std::make_pair(root, offsets[root]));
+    while (!path.empty()) {
+      unsigned int v(path.back().first);
+      if (path.back().second < offsets[v + 1]) {
+        unsigned int w(targets[path.back().second++]);
+        if (index[w] == unvisited) {
+          index[w] = lowlink[w] = counter++;
+          stack.push_back(w);
+          on_stack[w] = true;
+          path.push_back(std::make_pair(w, offsets[w]));
+        }
+        else if (on_stack[w] && (index[w] < lowlink[v]))
+          lowlink[v] = index[w];
+        continue ;
+      }
+      path.pop_back();
+      if (!path.empty() && (lowlink[v] < lowlink[path.back().first]))
+        lowlink[path.back().first] = lowlink[v];
+      if (lowlink[v] == index[v]) {
+        unsigned int id(size.size());
+        unsigned int count(0);
+        unsigned int w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          component[w] = id;
+          ++count;
+        } while (w != v);
+        size.push_back(count);
+      }
     }
   }
+  return ;
+}
 
-  /*
-   * If root have been modified, do not set it OK
-   * A node is OK if and only if all of his children are OK
-   * If it does not have child, goes ok
-   */
-  if (dfs_get_status(root) == DFS_TEMP_CHECKED)
-    dfs_set_status(root, DFS_OK);
-  return (dfs_get_status(root));
+/**
+ *  Find the dependencies that are part of a circular dependency chain.
+ *  A dependency is circular when its master depends, directly or not,
+ *  on its dependent object through other dependencies.
+ *
+ *  @param[in]  nodes     Number of nodes (dependent and master objects).
+ *  @param[in]  edges     Dependencies, as (dependent, master) pairs.
+ *  @param[out] circular  Whether each dependency is circular.
+ */
+static void find_circular_dependencies(
+              unsigned int nodes,
+              std::vector<std::pair<unsigned int, unsigned int> > const& edges,
+              std::vector<bool>& circular) {
+  std::vector<unsigned int> component;
+  std::vector<unsigned int> size;
+  find_components(nodes, edges, component, size);
+
+  // A dependency of an object on itself is only circular
+  // if another dependency closes the loop.
+  std::vector<unsigned int> self_edges(nodes, 0);
+  for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator
+         it(edges.begin()), end(edges.end());
+       it != end;
+       ++it)
+    if (it->first == it->second)
+      ++self_edges[it->first];
+
+  circular.resize(edges.size());
+  for (unsigned int i(0); i < edges.size(); ++i) {
+    unsigned int dependent(edges[i].first);
+    unsigned int master(edges[i].second);
+    circular[i] = ((component[dependent] == component[master])
+                   && ((dependent != master)
+                       || (size[component[dependent]] > 1)
+                       || (self_edges[dependent] > 1)));
+  }
+  return ;
 }
 
 /* check for circular paths and dependencies */
 int pre_flight_circular_check(int* w, int* e) {
-  host* temp_host(NULL);
-  servicedependency* temp_sd(NULL);
-  servicedependency* temp_sd2(NULL);
-  hostdependency* temp_hd(NULL);
-  hostdependency* temp_hd2(NULL);
-  int found(false);
   int warnings(0);
   int errors(0);
 
@@ -117,33 +196,45 @@ int pre_flight_circular_check(int* w, int* e) {
   /********************************************/
   /* check for circular paths between hosts   */
   /********************************************/
+  {
+    umap<void*, unsigned int> nodes;
+    std::vector<std::pair<unsigned int, unsigned int> > edges;
+    for (host* temp_host(host_list);
+         temp_host != NULL;
+         temp_host = temp_host->next)
+      graph_node(nodes, temp_host);
+    std::vector<bool> self_parent(nodes.size(), false);
+    for (host* temp_host(host_list);
+         temp_host != NULL;
+         temp_host = temp_host->next) {
+      unsigned int parent(nodes[temp_host]);
+      for (hostsmember* child(temp_host->child_hosts);
+           child != NULL;
+           child = child->next) {
+        umap<void*, unsigned int>::const_iterator
+          it(nodes.find(child->host_ptr));
+        if (it == nodes.end())
+          continue ;
+        if (it->second == parent)
+          self_parent[parent] = true;
+        edges.push_back(std::make_pair(parent, it->second));
+      }
+    }
 
-  /* check routes between all hosts */
-  found = false;
-
-  /* We clean the dsf status from previous check */
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
-    dfs_set_status(temp_host, DFS_UNCHECKED);
-  }
-
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
-    if (dfs_host_path(temp_host) == DFS_LOOPY)
-      errors = 1;
-  }
-
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
-    if (dfs_get_status(temp_host) == DFS_LOOPY)
-      logger(log_verification_error, basic)
-        << "Error: The host '" << temp_host->name
-        << "' is part of a circular parent/child chain!";
-    /* clean DFS status */
-    dfs_set_status(temp_host, DFS_UNCHECKED);
+    std::vector<unsigned int> component;
+    std::vector<unsigned int> size;
+    find_components(nodes.size(), edges, component, size);
+    for (host* temp_host(host_list);
+         temp_host != NULL;
+         temp_host = temp_host->next) {
+      unsigned int id(nodes[temp_host]);
+      if ((size[component[id]] > 1) || self_parent[id]) {
+        logger(log_verification_error, basic)
+          << "Error: The host '" << temp_host->name
+          << "' is part of a circular parent/child chain!";
+        errors = 1;
+      }
+    }
   }
 
   /********************************************/
@@ -151,64 +242,68 @@ int pre_flight_circular_check(int* w, int* e) {
   /********************************************/
 
   /* check execution dependencies between all services */
-  for (temp_sd = servicedependency_list;
-       temp_sd != NULL;
-       temp_sd = temp_sd->next) {
-
-    /* clear checked flag for all dependencies */
-    for (temp_sd2 = servicedependency_list;
-	 temp_sd2 != NULL;
-         temp_sd2 = temp_sd2->next)
-      temp_sd2->circular_path_checked = false;
-
-    found = check_for_circular_servicedependency_path(
-              temp_sd,
-              temp_sd);
-    if (found == true) {
-      logger(log_verification_error, basic)
-        << "Error: A circular execution dependency (which could result "
-        "in a deadlock) exists for service '"
-        << temp_sd->service_description << "' on host '"
-        << temp_sd->host_name << "'!";
-      errors++;
+  {
+    umap<void*, unsigned int> nodes;
+    std::vector<std::pair<unsigned int, unsigned int> > edges;
+    for (servicedependency* temp_sd(servicedependency_list);
+         temp_sd != NULL;
+         temp_sd = temp_sd->next)
+      if (temp_sd->dependent_service_ptr && temp_sd->master_service_ptr)
+        edges.push_back(std::make_pair(
+                          graph_node(nodes, temp_sd->dependent_service_ptr),
+                          graph_node(nodes, temp_sd->master_service_ptr)));
+
+    std::vector<bool> circular;
+    find_circular_dependencies(nodes.size(), edges, circular);
+    unsigned int i(0);
+    for (servicedependency* temp_sd(servicedependency_list);
+         temp_sd != NULL;
+         temp_sd = temp_sd->next) {
+      if (!temp_sd->dependent_service_ptr || !temp_sd->master_service_ptr)
+        continue ;
+      if (circular[i++]) {
+        temp_sd->contains_circular_path = true;
+        logger(log_verification_error, basic)
+          << "Error: A circular execution dependency (which could result "
+          "in a deadlock) exists for service '"
+          << temp_sd->service_description << "' on host '"
+          << temp_sd->host_name << "'!";
+        errors++;
+      }
     }
   }
 
-  /* clear checked flag for all dependencies */
-  for (temp_sd = servicedependency_list;
-       temp_sd != NULL;
-       temp_sd = temp_sd->next)
-    temp_sd->circular_path_checked = false;
-
   /* check execution dependencies between all hosts */
-  for (temp_hd = hostdependency_list;
-       temp_hd != NULL;
-       temp_hd = temp_hd->next) {
-
-    /* clear checked flag for all dependencies */
-    for (temp_hd2 = hostdependency_list;
-	 temp_hd2 != NULL;
-         temp_hd2 = temp_hd2->next)
-      temp_hd2->circular_path_checked = false;
-
-    found = check_for_circular_hostdependency_path(
-              temp_hd,
-              temp_hd);
-    if (found == true) {
-      logger(log_verification_error, basic)
-        << "Error: A circular execution dependency (which could "
-        "result in a deadlock) exists for host '"
-        << temp_hd->host_name << "'!";
-      errors++;
+  {
+    umap<void*, unsigned int> nodes;
+    std::vector<std::pair<unsigned int, unsigned int> > edges;
+    for (hostdependency* temp_hd(hostdependency_list);
+         temp_hd != NULL;
+         temp_hd = temp_hd->next)
+      if (temp_hd->dependent_host_ptr && temp_hd->master_host_ptr)
+        edges.push_back(std::make_pair(
+                          graph_node(nodes, temp_hd->dependent_host_ptr),
+                          graph_node(nodes, temp_hd->master_host_ptr)));
+
+    std::vector<bool> circular;
+    find_circular_dependencies(nodes.size(), edges, circular);
+    unsigned int i(0);
+    for (hostdependency* temp_hd(hostdependency_list);
+         temp_hd != NULL;
+         temp_hd = temp_hd->next) {
+      if (!temp_hd->dependent_host_ptr || !temp_hd->master_host_ptr)
+        continue ;
+      if (circular[i++]) {
+        temp_hd->contains_circular_path = true;
+        logger(log_verification_error, basic)
+          << "Error: A circular execution dependency (which could "
+          "result in a deadlock) exists for host '"
+          << temp_hd->host_name << "'!";
+        errors++;
+      }
     }
   }
 
-  /* clear checked flag for all dependencies */
-  for (temp_hd = hostdependency_list;
-       temp_hd != NULL;
-       temp_hd = temp_hd->next)
-    temp_hd->circular_path_checked = false;
-
   /* update warning and error count */
   if (w != NULL)
     *w += warnings;
@@ -492,6 +587,18 @@ int check_servicedependency(servicedependency* sd, int* w, int* e) {
     // Save the timeperiod pointer for later.
     sd->dependency_period_ptr = temp_timeperiod;
   }
+  sd->period_check_time = 0;
+
+  // Link the dependency to its dependent service, once.
+  if (sd->dependent_service_ptr && sd->master_service_ptr) {
+    servicedependency* temp_sd(sd->dependent_service_ptr->dependencies);
+    while (temp_sd && (temp_sd != sd))
+      temp_sd = temp_sd->next_dependency;
+    if (!temp_sd) {
+      sd->next_dependency = sd->dependent_service_ptr->dependencies;
+      sd->dependent_service_ptr->dependencies = sd;
+    }
+  }
 
   // Add errors.
   if (e)
@@ -562,6 +669,18 @@ int check_hostdependency(hostdependency* hd, int* w, int* e) {
     // Save the timeperiod pointer for later.
     hd->dependency_period_ptr = temp_timeperiod;
   }
+  hd->period_check_time = 0;
+
+  // Link the dependency to its dependent host, once.
+  if (hd->dependent_host_ptr && hd->master_host_ptr) {
+    hostdependency* temp_hd(hd->dependent_host_ptr->dependencies);
+    while (temp_hd && (temp_hd != hd))
+      temp_hd = temp_hd->next_dependency;
+    if (!temp_hd) {
+      hd->next_dependency = hd->dependent_host_ptr->dependencies;
+      hd->dependent_host_ptr->dependencies = hd;
+    }
+  }
 
   // Add errors.
   if (e)
@@ -22,6 +22,7 @@
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/connector.hh"
 #include "com/centreon/engine/commands/forward.hh"
+#include "com/centreon/engine/commands/native.hh"
 #include "com/centreon/engine/commands/raw.hh"
 #include "com/centreon/engine/commands/set.hh"
 #include "com/centreon/engine/configuration/applier/command.hh"
@@ -230,8 +231,17 @@ void applier::command::_create_command(
   // Command set.
   commands::set& cmd_set(commands::set::instance());
 
+  // Native command.
+  if (obj->native()) {
+    shared_ptr<commands::command>
+      cmd(new commands::native(
+                          obj->command_name(),
+                          obj->command_line(),
+                          &checks::checker::instance()));
+    cmd_set.add_command(cmd);
+  }
   // Raw command.
-  if (obj->connector().empty()) {
+  else if (obj->connector().empty()) {
     shared_ptr<commands::command>
       cmd(new commands::raw(
                           obj->command_name(),
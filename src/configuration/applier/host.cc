@@ -37,6 +37,125 @@ using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 
+/**
+ *  Remove the child backlinks a host has in its parents.
+ *
+ *  Parent pointers are those set by the last resolution of the host
+ *  (or NULL), so only the hosts that really hold a backlink to this
+ *  host are modified.
+ *
+ *  @param[in,out] hst  Child host.
+ */
+static void unlink_from_parents(host_struct* hst) {
+  for (hostsmember* parent(hst->parent_hosts);
+       parent;
+       parent = parent->next) {
+    if (!parent->host_ptr)
+      continue ;
+    hostsmember** member(&parent->host_ptr->child_hosts);
+    while (*member) {
+      if ((*member)->host_ptr == hst) {
+        hostsmember* to_delete(*member);
+        *member = to_delete->next;
+        deleter::hostsmember(to_delete);
+      }
+      else
+        member = &(*member)->next;
+    }
+  }
+  return ;
+}
+
+/**
+ *  Forget the parent pointers that the children of a host hold on it.
+ *
+ *  @param[in,out] hst  Parent host.
+ */
+static void unlink_from_children(host_struct* hst) {
+  for (hostsmember* child(hst->child_hosts); child; child = child->next)
+    if (child->host_ptr)
+      for (hostsmember* parent(child->host_ptr->parent_hosts);
+           parent;
+           parent = parent->next)
+        if (parent->host_ptr == hst)
+          parent->host_ptr = NULL;
+  return ;
+}
+
+/**
+ *  Create the host object of a configuration host.
+ *
+ *  @param[in] obj  Configuration host.
+ *
+ *  @return New host object, not registered.
+ */
+static shared_ptr<host_struct> create(configuration::host const& obj) {
+  return (create_host(
+           obj.host_id(),
+           obj.host_name().c_str(),
+           NULL_IF_EMPTY(obj.alias()),
+           NULL_IF_EMPTY(obj.address()),
+           NULL_IF_EMPTY(obj.check_period()),
+           obj.initial_state(),
+           obj.check_interval(),
+           obj.retry_interval(),
+           obj.max_check_attempts(),
+           (obj.check_timeout() >= 0) ? obj.check_timeout().get() : 0,
+           NULL_IF_EMPTY(obj.check_command()),
+           obj.checks_active(),
+           NULL_IF_EMPTY(obj.event_handler()),
+           obj.event_handler_enabled(),
+           obj.flap_detection_enabled(),
+           obj.low_flap_threshold(),
+           obj.high_flap_threshold(),
+           static_cast<bool>(obj.flap_detection_options()
+                             & configuration::host::up),
+           static_cast<bool>(obj.flap_detection_options()
+                             & configuration::host::down),
+           static_cast<bool>(obj.flap_detection_options()
+                             & configuration::host::unreachable),
+           obj.check_freshness(),
+           obj.freshness_threshold(),
+           true, // should_be_drawn, enabled by Nagios
+           obj.obsess_over_host(),
+           NULL_IF_EMPTY(obj.timezone())));
+}
+
+/**
+ *  Link a host prepared before the main loop was stopped with its
+ *  parents. Its commands and check period were looked up already.
+ *
+ *  @param[in,out] hst  Host.
+ *
+ *  @return True if the host is resolved, false if it must be resolved
+ *          by check_host().
+ */
+static bool link_prepared(host_struct* hst) {
+  umap<std::string, shared_ptr<host_struct> > const&
+    prepared(applier::state::instance().prepared_hosts());
+  umap<std::string, shared_ptr<host_struct> >::const_iterator
+    it(prepared.find(hst->name));
+  if ((it == prepared.end())
+      || (it->second.get() != hst)
+      || (hst->event_handler && !hst->event_handler_ptr)
+      || (hst->host_check_command && !hst->check_command_ptr)
+      || (hst->check_period && !hst->check_period_ptr)
+      || contains_illegal_object_chars(hst->name))
+    return (false);
+  for (hostsmember* parent(hst->parent_hosts);
+       parent;
+       parent = parent->next)
+    if (!find_host(parent->host_name))
+      return (false);
+  for (hostsmember* parent(hst->parent_hosts);
+       parent;
+       parent = parent->next) {
+    parent->host_ptr = find_host(parent->host_name);
+    add_child_link_to_host(parent->host_ptr, hst);
+  }
+  return (true);
+}
+
 /**
  *  Default constructor.
  */
@@ -82,54 +201,53 @@ void applier::host::add_object(
   // Add host to the global configuration set.
   config->hosts().insert(obj);
 
-  // Create host.
+  // Register host, it was created before the main loop was stopped
+  // unless preparing it failed.
+  umap<std::string, shared_ptr<host_struct> >::const_iterator
+    it_prepared(applier::state::instance().prepared_hosts().find(
+                                                 obj->host_name()));
+  bool prepared(
+         it_prepared != applier::state::instance().prepared_hosts().end());
   host_struct*
-    h(add_host(
-        obj->host_id(),
-        obj->host_name().c_str(),
-        NULL_IF_EMPTY(obj->alias()),
-        NULL_IF_EMPTY(obj->address()),
-        NULL_IF_EMPTY(obj->check_period()),
-        obj->initial_state(),
-        obj->check_interval(),
-        obj->retry_interval(),
-        obj->max_check_attempts(),
-        (obj->check_timeout() >= 0) ? obj->check_timeout().get() : 0,
-        NULL_IF_EMPTY(obj->check_command()),
-        obj->checks_active(),
-        NULL_IF_EMPTY(obj->event_handler()),
-        obj->event_handler_enabled(),
-        obj->flap_detection_enabled(),
-        obj->low_flap_threshold(),
-        obj->high_flap_threshold(),
-        static_cast<bool>(obj->flap_detection_options()
-                          & configuration::host::up),
-        static_cast<bool>(obj->flap_detection_options()
-                          & configuration::host::down),
-        static_cast<bool>(obj->flap_detection_options()
-                          & configuration::host::unreachable),
-        obj->check_freshness(),
-        obj->freshness_threshold(),
-        true, // should_be_drawn, enabled by Nagios
-        obj->obsess_over_host(),
-        NULL_IF_EMPTY(obj->timezone())));
+    h(register_host(prepared ? it_prepared->second : create(*obj)));
   if (!h)
     throw (engine_error() << "Could not register host '"
            << obj->host_name() << "'");
   host_other_props[obj->host_name()].should_reschedule_current_check = false;
 
   // Custom variables.
-  for (map_customvar::const_iterator
-         it(obj->customvariables().begin()),
-         end(obj->customvariables().end());
-       it != end;
-       ++it)
-    if (!add_custom_variable_to_host(
-           h,
-           it->first.c_str(),
-           it->second.c_str()))
-      throw (engine_error() << "Could not add custom variable '"
-             << it->first << "' to host '" << obj->host_name() << "'");
+  if (prepared) {
+    // Already added, only notify the event broker.
+    for (map_customvar::const_iterator
+           it(obj->customvariables().begin()),
+           end(obj->customvariables().end());
+         it != end;
+         ++it) {
+      timeval tv(get_broker_timestamp(NULL));
+      broker_custom_variable(
+        NEBTYPE_HOSTCUSTOMVARIABLE_ADD,
+        NEBFLAG_NONE,
+        NEBATTR_NONE,
+        h,
+        it->first.c_str(),
+        it->second.c_str(),
+        &tv);
+    }
+  }
+  else {
+    for (map_customvar::const_iterator
+           it(obj->customvariables().begin()),
+           end(obj->customvariables().end());
+         it != end;
+         ++it)
+      if (!add_custom_variable_to_host(
+             h,
+             it->first.c_str(),
+             it->second.c_str()))
+        throw (engine_error() << "Could not add custom variable '"
+               << it->first << "' to host '" << obj->host_name() << "'");
+    index_customvariables(h->custom_variables_index, h->custom_variables);
+  }
 
   // Parents.
   for (list_string::const_iterator
@@ -197,7 +315,7 @@ void applier::host::modify_object(
     h->alias,
     (obj->alias().empty() ? obj->host_name() : obj-> alias()).c_str());
   modify_if_different(h->address, NULL_IF_EMPTY(obj->address()));
-  modify_if_different(
+  modify_interned_if_different(
     h->check_period,
     NULL_IF_EMPTY(obj->check_period()));
   modify_if_different(
@@ -215,13 +333,13 @@ void applier::host::modify_object(
   modify_if_different(
     h->check_timeout,
     obj->check_timeout().get());
-  modify_if_different(
+  modify_interned_if_different(
     h->host_check_command,
     NULL_IF_EMPTY(obj->check_command()));
   modify_if_different(
     h->checks_enabled,
     static_cast<int>(obj->checks_active()));
-  modify_if_different(
+  modify_interned_if_different(
     h->event_handler,
     NULL_IF_EMPTY(obj->event_handler()));
   modify_if_different(
@@ -279,11 +397,13 @@ void applier::host::modify_object(
         throw (engine_error()
                << "Could not add custom variable '" << it->first
                << "' to host '" << obj->host_name() << "'");
+    index_customvariables(h->custom_variables_index, h->custom_variables);
   }
 
   // Parents.
   if (obj->parents() != obj_old->parents()) {
-    // Delete old parents.
+    // Delete old parents and the backlinks they hold.
+    unlink_from_parents(h);
     deleter::listmember(h->parent_hosts, &deleter::hostsmember);
 
     // Create parents.
@@ -312,6 +432,54 @@ void applier::host::modify_object(
   return ;
 }
 
+/**
+ *  Create a new host before the main loop is stopped. It is registered
+ *  by add_object() once the main loop is stopped.
+ *
+ *  @param[in] obj      The new host.
+ *  @param[in] resolve  True to look up the commands and check period
+ *                      of the host.
+ */
+void applier::host::prepare_object(
+                      shared_ptr<configuration::host> obj,
+                      bool resolve) {
+  // Errors are reported by add_object().
+  for (map_customvar::const_iterator
+         it(obj->customvariables().begin()),
+         end(obj->customvariables().end());
+       it != end;
+       ++it)
+    if (it->first.empty())
+      return ;
+  shared_ptr<host_struct> h(create(*obj));
+  if (!h)
+    return ;
+
+  // Custom variables, the event broker is notified on registration.
+  for (map_customvar::const_iterator
+         it(obj->customvariables().begin()),
+         end(obj->customvariables().end());
+       it != end;
+       ++it)
+    if (!add_custom_variable_to_object(
+           &h->custom_variables,
+           it->first.c_str(),
+           it->second.c_str()))
+      return ;
+  index_customvariables(h->custom_variables_index, h->custom_variables);
+
+  // Commands and timeperiods cannot change until the main loop is
+  // stopped, the host only has to be linked with its parents then.
+  if (resolve) {
+    h->event_handler_ptr = find_command_of(h->event_handler);
+    h->check_command_ptr = find_command_of(h->host_check_command);
+    h->check_period_ptr = find_timeperiod(h->check_period);
+  }
+
+  applier::state::instance().prepared_hosts()[obj->host_name()] = h;
+  return ;
+}
+
 /**
  *  Remove old host.
  *
@@ -333,7 +501,11 @@ void applier::host::remove_object(
     applier::scheduler::instance().remove_host(*obj);
 
     // Remove host from its list.
-    unregister_object<host_struct>(&host_list, hst);
+    unlink_object<host_struct>(&host_list, hst);
+
+    // Remove links with parents and children.
+    unlink_from_parents(hst);
+    unlink_from_children(hst);
 
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
@@ -369,17 +541,6 @@ void applier::host::resolve_object(
   logger(logging::dbg_config, logging::more)
     << "Resolving host '" << obj->host_name() << "'.";
 
-  // If it is the very first host to be resolved,
-  // remove all the child backlinks of all the hosts.
-  // It is necessary to do it only once to prevent the removal
-  // of valid child backlinks.
-  if (obj == *config->hosts().begin()) {
-    for (umap<std::string, shared_ptr<host_struct> >::iterator
-         it(applier::state::instance().hosts().begin()),
-         end(applier::state::instance().hosts().end()); it != end; ++it)
-      deleter::listmember(it->second->child_hosts, &deleter::hostsmember);
-  }
-
   // Find host.
   umap<std::string, shared_ptr<host_struct> >::iterator
     it(applier::state::instance().hosts_find(obj->key()));
@@ -387,15 +548,23 @@ void applier::host::resolve_object(
     throw (engine_error() << "Cannot resolve non-existing host '"
            << obj->host_name() << "'");
 
+  // Remove child backlinks, they will be added back by check_host().
+  // Only this host is touched so that hosts can be resolved alone.
+  unlink_from_parents(it->second.get());
+
   // Remove service backlinks.
   deleter::listmember(it->second->services, &deleter::servicesmember);
 
+  // Dependencies will be linked again when they are resolved.
+  it->second->dependencies = NULL;
+
   // Reset host counters.
   it->second->total_services = 0;
   it->second->total_service_check_interval = 0;
 
   // Resolve host.
-  if (!check_host(it->second.get(), &config_warnings, &config_errors))
+  if (!link_prepared(it->second.get())
+      && !check_host(it->second.get(), &config_warnings, &config_errors))
     throw (engine_error() << "Cannot resolve host '"
            << obj->host_name() << "'");
 
@@ -205,6 +205,17 @@ void applier::hostdependency::remove_object(
       &hostdependency_list,
       dependency);
 
+    // Remove host dependency from the dependencies of its dependent
+    // host, if this host still exists.
+    umap<std::string, shared_ptr<host_struct> >::iterator
+      hst(applier::state::instance().hosts_find(
+            dependency->dependent_host_name));
+    if ((hst != applier::state::instance().hosts().end())
+        && (hst->second.get() == dependency->dependent_host_ptr))
+      unregister_dependency<hostdependency_struct>(
+        &hst->second->dependencies,
+        dependency);
+
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
     broker_adaptive_dependency_data(
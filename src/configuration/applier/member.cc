@@ -17,11 +17,12 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
-#include <memory>
 #include "com/centreon/engine/configuration/applier/member.hh"
+#include "com/centreon/engine/deleter/commandsmember.hh"
 #include "com/centreon/engine/objects/command.hh"
 #include "com/centreon/engine/objects/commandsmember.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
@@ -50,10 +51,17 @@ void applier::add_member(
   }
 
   // Create and fill the new member.
-  std::auto_ptr<commandsmember_struct> obj(new commandsmember_struct);
-  memset(obj.get(), 0, sizeof(*obj));
-  obj->cmd = string::dup(name);
+  commandsmember_struct*
+    obj(node_pool<commandsmember_struct>::allocate());
+  memset(obj, 0, sizeof(*obj));
+  try {
+    obj->cmd = string::dup(name);
+  }
+  catch (...) {
+    deleter::commandsmember(obj);
+    throw ;
+  }
   obj->command_ptr = &(*it->second);
   obj->next = members;
-  members = obj.release();
+  members = obj;
 }
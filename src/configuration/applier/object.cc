@@ -21,11 +21,27 @@
 #include <string>
 #include <vector>
 #include "com/centreon/engine/configuration/applier/object.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 
+command_struct* applier::find_command_of(char const* command_line) {
+  if (!command_line)
+    return (NULL);
+  char const* end(strchr(command_line, '!'));
+  std::string name(
+                command_line,
+                end ? end - command_line : strlen(command_line));
+  umap<std::string, shared_ptr<command_struct> >::const_iterator
+    it(applier::state::instance().commands().find(name));
+  if (it == applier::state::instance().commands().end())
+    return (NULL);
+  return (it->second.get());
+}
+
 void applier::modify_if_different(char*& s1, char const* s2) {
   if (s1 != s2) {
     if (!s2) {
@@ -38,6 +54,18 @@ void applier::modify_if_different(char*& s1, char const* s2) {
   return ;
 }
 
+void applier::modify_interned_if_different(
+                char*& s1,
+                char const* s2) {
+  if (s1 != s2) {
+    if (!s2)
+      string::release(s1);
+    else if (!s1 || strcmp(s1, s2))
+      string::setintern(s1, s2);
+  }
+  return ;
+}
+
 void applier::modify_if_different(
                 char** t1,
                 std::vector<std::string> const& t2,
@@ -0,0 +1,814 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/configuration/applier/reference_index.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Get the command name of a command line.
+ *
+ *  @param[in] cmd  Command with its arguments ("name!arg1!arg2").
+ *
+ *  @return Command name.
+ */
+static std::string command_name(std::string const& cmd) {
+  return (cmd.substr(0, cmd.find('!')));
+}
+
+/**
+ *  Add or remove a user of a referenced object.
+ *
+ *  @param[in,out] index   Users of the referenced objects.
+ *  @param[in]     key     Key of the referenced object.
+ *  @param[in]     member  Set of users to update.
+ *  @param[in]     user    User to add or remove.
+ *  @param[in]     add     True to add the user, false to remove it.
+ */
+template <typename K, typename U>
+static void reference(
+              umap<K, applier::reference_index::users>& index,
+              K const& key,
+              std::set<U> applier::reference_index::users::* member,
+              U const& user,
+              bool add) {
+  if (add)
+    (index[key].*member).insert(user);
+  else {
+    typename umap<K, applier::reference_index::users>::iterator
+      it(index.find(key));
+    if (it != index.end()) {
+      (it->second.*member).erase(user);
+      if (it->second.empty())
+        index.erase(it);
+    }
+  }
+  return ;
+}
+
+/**
+ *  Find the users of an object.
+ *
+ *  @param[in] index  Users of the referenced objects.
+ *  @param[in] key    Key of the referenced object.
+ *
+ *  @return Users of the object, NULL if it is not referenced.
+ */
+template <typename K>
+static applier::reference_index::users const* find_users(
+        umap<K, applier::reference_index::users> const& index,
+        K const& key) {
+  typename umap<K, applier::reference_index::users>::const_iterator
+    it(index.find(key));
+  return ((it != index.end()) ? &it->second : NULL);
+}
+
+/**
+ *  Add the keys of objects to a set of keys.
+ *
+ *  @param[in]  objects  Configuration objects.
+ *  @param[out] keys     Keys of the objects.
+ */
+template <typename T>
+static void add_keys(
+              std::set<shared_ptr<T> > const& objects,
+              std::set<typename T::key_type>& keys) {
+  for (typename std::set<shared_ptr<T> >::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it)
+    keys.insert((*it)->key());
+  return ;
+}
+
+/**
+ *  Add the users of objects to a set of users.
+ *
+ *  @param[in]  index    Reference index.
+ *  @param[in]  objects  Configuration objects.
+ *  @param[in]  find     Method finding the users of an object.
+ *  @param[out] users    Users of the objects.
+ */
+template <typename T>
+static void add_users(
+              applier::reference_index const& index,
+              std::set<shared_ptr<T> > const& objects,
+              applier::reference_index::users const*
+                (applier::reference_index::* find)(
+                  typename T::key_type const&) const,
+              applier::reference_index::users& users) {
+  for (typename std::set<shared_ptr<T> >::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it) {
+    applier::reference_index::users const*
+      u((index.*find)((*it)->key()));
+    if (u)
+      users.merge(*u);
+  }
+  return ;
+}
+
+/**
+ *  Get the objects of the new configuration matching some keys.
+ *
+ *  @param[in]  keys     Object keys.
+ *  @param[in]  objects  New configuration objects.
+ *  @param[in]  new_cfg  New configuration.
+ *  @param[in]  find     Method finding a new object.
+ *  @param[out] found    Objects found.
+ */
+template <typename T>
+static void find_objects(
+              std::set<typename T::key_type> const& keys,
+              std::set<shared_ptr<T> > const& objects,
+              configuration::state const& new_cfg,
+              typename std::set<shared_ptr<T> >::const_iterator
+                (configuration::state::* find)(
+                  typename T::key_type const&) const,
+              std::set<shared_ptr<T> >& found) {
+  for (typename std::set<typename T::key_type>::const_iterator
+         it(keys.begin()), end(keys.end());
+       it != end;
+       ++it) {
+    typename std::set<shared_ptr<T> >::const_iterator
+      obj((new_cfg.*find)(*it));
+    if (obj != objects.end())
+      found.insert(*obj);
+  }
+  return ;
+}
+
+/**
+ *  Get the objects that still exist in the new configuration.
+ *
+ *  @param[in]  candidates  Objects of the current or new configuration.
+ *  @param[in]  objects     New configuration objects.
+ *  @param[out] found       Objects found.
+ */
+template <typename T>
+static void keep_objects(
+              std::set<shared_ptr<T> > const& candidates,
+              std::set<shared_ptr<T> > const& objects,
+              std::set<shared_ptr<T> >& found) {
+  for (typename std::set<shared_ptr<T> >::const_iterator
+         it(candidates.begin()), end(candidates.end());
+       it != end;
+       ++it) {
+    typename std::set<shared_ptr<T> >::const_iterator
+      obj(objects.find(*it));
+    if (obj != objects.end())
+      found.insert(*obj);
+  }
+  return ;
+}
+
+/**
+ *  Check whether an object has no user.
+ *
+ *  @return True if no object refers to this object.
+ */
+bool applier::reference_index::users::empty() const throw () {
+  return (commands.empty()
+          && hostdependencies.empty()
+          && hosts.empty()
+          && servicedependencies.empty()
+          && services.empty()
+          && timeperiods.empty());
+}
+
+/**
+ *  Add the users of another object to this set of users.
+ *
+ *  @param[in] other  Users to add.
+ */
+void applier::reference_index::users::merge(users const& other) {
+  commands.insert(other.commands.begin(), other.commands.end());
+  hostdependencies.insert(
+    other.hostdependencies.begin(),
+    other.hostdependencies.end());
+  hosts.insert(other.hosts.begin(), other.hosts.end());
+  servicedependencies.insert(
+    other.servicedependencies.begin(),
+    other.servicedependencies.end());
+  services.insert(other.services.begin(), other.services.end());
+  timeperiods.insert(other.timeperiods.begin(), other.timeperiods.end());
+  return ;
+}
+
+/**
+ *  Default constructor.
+ */
+applier::reference_index::reference_index() {}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] right  Object to copy.
+ */
+applier::reference_index::reference_index(reference_index const& right)
+  : _commands(right._commands),
+    _connectors(right._connectors),
+    _hosts(right._hosts),
+    _services(right._services),
+    _timeperiods(right._timeperiods) {}
+
+/**
+ *  Destructor.
+ */
+applier::reference_index::~reference_index() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] right  Object to copy.
+ *
+ *  @return This object.
+ */
+applier::reference_index& applier::reference_index::operator=(
+                            reference_index const& right) {
+  if (this != &right) {
+    _commands = right._commands;
+    _connectors = right._connectors;
+    _hosts = right._hosts;
+    _services = right._services;
+    _timeperiods = right._timeperiods;
+  }
+  return (*this);
+}
+
+/**
+ *  Record the references made by a command.
+ *
+ *  @param[in] obj  Command configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::command> const& obj) {
+  _update(*obj, true);
+  return ;
+}
+
+/**
+ *  Record the references made by a host.
+ *
+ *  @param[in] obj  Host configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::host> const& obj) {
+  _update(*obj, true);
+  return ;
+}
+
+/**
+ *  Record the references made by a host dependency.
+ *
+ *  @param[in] obj  Host dependency configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::hostdependency> const& obj) {
+  _update(obj, true);
+  return ;
+}
+
+/**
+ *  Record the references made by a service.
+ *
+ *  @param[in] obj  Service configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::service> const& obj) {
+  _update(*obj, true);
+  return ;
+}
+
+/**
+ *  Record the references made by a service dependency.
+ *
+ *  @param[in] obj  Service dependency configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::servicedependency> const& obj) {
+  _update(obj, true);
+  return ;
+}
+
+/**
+ *  Record the references made by a time period.
+ *
+ *  @param[in] obj  Time period configuration.
+ */
+void applier::reference_index::add(
+       shared_ptr<configuration::timeperiod> const& obj) {
+  _update(*obj, true);
+  return ;
+}
+
+/**
+ *  Forget all references.
+ */
+void applier::reference_index::clear() {
+  _commands.clear();
+  _connectors.clear();
+  _hosts.clear();
+  _services.clear();
+  _timeperiods.clear();
+  return ;
+}
+
+/**
+ *  Get the objects referring to a command.
+ *
+ *  @param[in] k  Command name.
+ *
+ *  @return Users of the command, NULL if it is not referenced.
+ */
+applier::reference_index::users const*
+  applier::reference_index::command_users(
+    configuration::command::key_type const& k) const {
+  return (find_users(_commands, k));
+}
+
+/**
+ *  Get the objects referring to a connector.
+ *
+ *  @param[in] name  Connector name.
+ *
+ *  @return Users of the connector, NULL if it is not referenced.
+ */
+applier::reference_index::users const*
+  applier::reference_index::connector_users(std::string const& name) const {
+  return (find_users(_connectors, name));
+}
+
+/**
+ *  Get the objects referring to a host.
+ *
+ *  @param[in] k  Host name.
+ *
+ *  @return Users of the host, NULL if it is not referenced.
+ */
+applier::reference_index::users const*
+  applier::reference_index::host_users(
+    configuration::host::key_type const& k) const {
+  return (find_users(_hosts, k));
+}
+
+/**
+ *  Forget the references made by a command.
+ *
+ *  @param[in] obj  Command configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::command> const& obj) {
+  _update(*obj, false);
+  return ;
+}
+
+/**
+ *  Forget the references made by a host.
+ *
+ *  @param[in] obj  Host configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::host> const& obj) {
+  _update(*obj, false);
+  return ;
+}
+
+/**
+ *  Forget the references made by a host dependency.
+ *
+ *  @param[in] obj  Host dependency configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::hostdependency> const& obj) {
+  _update(obj, false);
+  return ;
+}
+
+/**
+ *  Forget the references made by a service.
+ *
+ *  @param[in] obj  Service configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::service> const& obj) {
+  _update(*obj, false);
+  return ;
+}
+
+/**
+ *  Forget the references made by a service dependency.
+ *
+ *  @param[in] obj  Service dependency configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::servicedependency> const& obj) {
+  _update(obj, false);
+  return ;
+}
+
+/**
+ *  Forget the references made by a time period.
+ *
+ *  @param[in] obj  Time period configuration.
+ */
+void applier::reference_index::remove(
+       shared_ptr<configuration::timeperiod> const& obj) {
+  _update(*obj, false);
+  return ;
+}
+
+/**
+ *  @brief Select the objects to resolve on reload.
+ *
+ *  Added and modified objects are resolved again, along with the
+ *  users of objects that were added or removed: their pointers to
+ *  these objects are either missing or dangling. Users of modified
+ *  objects are left alone, objects being modified in place. Resolving
+ *  a host rebuilds its service and dependency backlinks, so all its
+ *  services and dependencies are resolved with it, and so on for
+ *  services and their dependencies.
+ *
+ *  The index describes the current configuration. Unchanged
+ *  objects refer to the same objects in both configurations and the
+ *  others are resolved anyway, so it is enough to find the users of
+ *  the new objects. Users that do not exist anymore are ignored.
+ *
+ *  @param[in]  new_cfg  New configuration.
+ *  @param[in]  diff_*   Changes of each object type.
+ *  @param[out] changed  Objects to resolve.
+ */
+void applier::reference_index::select_changes(
+       configuration::state const& new_cfg,
+       difference<set_timeperiod> const& diff_timeperiods,
+       difference<set_connector> const& diff_connectors,
+       difference<set_command> const& diff_commands,
+       difference<set_host> const& diff_hosts,
+       difference<set_service> const& diff_services,
+       difference<set_hostdependency> const& diff_hostdependencies,
+       difference<set_servicedependency> const& diff_servicedependencies,
+       configuration::state& changed) const {
+  typedef applier::reference_index ri;
+
+  // Changed objects and users of added or removed objects.
+  ri::users users;
+  add_keys(diff_timeperiods.added(), users.timeperiods);
+  add_keys(diff_timeperiods.modified(), users.timeperiods);
+  add_users(*this, diff_timeperiods.added(), &ri::timeperiod_users, users);
+  add_users(*this, diff_timeperiods.deleted(), &ri::timeperiod_users, users);
+  add_users(*this, diff_connectors.added(), &ri::connector_users, users);
+  add_users(*this, diff_connectors.deleted(), &ri::connector_users, users);
+  add_keys(diff_commands.added(), users.commands);
+  add_keys(diff_commands.modified(), users.commands);
+  add_users(*this, diff_commands.added(), &ri::command_users, users);
+  add_users(*this, diff_commands.deleted(), &ri::command_users, users);
+  add_keys(diff_hosts.added(), users.hosts);
+  add_keys(diff_hosts.modified(), users.hosts);
+  add_users(*this, diff_hosts.added(), &ri::host_users, users);
+  add_users(*this, diff_hosts.deleted(), &ri::host_users, users);
+  add_keys(diff_services.added(), users.services);
+  add_keys(diff_services.modified(), users.services);
+  add_users(*this, diff_services.added(), &ri::service_users, users);
+  add_users(*this, diff_services.deleted(), &ri::service_users, users);
+
+  // Hosts that lost services, dependent objects of new or removed
+  // dependencies.
+  for (set_service::const_iterator
+         it(diff_services.deleted().begin()),
+         end(diff_services.deleted().end());
+       it != end;
+       ++it)
+    users.hosts.insert((*it)->key().first);
+  users.hostdependencies.insert(
+    diff_hostdependencies.added().begin(),
+    diff_hostdependencies.added().end());
+  for (unsigned int i(0); i < 2; ++i) {
+    set_hostdependency const&
+      deps(i ? diff_hostdependencies.added()
+             : diff_hostdependencies.deleted());
+    for (set_hostdependency::const_iterator
+           it(deps.begin()), end(deps.end());
+         it != end;
+         ++it)
+      if (!(*it)->dependent_hosts().empty())
+        users.hosts.insert((*it)->dependent_hosts().front());
+  }
+  users.servicedependencies.insert(
+    diff_servicedependencies.added().begin(),
+    diff_servicedependencies.added().end());
+  for (unsigned int i(0); i < 2; ++i) {
+    set_servicedependency const&
+      deps(i ? diff_servicedependencies.added()
+             : diff_servicedependencies.deleted());
+    for (set_servicedependency::const_iterator
+           it(deps.begin()), end(deps.end());
+         it != end;
+         ++it)
+      if (!(*it)->dependent_hosts().empty()
+          && !(*it)->dependent_service_description().empty())
+        users.services.insert(std::make_pair(
+                                (*it)->dependent_hosts().front(),
+                                (*it)->dependent_service_description().front()));
+  }
+
+  // Hosts of services, services and dependencies of hosts.
+  for (std::set<configuration::service::key_type>::const_iterator
+         it(users.services.begin()), end(users.services.end());
+       it != end;
+       ++it)
+    users.hosts.insert(it->first);
+  for (set_string::const_iterator
+         it(users.hosts.begin()), end(users.hosts.end());
+       it != end;
+       ++it) {
+    ri::users const* u(host_users(*it));
+    if (u) {
+      users.services.insert(u->services.begin(), u->services.end());
+      users.hostdependencies.insert(
+        u->hostdependencies.begin(),
+        u->hostdependencies.end());
+    }
+  }
+  for (std::set<configuration::service::key_type>::const_iterator
+         it(users.services.begin()), end(users.services.end());
+       it != end;
+       ++it) {
+    ri::users const* u(service_users(*it));
+    if (u)
+      users.servicedependencies.insert(
+        u->servicedependencies.begin(),
+        u->servicedependencies.end());
+  }
+
+  // Get the configuration objects.
+  find_objects(
+    users.timeperiods,
+    new_cfg.timeperiods(),
+    new_cfg,
+    &configuration::state::timeperiods_find,
+    changed.timeperiods());
+  changed.connectors().insert(
+    diff_connectors.added().begin(),
+    diff_connectors.added().end());
+  changed.connectors().insert(
+    diff_connectors.modified().begin(),
+    diff_connectors.modified().end());
+  find_objects(
+    users.commands,
+    new_cfg.commands(),
+    new_cfg,
+    &configuration::state::commands_find,
+    changed.commands());
+  find_objects(
+    users.hosts,
+    new_cfg.hosts(),
+    new_cfg,
+    &configuration::state::hosts_find,
+    changed.hosts());
+  find_objects(
+    users.services,
+    new_cfg.services(),
+    new_cfg,
+    &configuration::state::services_find,
+    changed.services());
+  keep_objects(
+    users.hostdependencies,
+    new_cfg.hostdependencies(),
+    changed.hostdependencies());
+  keep_objects(
+    users.servicedependencies,
+    new_cfg.servicedependencies(),
+    changed.servicedependencies());
+  return ;
+}
+
+/**
+ *  Get the objects referring to a service.
+ *
+ *  @param[in] k  Service key (host name, description).
+ *
+ *  @return Users of the service, NULL if it is not referenced.
+ */
+applier::reference_index::users const*
+  applier::reference_index::service_users(
+    configuration::service::key_type const& k) const {
+  return (find_users(_services, k));
+}
+
+/**
+ *  Get the objects referring to a time period.
+ *
+ *  @param[in] k  Time period name.
+ *
+ *  @return Users of the time period, NULL if it is not referenced.
+ */
+applier::reference_index::users const*
+  applier::reference_index::timeperiod_users(
+    configuration::timeperiod::key_type const& k) const {
+  return (find_users(_timeperiods, k));
+}
+
+/**
+ *  Update the references made by a command.
+ *
+ *  @param[in] obj  Command configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       configuration::command const& obj,
+       bool add) {
+  if (!obj.connector().empty())
+    reference(
+      _connectors,
+      obj.connector(),
+      &users::commands,
+      obj.command_name(),
+      add);
+  return ;
+}
+
+/**
+ *  Update the references made by a host.
+ *
+ *  @param[in] obj  Host configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       configuration::host const& obj,
+       bool add) {
+  if (!obj.check_command().empty())
+    reference(
+      _commands,
+      command_name(obj.check_command()),
+      &users::hosts,
+      obj.host_name(),
+      add);
+  if (!obj.event_handler().empty())
+    reference(
+      _commands,
+      command_name(obj.event_handler()),
+      &users::hosts,
+      obj.host_name(),
+      add);
+  if (!obj.check_period().empty())
+    reference(
+      _timeperiods,
+      obj.check_period(),
+      &users::hosts,
+      obj.host_name(),
+      add);
+  for (list_string::const_iterator
+         it(obj.parents().begin()), end(obj.parents().end());
+       it != end;
+       ++it)
+    reference(_hosts, *it, &users::hosts, obj.host_name(), add);
+  return ;
+}
+
+/**
+ *  Update the references made by a host dependency.
+ *
+ *  @param[in] obj  Host dependency configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       shared_ptr<configuration::hostdependency> const& obj,
+       bool add) {
+  if (!obj->dependent_hosts().empty())
+    reference(
+      _hosts,
+      obj->dependent_hosts().front(),
+      &users::hostdependencies,
+      obj,
+      add);
+  if (!obj->hosts().empty())
+    reference(
+      _hosts,
+      obj->hosts().front(),
+      &users::hostdependencies,
+      obj,
+      add);
+  if (!obj->dependency_period().empty())
+    reference(
+      _timeperiods,
+      obj->dependency_period(),
+      &users::hostdependencies,
+      obj,
+      add);
+  return ;
+}
+
+/**
+ *  Update the references made by a service.
+ *
+ *  @param[in] obj  Service configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       configuration::service const& obj,
+       bool add) {
+  configuration::service::key_type k(obj.key());
+  if (!k.first.empty())
+    reference(_hosts, k.first, &users::services, k, add);
+  if (!obj.check_command().empty())
+    reference(
+      _commands,
+      command_name(obj.check_command()),
+      &users::services,
+      k,
+      add);
+  if (!obj.event_handler().empty())
+    reference(
+      _commands,
+      command_name(obj.event_handler()),
+      &users::services,
+      k,
+      add);
+  if (!obj.check_period().empty())
+    reference(
+      _timeperiods,
+      obj.check_period(),
+      &users::services,
+      k,
+      add);
+  return ;
+}
+
+/**
+ *  Update the references made by a service dependency.
+ *
+ *  @param[in] obj  Service dependency configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       shared_ptr<configuration::servicedependency> const& obj,
+       bool add) {
+  if (!obj->dependent_hosts().empty()
+      && !obj->dependent_service_description().empty())
+    reference(
+      _services,
+      std::make_pair(
+             obj->dependent_hosts().front(),
+             obj->dependent_service_description().front()),
+      &users::servicedependencies,
+      obj,
+      add);
+  if (!obj->hosts().empty() && !obj->service_description().empty())
+    reference(
+      _services,
+      std::make_pair(
+             obj->hosts().front(),
+             obj->service_description().front()),
+      &users::servicedependencies,
+      obj,
+      add);
+  if (!obj->dependency_period().empty())
+    reference(
+      _timeperiods,
+      obj->dependency_period(),
+      &users::servicedependencies,
+      obj,
+      add);
+  return ;
+}
+
+/**
+ *  Update the references made by a time period.
+ *
+ *  @param[in] obj  Time period configuration.
+ *  @param[in] add  True to add the references, false to remove them.
+ */
+void applier::reference_index::_update(
+       configuration::timeperiod const& obj,
+       bool add) {
+  for (list_string::const_iterator
+         it(obj.exclude().begin()), end(obj.exclude().end());
+       it != end;
+       ++it)
+    reference(
+      _timeperiods,
+      *it,
+      &users::timeperiods,
+      obj.timeperiod_name(),
+      add);
+  return ;
+}
@@ -29,6 +29,7 @@
 #include "com/centreon/engine/events/hash_timed_event.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/logging/logger.hh"
 
@@ -37,6 +38,13 @@ using namespace com::centreon::engine::configuration;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::logging;
 
+// Seconds of projected check load kept by the scheduler.
+static unsigned int const load_horizon(4096);
+// Fraction of its interval a check can be delayed to lower the load.
+static double const       load_spread_ratio(0.1);
+// Projected load of a check that did not run yet.
+static double const       projected_check_overhead(0.1);
+
 static applier::scheduler* _instance(NULL);
 
 /**
@@ -218,6 +226,67 @@ void applier::scheduler::remove_service(
   return ;
 }
 
+/**
+ *  Choose the start time of a check so that the projected load of
+ *  concurrent checks stays flat. The check can be delayed by a
+ *  fraction of its interval, its average execution time is then
+ *  recorded in the projected load.
+ *
+ *  @param[in] last_check      Last check time.
+ *  @param[in] preferred       Preferred next check time.
+ *  @param[in] execution_time  Average execution time of the check.
+ *
+ *  @return Next check time.
+ */
+time_t applier::scheduler::spread_check(
+                             time_t last_check,
+                             time_t preferred,
+                             double execution_time) {
+  if (!config->use_load_aware_scheduling())
+    return (preferred);
+
+  // Seconds during which the check runs.
+  time_t const max_length(_load.size() / 4);
+  time_t length(static_cast<time_t>(ceil(execution_time)));
+  if (length < 1)
+    length = 1;
+  else if (length > max_length)
+    length = max_length;
+
+  // Allowed delay.
+  time_t slack(0);
+  if (preferred > last_check)
+    slack = static_cast<time_t>(
+              (preferred - last_check) * load_spread_ratio);
+  if (slack > max_length)
+    slack = max_length;
+
+  // Checks beyond the horizon are not projected.
+  if (preferred + slack + length
+      >= time(NULL) + static_cast<time_t>(_load.size()))
+    return (preferred);
+
+  // Find the start time with the lowest projected load.
+  double load(0.0);
+  for (time_t i(0); i < length; ++i)
+    load += _get_load(preferred + i);
+  time_t best(preferred);
+  double best_load(load);
+  for (time_t t(preferred + 1); t <= preferred + slack; ++t) {
+    load += _get_load(t + length - 1) - _get_load(t - 1);
+    if (load < best_load - 0.000001) {
+      best = t;
+      best_load = load;
+    }
+  }
+  _add_load(best, execution_time);
+  if (best != preferred)
+    logger(dbg_checks, most)
+      << "Check delayed by " << best - preferred
+      << " second(s) to lower the projected load";
+  return (best);
+}
+
 /**
  *  Unload scheduler applier singleton.
  */
@@ -237,6 +306,7 @@ applier::scheduler::scheduler()
     _evt_retention_save(NULL),
     _evt_sfreshness_check(NULL),
     _evt_status_save(NULL),
+    _load(load_horizon),
     _old_check_reaper_interval(0),
     _old_command_check_interval(0),
     _old_host_freshness_check_interval(0),
@@ -250,6 +320,30 @@ applier::scheduler::scheduler()
  */
 applier::scheduler::~scheduler() throw () {}
 
+/**
+ *  Record the projected load of a check.
+ *
+ *  @param[in] start           Check start time.
+ *  @param[in] execution_time  Average execution time of the check.
+ */
+void applier::scheduler::_add_load(time_t start, double execution_time) {
+  double remaining(execution_time > projected_check_overhead
+                   ? execution_time
+                   : projected_check_overhead);
+  time_t const end(start + _load.size() / 4);
+  for (time_t t(start); (remaining > 0.0) && (t < end); ++t) {
+    load_slot& slot(_load[t % _load.size()]);
+    if (slot.time != t) {
+      slot.time = t;
+      slot.load = 0.0;
+    }
+    double part(remaining < 1.0 ? remaining : 1.0);
+    slot.load += part;
+    remaining -= part;
+  }
+  return ;
+}
+
 /**
  *  Remove and create misc event if necessary.
  */
@@ -386,12 +480,10 @@ void applier::scheduler::_calculate_host_scheduling_params() {
 
   // Get total hosts, total scheduled hosts and host check spread.
   double host_check_spread(std::numeric_limits<double>::max());
-  for (umap<std::string, shared_ptr<host_struct> >::const_iterator
-         it(applier::state::instance().hosts().begin()),
-         end(applier::state::instance().hosts().end());
-         it != end;
-         ++it) {
-    host_struct& hst(*it->second);
+  for (unsigned int i(0), end(scheduling_table<host_struct>::size());
+       i < end;
+       ++i) {
+    host_struct& hst(*scheduling_table<host_struct>::at(i));
 
     bool schedule_check(true);
     if ((hst.check_interval <= 0) || !hst.checks_enabled)
@@ -510,12 +602,10 @@ void applier::scheduler::_calculate_service_scheduling_params() {
   // Get total services, total scheduled services
   // and service check spread.
   double service_check_spread(std::numeric_limits<double>::max());
-  for (umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
-         it(applier::state::instance().services().begin()),
-         end(applier::state::instance().services().end());
-       it != end;
-       ++it) {
-    service_struct& svc(*it->second);
+  for (unsigned int i(0), end(scheduling_table<service_struct>::size());
+       i < end;
+       ++i) {
+    service_struct& svc(*scheduling_table<service_struct>::at(i));
 
     bool schedule_check(true);
     if ((svc.check_interval <= 0.0) || !svc.checks_enabled)
@@ -616,6 +706,18 @@ timed_event* applier::scheduler::_create_misc_event(
                     0));
 }
 
+/**
+ *  Get the projected check load of one second.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Projected load.
+ */
+double applier::scheduler::_get_load(time_t t) const throw () {
+  load_slot const& slot(_load[t % _load.size()]);
+  return ((slot.time == t) ? slot.load : 0.0);
+}
+
 /**
  *  Get engine hosts struct with configuration hosts objects.
  *
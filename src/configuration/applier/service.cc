@@ -33,6 +33,77 @@ using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 
+/**
+ *  Create the service object of a configuration service.
+ *
+ *  @param[in] obj  Configuration service with a single host.
+ *
+ *  @return New service object, not registered.
+ */
+static shared_ptr<service_struct> create(
+                                    configuration::service const& obj) {
+  // XXX: Manage host_id.
+  return (create_service(
+           0,
+           obj.hosts().front().c_str(),
+           obj.service_id(),
+           obj.service_description().c_str(),
+           NULL_IF_EMPTY(obj.check_period()),
+           obj.initial_state(),
+           obj.max_check_attempts(),
+           (obj.check_timeout() >= 0) ? obj.check_timeout().get() : 0,
+           obj.check_interval(),
+           obj.retry_interval(),
+           obj.is_volatile(),
+           NULL_IF_EMPTY(obj.event_handler()),
+           obj.event_handler_enabled(),
+           NULL_IF_EMPTY(obj.check_command()),
+           obj.checks_active(),
+           obj.flap_detection_enabled(),
+           obj.low_flap_threshold(),
+           obj.high_flap_threshold(),
+           static_cast<bool>(obj.flap_detection_options()
+                             & configuration::service::ok),
+           static_cast<bool>(obj.flap_detection_options()
+                             &configuration::service::warning),
+           static_cast<bool>(obj.flap_detection_options()
+                             &configuration::service::unknown),
+           static_cast<bool>(obj.flap_detection_options()
+                             &configuration::service::critical),
+           obj.check_freshness(),
+           obj.freshness_threshold(),
+           obj.obsess_over_service(),
+           NULL_IF_EMPTY(obj.timezone())));
+}
+
+/**
+ *  Link a service prepared before the main loop was stopped with its
+ *  host. Its commands and check period were looked up already.
+ *
+ *  @param[in,out] svc  Service.
+ *  @param[in]     hst  Host of the service, NULL if it does not exist.
+ *
+ *  @return True if the service is resolved, false if it must be
+ *          resolved by check_service().
+ */
+static bool link_prepared(service_struct* svc, host_struct* hst) {
+  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> > const&
+    prepared(applier::state::instance().prepared_services());
+  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
+    it(prepared.find(std::make_pair(svc->host_name, svc->description)));
+  if (!hst
+      || (it == prepared.end())
+      || (it->second.get() != svc)
+      || (svc->event_handler && !svc->event_handler_ptr)
+      || (svc->service_check_command && !svc->check_command_ptr)
+      || (svc->check_period && !svc->check_period_ptr)
+      || contains_illegal_object_chars(svc->description))
+    return (false);
+  svc->host_ptr = hst;
+  add_service_link_to_host(hst, svc);
+  return (true);
+}
+
 /**
  *  Default constructor.
  */
@@ -86,58 +157,56 @@ void applier::service::add_object(
   // Add service to the global configuration set.
   config->services().insert(obj);
 
-  // Create service.
-  // XXX: Manage host_id.
-  service_struct* svc(add_service(
-    0,
-    obj->hosts().front().c_str(),
-    obj->service_id(),
-    obj->service_description().c_str(),
-    NULL_IF_EMPTY(obj->check_period()),
-    obj->initial_state(),
-    obj->max_check_attempts(),
-    (obj->check_timeout() >= 0) ? obj->check_timeout().get() : 0,
-    obj->check_interval(),
-    obj->retry_interval(),
-    obj->is_volatile(),
-    NULL_IF_EMPTY(obj->event_handler()),
-    obj->event_handler_enabled(),
-    NULL_IF_EMPTY(obj->check_command()),
-    obj->checks_active(),
-    obj->flap_detection_enabled(),
-    obj->low_flap_threshold(),
-    obj->high_flap_threshold(),
-    static_cast<bool>(obj->flap_detection_options()
-                      & configuration::service::ok),
-    static_cast<bool>(obj->flap_detection_options()
-                      &configuration::service::warning),
-    static_cast<bool>(obj->flap_detection_options()
-                      &configuration::service::unknown),
-    static_cast<bool>(obj->flap_detection_options()
-                      &configuration::service::critical),
-    obj->check_freshness(),
-    obj->freshness_threshold(),
-    obj->obsess_over_service(),
-    NULL_IF_EMPTY(obj->timezone())));
+  // Register service, it was created before the main loop was
+  // stopped unless preparing it failed.
+  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
+    it_prepared(applier::state::instance().prepared_services().find(
+                                                    obj->key()));
+  bool prepared(
+         it_prepared
+         != applier::state::instance().prepared_services().end());
+  service_struct*
+    svc(register_service(prepared ? it_prepared->second : create(*obj)));
   if (!svc)
       throw (engine_error() << "Could not register service '"
              << obj->service_description()
              << "' of host '" << obj->hosts().front() << "'");
 
   // Add custom variables.
-  for (map_customvar::const_iterator
-         it(obj->customvariables().begin()),
-         end(obj->customvariables().end());
-       it != end;
-       ++it)
-    if (!add_custom_variable_to_service(
-           svc,
-           it->first.c_str(),
-           it->second.c_str()))
-      throw (engine_error() << "Could not add custom variable '"
-             << it->first << "' to service '"
-             << obj->service_description() << "' of host '"
-             << obj->hosts().front() << "'");
+  if (prepared) {
+    // Already added, only notify the event broker.
+    for (map_customvar::const_iterator
+           it(obj->customvariables().begin()),
+           end(obj->customvariables().end());
+         it != end;
+         ++it) {
+      timeval tv(get_broker_timestamp(NULL));
+      broker_custom_variable(
+        NEBTYPE_SERVICECUSTOMVARIABLE_ADD,
+        NEBFLAG_NONE,
+        NEBATTR_NONE,
+        svc,
+        it->first.c_str(),
+        it->second.c_str(),
+        &tv);
+    }
+  }
+  else {
+    for (map_customvar::const_iterator
+           it(obj->customvariables().begin()),
+           end(obj->customvariables().end());
+         it != end;
+         ++it)
+      if (!add_custom_variable_to_service(
+             svc,
+             it->first.c_str(),
+             it->second.c_str()))
+        throw (engine_error() << "Could not add custom variable '"
+               << it->first << "' to service '"
+               << obj->service_description() << "' of host '"
+               << obj->hosts().front() << "'");
+    index_customvariables(svc->custom_variables_index, svc->custom_variables);
+  }
 
   return ;
 }
@@ -231,10 +300,10 @@ void applier::service::modify_object(
 
   // Modify properties.
   s->id = obj->service_id();
-  modify_if_different(
+  modify_interned_if_different(
     s->service_check_command,
     NULL_IF_EMPTY(obj->check_command()));
-  modify_if_different(
+  modify_interned_if_different(
     s->event_handler,
     NULL_IF_EMPTY(obj->event_handler()));
   modify_if_different(
@@ -255,7 +324,7 @@ void applier::service::modify_object(
   modify_if_different(
     s->check_timeout,
     obj->check_timeout().get());
-  modify_if_different(
+  modify_interned_if_different(
     s->check_period,
     NULL_IF_EMPTY(obj->check_period()));
   modify_if_different(
@@ -289,7 +358,7 @@ void applier::service::modify_object(
   modify_if_different(
     s->freshness_threshold,
     static_cast<int>(obj->freshness_threshold()));
-  modify_if_different(
+  modify_interned_if_different(
     s->event_handler,
     NULL_IF_EMPTY(obj->event_handler()));
   modify_if_different(
@@ -323,6 +392,7 @@ void applier::service::modify_object(
         throw (engine_error() << "Could not add custom variable '"
                << it->first << "' to service '" << service_description
                << "' on host '" << host_name << "'");
+    index_customvariables(s->custom_variables_index, s->custom_variables);
   }
 
   // Notify event broker.
@@ -339,6 +409,56 @@ void applier::service::modify_object(
   return ;
 }
 
+/**
+ *  Create a new service before the main loop is stopped. It is
+ *  registered by add_object() once the main loop is stopped.
+ *
+ *  @param[in] obj      The new service.
+ *  @param[in] resolve  True to look up the commands and check period
+ *                      of the service.
+ */
+void applier::service::prepare_object(
+                         shared_ptr<configuration::service> obj,
+                         bool resolve) {
+  // Errors are reported by add_object().
+  if (obj->hosts().size() != 1)
+    return ;
+  for (map_customvar::const_iterator
+         it(obj->customvariables().begin()),
+         end(obj->customvariables().end());
+       it != end;
+       ++it)
+    if (it->first.empty())
+      return ;
+  shared_ptr<service_struct> svc(create(*obj));
+  if (!svc)
+    return ;
+
+  // Custom variables, the event broker is notified on registration.
+  for (map_customvar::const_iterator
+         it(obj->customvariables().begin()),
+         end(obj->customvariables().end());
+       it != end;
+       ++it)
+    if (!add_custom_variable_to_object(
+           &svc->custom_variables,
+           it->first.c_str(),
+           it->second.c_str()))
+      return ;
+  index_customvariables(svc->custom_variables_index, svc->custom_variables);
+
+  // Commands and timeperiods cannot change until the main loop is
+  // stopped, the service only has to be linked with its host then.
+  if (resolve) {
+    svc->event_handler_ptr = find_command_of(svc->event_handler);
+    svc->check_command_ptr = find_command_of(svc->service_check_command);
+    svc->check_period_ptr = find_timeperiod(svc->check_period);
+  }
+
+  applier::state::instance().prepared_services()[obj->key()] = svc;
+  return ;
+}
+
 /**
  *  Remove old service.
  *
@@ -355,8 +475,6 @@ void applier::service::remove_object(
     << "' of host '" << host_name << "'.";
 
   // Find service.
-  std::pair<std::string, std::string>
-    id(std::make_pair(host_name, service_description));
   umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::iterator
     it(applier::state::instance().services_find(obj->key()));
   if (it != applier::state::instance().services().end()) {
@@ -366,14 +484,7 @@ void applier::service::remove_object(
     applier::scheduler::instance().remove_service(*obj);
 
     // Unregister service.
-    for (service_struct** s(&service_list); *s; s = &(*s)->next)
-      if (!strcmp((*s)->host_name, host_name.c_str())
-          && !strcmp(
-                (*s)->description,
-                service_description.c_str())) {
-        *s = (*s)->next;
-        break ;
-      }
+    unlink_object<service_struct>(&service_list, svc);
 
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
@@ -417,17 +528,23 @@ void applier::service::resolve_object(
            << obj->service_description() << "' of host '"
            << obj->hosts().front() << "'");
 
+  // Dependencies will be linked again when they are resolved.
+  it->second->dependencies = NULL;
+
   // Find host and adjust its counters.
   umap<std::string, shared_ptr<host_struct> >::iterator
     hst(applier::state::instance().hosts_find(it->second->host_name));
+  host_struct* hst_ptr(NULL);
   if (hst != applier::state::instance().hosts().end()) {
-    ++hst->second->total_services;
-    hst->second->total_service_check_interval
+    hst_ptr = hst->second.get();
+    ++hst_ptr->total_services;
+    hst_ptr->total_service_check_interval
       += static_cast<unsigned long>(it->second->check_interval);
   }
 
   // Resolve service.
-  if (!check_service(it->second.get(), &config_warnings, &config_errors))
+  if (!link_prepared(it->second.get(), hst_ptr)
+      && !check_service(it->second.get(), &config_warnings, &config_errors))
       throw (engine_error() << "Cannot resolve service '"
              << obj->service_description() << "' of host '"
              << obj->hosts().front() << "'");
@@ -230,6 +230,19 @@ void applier::servicedependency::remove_object(
       &servicedependency_list,
       dependency);
 
+    // Remove service dependency from the dependencies of its
+    // dependent service, if this service still exists.
+    umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::iterator
+      svc(applier::state::instance().services_find(
+            std::make_pair(
+                   dependency->dependent_host_name,
+                   dependency->dependent_service_description)));
+    if ((svc != applier::state::instance().services().end())
+        && (svc->second.get() == dependency->dependent_service_ptr))
+      unregister_dependency<servicedependency_struct>(
+        &svc->second->dependencies,
+        dependency);
+
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
     broker_adaptive_dependency_data(
@@ -28,16 +28,19 @@
 #include "com/centreon/engine/configuration/applier/hostdependency.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/macros.hh"
+#include "com/centreon/engine/configuration/applier/reference_index.hh"
 #include "com/centreon/engine/configuration/applier/scheduler.hh"
 #include "com/centreon/engine/configuration/applier/service.hh"
 #include "com/centreon/engine/configuration/applier/servicedependency.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/applier/timeperiod.hh"
 #include "com/centreon/engine/configuration/command.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/xsddefault.hh"
@@ -50,6 +53,127 @@ using namespace com::centreon::engine::logging;
 static bool            has_already_been_loaded(false);
 static applier::state* _instance(NULL);
 
+/**
+ *  Get the time elapsed between two instants.
+ *
+ *  @param[in] start  Start time.
+ *  @param[in] end    End time.
+ *
+ *  @return Elapsed time in seconds.
+ */
+static double elapsed(timeval const& start, timeval const& end) {
+  return (end.tv_sec - start.tv_sec
+          + (end.tv_usec - start.tv_usec) / 1000000.0);
+}
+
+/**
+ *  Record the references of all the objects of a set.
+ *
+ *  @param[in,out] index    Reference index.
+ *  @param[in]     objects  Configuration objects.
+ */
+template <typename T>
+static void index_objects(
+              applier::reference_index& index,
+              std::set<shared_ptr<T> > const& objects) {
+  for (typename std::set<shared_ptr<T> >::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it)
+    index.add(*it);
+  return ;
+}
+
+/**
+ *  Update the references of objects that can only be added or removed.
+ *
+ *  @param[in,out] index  Reference index.
+ *  @param[in]     diff   Changes of the objects.
+ */
+template <typename T>
+static void update_references(
+              applier::reference_index& index,
+              applier::difference<std::set<shared_ptr<T> > > const& diff) {
+  typedef std::set<shared_ptr<T> > cfg_set;
+  for (typename cfg_set::const_iterator
+         it(diff.deleted().begin()), end(diff.deleted().end());
+       it != end;
+       ++it)
+    index.remove(*it);
+  index_objects(index, diff.added());
+  return ;
+}
+
+/**
+ *  Update the references of objects that can be modified.
+ *
+ *  @param[in,out] index        Reference index.
+ *  @param[in]     diff         Changes of the objects.
+ *  @param[in]     old_objects  Current configuration objects.
+ *  @param[in]     find         Method finding a current object.
+ */
+template <typename T>
+static void update_references(
+              applier::reference_index& index,
+              applier::difference<std::set<shared_ptr<T> > > const& diff,
+              std::set<shared_ptr<T> > const& old_objects,
+              typename std::set<shared_ptr<T> >::const_iterator
+                (configuration::state::* find)(
+                  typename T::key_type const&) const) {
+  typedef std::set<shared_ptr<T> > cfg_set;
+  update_references(index, diff);
+  for (typename cfg_set::const_iterator
+         it(diff.modified().begin()), end(diff.modified().end());
+       it != end;
+       ++it) {
+    typename cfg_set::const_iterator old((config->*find)((*it)->key()));
+    if (old != old_objects.end())
+      index.remove(*old);
+    index.add(*it);
+  }
+  return ;
+}
+
+/**
+ *  Update the reference index with the changes of a reload. Must be
+ *  called before the current configuration is modified.
+ *
+ *  @param[in,out] index   Reference index.
+ *  @param[in]     diff_*  Changes of each object type.
+ */
+static void update_references(
+              applier::reference_index& index,
+              applier::difference<set_timeperiod> const& diff_timeperiods,
+              applier::difference<set_command> const& diff_commands,
+              applier::difference<set_host> const& diff_hosts,
+              applier::difference<set_service> const& diff_services,
+              applier::difference<set_hostdependency> const& diff_hostdependencies,
+              applier::difference<set_servicedependency> const& diff_servicedependencies) {
+  update_references(
+    index,
+    diff_timeperiods,
+    config->timeperiods(),
+    &configuration::state::timeperiods_find);
+  update_references(
+    index,
+    diff_commands,
+    config->commands(),
+    &configuration::state::commands_find);
+  update_references(
+    index,
+    diff_hosts,
+    config->hosts(),
+    &configuration::state::hosts_find);
+  update_references(
+    index,
+    diff_services,
+    config->services(),
+    &configuration::state::services_find);
+  update_references(index, diff_hostdependencies);
+  update_references(index, diff_servicedependencies);
+  return ;
+}
+
 /**
  *  Apply new configuration.
  *
@@ -155,6 +279,16 @@ void applier::state::load() {
 void applier::state::unload() {
   delete _instance;
   _instance = NULL;
+
+  // All objects are gone, release the memory of their list nodes.
+  node_pool<commandsmember_struct>::purge();
+  node_pool<customvariablesmember_struct>::purge();
+  node_pool<daterange_struct>::purge();
+  node_pool<hostsmember_struct>::purge();
+  node_pool<objectlist_struct>::purge();
+  node_pool<servicesmember_struct>::purge();
+  node_pool<timeperiodexclusion_struct>::purge();
+  node_pool<timerange_struct>::purge();
   return ;
 }
 
@@ -379,6 +513,26 @@ umultimap<std::string, shared_ptr<hostdependency_struct> >::iterator applier::st
   return ((p.first == p.second) ? _hostdependencies.end() : p.first);
 }
 
+/**
+ *  Get the hosts created before the main loop was stopped and not
+ *  registered yet.
+ *
+ *  @return Prepared hosts.
+ */
+umap<std::string, shared_ptr<host_struct> >& applier::state::prepared_hosts() throw () {
+  return (_prepared_hosts);
+}
+
+/**
+ *  Get the services created before the main loop was stopped and not
+ *  registered yet.
+ *
+ *  @return Prepared services.
+ */
+umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >& applier::state::prepared_services() throw () {
+  return (_prepared_services);
+}
+
 /**
  *  Get the current services.
  *
@@ -606,15 +760,18 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->cached_host_check_horizon(new_cfg.cached_host_check_horizon());
   config->cached_service_check_horizon(new_cfg.cached_service_check_horizon());
   config->cfg_main(new_cfg.cfg_main());
+  config->check_coalescing_window(new_cfg.check_coalescing_window());
   config->check_host_freshness(new_cfg.check_host_freshness());
   config->check_reaper_interval(new_cfg.check_reaper_interval());
   config->check_service_freshness(new_cfg.check_service_freshness());
   config->command_check_interval(new_cfg.command_check_interval());
+  config->configuration_cache_file(new_cfg.configuration_cache_file());
   config->debug_file(new_cfg.debug_file());
   config->debug_level(new_cfg.debug_level());
   config->debug_verbosity(new_cfg.debug_verbosity());
   config->enable_event_handlers(new_cfg.enable_event_handlers());
   config->enable_flap_detection(new_cfg.enable_flap_detection());
+  config->enable_neb_callback_stats(new_cfg.enable_neb_callback_stats());
   config->enable_predictive_host_dependency_checks(new_cfg.enable_predictive_host_dependency_checks());
   config->enable_predictive_service_dependency_checks(new_cfg.enable_predictive_service_dependency_checks());
   config->event_broker_options(new_cfg.event_broker_options());
@@ -636,9 +793,14 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->log_service_retries(new_cfg.log_service_retries());
   config->low_host_flap_threshold(new_cfg.low_host_flap_threshold());
   config->low_service_flap_threshold(new_cfg.low_service_flap_threshold());
+  config->max_concurrent_checks_per_command(new_cfg.max_concurrent_checks_per_command());
+  config->max_concurrent_checks_per_host(new_cfg.max_concurrent_checks_per_host());
+  config->max_concurrent_event_handlers(new_cfg.max_concurrent_event_handlers());
   config->max_debug_file_size(new_cfg.max_debug_file_size());
   config->max_log_file_size(new_cfg.max_log_file_size());
   config->max_parallel_service_checks(new_cfg.max_parallel_service_checks());
+  config->min_concurrent_checks(new_cfg.min_concurrent_checks());
+  config->native_check_workers(new_cfg.native_check_workers());
   config->obsess_over_hosts(new_cfg.obsess_over_hosts());
   config->obsess_over_services(new_cfg.obsess_over_services());
   config->ochp_command(new_cfg.ochp_command());
@@ -653,6 +815,8 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->state_retention_file(new_cfg.state_retention_file());
   config->status_file(new_cfg.status_file());
   config->time_change_threshold(new_cfg.time_change_threshold());
+  config->use_adaptive_concurrent_checks(new_cfg.use_adaptive_concurrent_checks());
+  config->use_load_aware_scheduling(new_cfg.use_load_aware_scheduling());
   config->use_setpgid(new_cfg.use_setpgid());
   config->use_syslog(new_cfg.use_syslog());
   config->user(new_cfg.user());
@@ -887,6 +1051,32 @@ void applier::state::_expand(
   return ;
 }
 
+/**
+ *  Create new objects before the main loop is stopped.
+ *
+ *  @param[in] cfg      Added configuration objects.
+ *  @param[in] resolve  True to look up the objects they use.
+ */
+template <typename ConfigurationType, typename ApplierType>
+void applier::state::_prepare(
+                       std::set<shared_ptr<ConfigurationType> > const& cfg,
+                       bool resolve) {
+  ApplierType aplyr;
+  for (typename std::set<shared_ptr<ConfigurationType> >::const_iterator
+         it(cfg.begin()),
+         end(cfg.end());
+       it != end;
+       ++it) {
+    // Objects that could not be prepared are created by add_object(),
+    // which reports the errors.
+    try {
+      aplyr.prepare_object(*it, resolve);
+    }
+    catch (...) {}
+  }
+  return ;
+}
+
 /**
  *  Process new configuration and apply it.
  *
@@ -901,6 +1091,12 @@ void applier::state::_processing(
   // Timing.
   struct timeval tv[5];
 
+  // All objects are resolved on the first load, when verifying the
+  // configuration and when restoring the previous configuration.
+  bool resolve_all(!has_already_been_loaded
+                   || verify_config
+                   || (_processing_state == state_error));
+
   // Call prelauch broker event the first time to run applier state.
   if (!has_already_been_loaded)
     broker_program_state(
@@ -913,6 +1109,7 @@ void applier::state::_processing(
   // Expand all objects.
   //
   gettimeofday(tv, NULL);
+  load_stats::phase("expand");
 
   // Expand timeperiods.
   _expand<configuration::timeperiod, applier::timeperiod>(
@@ -952,6 +1149,7 @@ void applier::state::_processing(
   //
   //  Build difference for all objects.
   //
+  load_stats::phase("difference");
 
   // Build difference for timeperiods.
   difference<set_timeperiod> diff_timeperiods;
@@ -995,10 +1193,49 @@ void applier::state::_processing(
     config->servicedependencies(),
     new_cfg.servicedependencies());
 
+  // Select objects to resolve. Like expansion and differences, this
+  // only reads configuration objects and is done before the main loop
+  // is stopped.
+  configuration::state changed;
+  if (!resolve_all) {
+    load_stats::phase("select changes");
+    _references.select_changes(
+      new_cfg,
+      diff_timeperiods,
+      diff_connectors,
+      diff_commands,
+      diff_hosts,
+      diff_services,
+      diff_hostdependencies,
+      diff_servicedependencies,
+      changed);
+    logger(dbg_config, more)
+      << "configuration: resolving " << changed.hosts().size()
+      << " host(s) and " << changed.services().size()
+      << " service(s) out of " << new_cfg.hosts().size()
+      << " and " << new_cfg.services().size();
+  }
+
+  // Create new hosts and services, only their registration needs the
+  // main loop to be stopped. Commands and timeperiods are looked up
+  // too, unless this configuration removes some of them.
+  load_stats::phase("prepare objects");
+  _prepared_hosts.clear();
+  _prepared_services.clear();
+  bool resolve_prepared(diff_commands.deleted().empty()
+                        && diff_timeperiods.deleted().empty());
+  _prepare<configuration::host, applier::host>(
+    diff_hosts.added(),
+    resolve_prepared);
+  _prepare<configuration::service, applier::service>(
+    diff_services.added(),
+    resolve_prepared);
+
   // Timing.
   gettimeofday(tv + 1, NULL);
 
   if (waiting_thread && _processing_state == state_ready) {
+    load_stats::phase("wait main loop");
     concurrency::locker lock(&_lock);
     _processing_state = state_waiting;
     // Wait to stop engine before apply configuration.
@@ -1006,8 +1243,13 @@ void applier::state::_processing(
     _processing_state = state_apply;
   }
 
+  // Main loop is stopped from now on.
+  struct timeval pause_start;
+  gettimeofday(&pause_start, NULL);
+
   try {
     // Apply logging configurations.
+    load_stats::phase("apply settings");
     applier::logging::instance().apply(new_cfg);
 
     // Apply globals configurations.
@@ -1019,59 +1261,101 @@ void applier::state::_processing(
     // Timing.
     gettimeofday(tv + 2, NULL);
 
+    // Index references of the new configuration.
+    load_stats::phase("index references");
+    if (resolve_all) {
+      _references.clear();
+      index_objects(_references, new_cfg.timeperiods());
+      index_objects(_references, new_cfg.commands());
+      index_objects(_references, new_cfg.hosts());
+      index_objects(_references, new_cfg.services());
+      index_objects(_references, new_cfg.hostdependencies());
+      index_objects(_references, new_cfg.servicedependencies());
+    }
+    else
+      update_references(
+        _references,
+        diff_timeperiods,
+        diff_commands,
+        diff_hosts,
+        diff_services,
+        diff_hostdependencies,
+        diff_servicedependencies);
+
     //
-    //  Apply and resolve all objects.
+    //  Apply and resolve objects.
     //
 
     // Apply timeperiods.
+    load_stats::phase("apply timeperiods");
     _apply<configuration::timeperiod, applier::timeperiod>(
       diff_timeperiods);
+    load_stats::phase("resolve timeperiods");
     _resolve<configuration::timeperiod, applier::timeperiod>(
-      config->timeperiods());
+      resolve_all ? config->timeperiods() : changed.timeperiods());
 
     // Apply connectors.
+    load_stats::phase("apply connectors");
     _apply<configuration::connector, applier::connector>(
       diff_connectors);
+    load_stats::phase("resolve connectors");
     _resolve<configuration::connector, applier::connector>(
-      config->connectors());
+      resolve_all ? config->connectors() : changed.connectors());
 
     // Apply commands.
+    load_stats::phase("apply commands");
     _apply<configuration::command, applier::command>(
       diff_commands);
+    load_stats::phase("resolve commands");
     _resolve<configuration::command, applier::command>(
-      config->commands());
+      resolve_all ? config->commands() : changed.commands());
 
     // Apply hosts.
+    load_stats::phase("apply hosts");
     _apply<configuration::host, applier::host>(
       diff_hosts);
 
     // Apply services.
+    load_stats::phase("apply services");
     _apply<configuration::service, applier::service>(
       diff_services);
 
     // Resolve hosts and services.
+    load_stats::phase("resolve hosts");
     _resolve<configuration::host, applier::host>(
-      config->hosts());
+      resolve_all ? config->hosts() : changed.hosts());
+    load_stats::phase("resolve services");
     _resolve<configuration::service, applier::service>(
-      config->services());
+      resolve_all ? config->services() : changed.services());
+
+    // Prepared objects are registered and resolved, forget the others.
+    _prepared_hosts.clear();
+    _prepared_services.clear();
 
     // Apply host dependencies.
+    load_stats::phase("apply host dependencies");
     _apply<configuration::hostdependency, applier::hostdependency>(
       diff_hostdependencies);
+    load_stats::phase("resolve host dependencies");
     _resolve<configuration::hostdependency, applier::hostdependency>(
-      config->hostdependencies());
+      resolve_all ? config->hostdependencies() : changed.hostdependencies());
 
     // Apply service dependencies.
+    load_stats::phase("apply service dependencies");
     _apply<configuration::servicedependency, applier::servicedependency>(
       diff_servicedependencies);
+    load_stats::phase("resolve service dependencies");
     _resolve<configuration::servicedependency, applier::servicedependency>(
-      config->servicedependencies());
+      resolve_all ? config->servicedependencies() : changed.servicedependencies());
 
     // Load retention.
-    if (state)
+    if (state) {
+      load_stats::phase("apply retention");
       _apply(new_cfg, *state);
+    }
 
     // Apply scheduler.
+    load_stats::phase("schedule");
     if (!verify_config)
       applier::scheduler::instance().apply(
         new_cfg,
@@ -1079,6 +1363,7 @@ void applier::state::_processing(
         diff_services);
 
     // Apply new global on the current state.
+    load_stats::phase("apply global state");
     if (!verify_config)
       _apply(new_cfg);
     else {
@@ -1095,11 +1380,19 @@ void applier::state::_processing(
     // Timing.
     gettimeofday(tv + 3, NULL);
 
-    // Check for circular paths between hosts.
-    pre_flight_circular_check(&config_warnings, &config_errors);
+    // Check for circular paths between hosts. Cycles can only appear
+    // when hosts or dependencies are resolved.
+    if (resolve_all
+        || !changed.hosts().empty()
+        || !changed.hostdependencies().empty()
+        || !changed.servicedependencies().empty()) {
+      load_stats::phase("circular check");
+      pre_flight_circular_check(&config_warnings, &config_errors);
+    }
 
     // Call start broker event the first time to run applier state.
     if (!has_already_been_loaded) {
+      load_stats::phase("load modules");
       neb_load_all_modules();
 
       broker_program_state(
@@ -1136,10 +1429,17 @@ void applier::state::_processing(
     }
   }
   catch (...) {
+    _prepared_hosts.clear();
+    _prepared_services.clear();
     _processing_state = state_error;
     throw;
   }
 
+  // Publish timings, the main loop is still stopped.
+  struct timeval pause_end;
+  gettimeofday(&pause_end, NULL);
+  load_stats::end(waiting_thread ? elapsed(pause_start, pause_end) : 0.0);
+
   has_already_been_loaded = true;
   _processing_state = state_ready;
 }
@@ -0,0 +1,262 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/cache.hh"
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
+#include "com/centreon/engine/configuration/mapped_file.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/version.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+using namespace com::centreon::engine::logging;
+
+// Cache file identification. Bump the version each time the
+// serialization of an object changes.
+static char const* const cache_magic("centreon-engine-cache");
+static unsigned int const cache_version(1);
+static unsigned int const byte_order(0x01020304);
+
+/**
+ *  Compute the checksum of the cache payload.
+ *
+ *  @param[in] data  Payload.
+ *  @param[in] size  Payload size.
+ *
+ *  @return 64-bit checksum.
+ */
+static unsigned long long checksum(
+                            char const* data,
+                            std::size_t size) throw () {
+  static unsigned long long const prime(0x100000001b3ull);
+  unsigned long long h(0xcbf29ce484222325ull);
+  for (; size >= sizeof(unsigned long long);
+       data += sizeof(unsigned long long),
+         size -= sizeof(unsigned long long)) {
+    unsigned long long word;
+    memcpy(&word, data, sizeof(word));
+    h = (h ^ word) * prime;
+    h ^= h >> 29;
+  }
+  for (; size; ++data, --size)
+    h = (h ^ static_cast<unsigned char>(*data)) * prime;
+  return (h);
+}
+
+/**
+ *  Constructor. Source files are checked immediately, so that the
+ *  cache describes them as they were before being parsed.
+ *
+ *  @param[in] path          Cache file path.
+ *  @param[in] sources       Object files, in parsing order.
+ *  @param[in] read_options  Parser reading options.
+ */
+cache::cache(
+         std::string const& path,
+         std::list<std::string> const& sources,
+         unsigned int read_options)
+  : _path(path),
+    _stable(true) {
+  // A file modified during the current second could be modified
+  // again without changing its times, it cannot be trusted.
+  time_t now(time(NULL));
+  cache_writer w;
+  w << read_options << static_cast<unsigned long>(sources.size());
+  for (std::list<std::string>::const_iterator
+         it(sources.begin()), end(sources.end());
+       it != end;
+       ++it) {
+    w << *it;
+    struct stat st;
+    if (stat(it->c_str(), &st)) {
+      _stable = false;
+      continue ;
+    }
+    w << static_cast<unsigned long long>(st.st_dev)
+      << static_cast<unsigned long long>(st.st_ino)
+      << static_cast<unsigned long long>(st.st_size)
+      << static_cast<long>(st.st_mtime)
+      << static_cast<long>(st.st_ctime);
+    if ((st.st_mtime >= now) || (st.st_ctime >= now))
+      _stable = false;
+  }
+  _sources = w.data();
+}
+
+/**
+ *  Destructor.
+ */
+cache::~cache() throw () {}
+
+/**
+ *  Load objects from the cache file.
+ *
+ *  @param[out] objects  Resolved objects.
+ *
+ *  @return True if the cache matches the source files and was loaded,
+ *          false if objects must be parsed.
+ */
+bool cache::load(list_object& objects) {
+  mapped_file file;
+  if (!file.open(_path) || !file.data()) {
+    logger(dbg_config, basic)
+      << "Configuration cache '" << _path << "' cannot be read";
+    return (false);
+  }
+
+  list_object loaded;
+  try {
+    // Check header.
+    cache_reader header(file.data(), file.size());
+    std::string magic;
+    unsigned int version;
+    unsigned int order;
+    std::string engine_version;
+    unsigned long long size;
+    unsigned long long sum;
+    header >> magic >> version >> order >> engine_version
+           >> size >> sum;
+    char const* payload(header.position());
+    if ((magic != cache_magic)
+        || (version != cache_version)
+        || (order != byte_order)
+        || (engine_version != CENTREON_ENGINE_VERSION_STRING)) {
+      logger(dbg_config, basic)
+        << "Configuration cache '" << _path
+        << "' was written by another version";
+      return (false);
+    }
+    if ((size != static_cast<unsigned long long>(
+                   file.data() + file.size() - payload))
+        || (checksum(payload, size) != sum))
+      throw (engine_error() << "checksum mismatch");
+
+    // Check source files.
+    cache_reader r(payload, size);
+    std::string sources;
+    r >> sources;
+    if (sources != _sources) {
+      logger(dbg_config, basic)
+        << "Configuration cache '" << _path
+        << "' does not match object files";
+      return (false);
+    }
+
+    // Read objects.
+    unsigned long count;
+    r >> count;
+    while (count--) {
+      std::string type_name;
+      r >> type_name;
+      object_ptr obj(object::create(type_name));
+      if (!obj)
+        throw (engine_error() << "unknown object type '"
+               << type_name << "'");
+      obj->load(r);
+      loaded.push_back(obj);
+    }
+    if (!r.at_end())
+      throw (engine_error() << "unexpected data after objects");
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_warning, basic)
+      << "Warning: Configuration cache '" << _path
+      << "' is invalid: " << e.what();
+    return (false);
+  }
+
+  logger(log_info_message, basic)
+    << "Configuration objects loaded from cache '" << _path << "'";
+  objects.splice(objects.end(), loaded);
+  return (true);
+}
+
+/**
+ *  Save objects in the cache file. The file is replaced atomically.
+ *
+ *  @param[in] objects  Resolved objects.
+ */
+void cache::save(list_object const& objects) {
+  if (!_stable) {
+    logger(dbg_config, basic)
+      << "Configuration cache '" << _path << "' not saved: object "
+         "files changed too recently";
+    return ;
+  }
+
+  cache_writer payload;
+  payload << _sources << static_cast<unsigned long>(objects.size());
+  for (list_object::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it) {
+    payload << (*it)->type_name();
+    (*it)->save(payload);
+  }
+  std::string const& data(payload.data());
+
+  cache_writer header;
+  header << std::string(cache_magic) << cache_version << byte_order
+         << std::string(CENTREON_ENGINE_VERSION_STRING)
+         << static_cast<unsigned long long>(data.size())
+         << checksum(data.data(), data.size());
+
+  // Read errno right after the failing call.
+  std::string tmp(_path + ".tmp");
+  char const* msg(NULL);
+  std::ofstream ofs(
+                  tmp.c_str(),
+                  std::ios_base::binary | std::ios_base::trunc);
+  if (!ofs)
+    msg = strerror(errno);
+  else {
+    ofs.write(header.data().data(), header.data().size());
+    ofs.write(data.data(), data.size());
+    if (!ofs)
+      msg = strerror(errno);
+    else {
+      ofs.close();
+      if (!ofs)
+        msg = strerror(errno);
+      else if (::rename(tmp.c_str(), _path.c_str()))
+        msg = strerror(errno);
+    }
+  }
+  if (msg) {
+    ::unlink(tmp.c_str());
+    logger(log_runtime_warning, basic)
+      << "Warning: Could not save configuration cache '" << _path
+      << "': " << msg;
+    return ;
+  }
+  logger(dbg_config, basic)
+    << "Configuration cache '" << _path << "' saved ("
+    << data.size() << " bytes)";
+  return ;
+}
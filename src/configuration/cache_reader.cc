@@ -0,0 +1,246 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/error.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] data  Serialized data, must outlive the reader.
+ *  @param[in] size  Data size.
+ */
+cache_reader::cache_reader(char const* data, std::size_t size)
+  : _current(data),
+    _end(data + size) {}
+
+/**
+ *  Destructor.
+ */
+cache_reader::~cache_reader() throw () {}
+
+/**
+ *  Check if all the data was read.
+ *
+ *  @return True if nothing is left to read.
+ */
+bool cache_reader::at_end() const throw () {
+  return (_current == _end);
+}
+
+/**
+ *  Get the position of the next value.
+ *
+ *  @return First byte not read yet.
+ */
+char const* cache_reader::position() const throw () {
+  return (_current);
+}
+
+/**
+ *  Read a boolean.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(bool& value) {
+  char c;
+  _read(&c, sizeof(c));
+  value = (c != 0);
+  return (*this);
+}
+
+/**
+ *  Read an unsigned short.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(unsigned short& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read an integer.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(int& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read an unsigned integer.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(unsigned int& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read a long.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(long& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read an unsigned long.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(unsigned long& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read an unsigned long long.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(unsigned long long& value) {
+  _read(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Read a duration.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(duration& value) {
+  long l;
+  *this >> l;
+  value = l;
+  return (*this);
+}
+
+/**
+ *  Read a group with its flags.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(group& value) {
+  bool is_inherit;
+  bool is_set;
+  group data;
+  *this >> is_inherit >> is_set >> data.get();
+  value.reset();
+  if (is_set)
+    value += data;
+  value.is_inherit(is_inherit);
+  return (*this);
+}
+
+/**
+ *  Read a list of strings.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(std::list<std::string>& value) {
+  unsigned long size;
+  *this >> size;
+  value.clear();
+  while (size--) {
+    value.push_back(std::string());
+    *this >> value.back();
+  }
+  return (*this);
+}
+
+/**
+ *  Read a map of strings.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(
+                std::map<std::string, std::string>& value) {
+  unsigned long size;
+  *this >> size;
+  value.clear();
+  while (size--) {
+    std::string key;
+    *this >> key;
+    *this >> value[key];
+  }
+  return (*this);
+}
+
+/**
+ *  Read a string.
+ *
+ *  @param[out] value  Value.
+ *
+ *  @return This object.
+ */
+cache_reader& cache_reader::operator>>(std::string& value) {
+  unsigned long size;
+  *this >> size;
+  if (size > static_cast<unsigned long>(_end - _current))
+    throw (engine_error() << "configuration cache is truncated");
+  value.assign(_current, size);
+  _current += size;
+  return (*this);
+}
+
+/**
+ *  Read raw data.
+ *
+ *  @param[out] data  Destination buffer.
+ *  @param[in]  size  Number of bytes to read.
+ */
+void cache_reader::_read(void* data, std::size_t size) {
+  if (size > static_cast<std::size_t>(_end - _current))
+    throw (engine_error() << "configuration cache is truncated");
+  memcpy(data, _current, size);
+  _current += size;
+  return ;
+}
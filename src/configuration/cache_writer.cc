@@ -0,0 +1,208 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/configuration/cache_writer.hh"
+
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Default constructor.
+ */
+cache_writer::cache_writer() {}
+
+/**
+ *  Destructor.
+ */
+cache_writer::~cache_writer() throw () {}
+
+/**
+ *  Get serialized data.
+ *
+ *  @return Everything written so far.
+ */
+std::string const& cache_writer::data() const throw () {
+  return (_data);
+}
+
+/**
+ *  Write a boolean.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(bool value) {
+  char c(value ? 1 : 0);
+  _write(&c, sizeof(c));
+  return (*this);
+}
+
+/**
+ *  Write an unsigned short.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(unsigned short value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write an integer.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(int value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write an unsigned integer.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(unsigned int value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write a long.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(long value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write an unsigned long.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(unsigned long value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write an unsigned long long.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(unsigned long long value) {
+  _write(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Write a duration.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(duration const& value) {
+  return (*this << value.get());
+}
+
+/**
+ *  Write a group with its flags.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(group const& value) {
+  return (*this << value.is_inherit() << value.is_set() << value.get());
+}
+
+/**
+ *  Write a list of strings.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(
+                std::list<std::string> const& value) {
+  *this << static_cast<unsigned long>(value.size());
+  for (std::list<std::string>::const_iterator
+         it(value.begin()), end(value.end());
+       it != end;
+       ++it)
+    *this << *it;
+  return (*this);
+}
+
+/**
+ *  Write a map of strings.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(
+                std::map<std::string, std::string> const& value) {
+  *this << static_cast<unsigned long>(value.size());
+  for (std::map<std::string, std::string>::const_iterator
+         it(value.begin()), end(value.end());
+       it != end;
+       ++it)
+    *this << it->first << it->second;
+  return (*this);
+}
+
+/**
+ *  Write a string.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+cache_writer& cache_writer::operator<<(std::string const& value) {
+  *this << static_cast<unsigned long>(value.size());
+  _data.append(value);
+  return (*this);
+}
+
+/**
+ *  Append raw data.
+ *
+ *  @param[in] data  Data.
+ *  @param[in] size  Data size.
+ */
+void cache_writer::_write(void const* data, std::size_t size) {
+  _data.append(static_cast<char const*>(data), size);
+  return ;
+}
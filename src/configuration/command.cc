@@ -18,6 +18,8 @@
 */
 
 #include <memory>
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/command.hh"
 #include "com/centreon/engine/error.hh"
 
@@ -30,9 +32,13 @@ using namespace com::centreon::engine::configuration;
 command::setters const command::_setters[] = {
   { "command_line", SETTER(std::string const&, _set_command_line) },
   { "command_name", SETTER(std::string const&, _set_command_name) },
-  { "connector",    SETTER(std::string const&, _set_connector) }
+  { "connector",    SETTER(std::string const&, _set_connector) },
+  { "native",       SETTER(bool, _set_native) }
 };
 
+// Default values.
+static bool const default_native(false);
+
 /**
  *  Constructor.
  *
@@ -40,7 +46,8 @@ command::setters const command::_setters[] = {
  */
 command::command(key_type const& key)
   : object(object::command),
-    _command_name(key) {}
+    _command_name(key),
+    _native(default_native) {}
 
 /**
  *  Copy constructor.
@@ -70,6 +77,7 @@ command& command::operator=(command const& right) {
     _command_line = right._command_line;
     _command_name = right._command_name;
     _connector = right._connector;
+    _native = right._native;
   }
   return (*this);
 }
@@ -85,7 +93,8 @@ bool command::operator==(command const& right) const throw () {
   return (object::operator==(right)
           && _command_line == right._command_line
           && _command_name == right._command_name
-          && _connector == right._connector);
+          && _connector == right._connector
+          && _native == right._native);
 }
 
 /**
@@ -124,6 +133,10 @@ void command::check_validity() const {
   if (_command_line.empty())
     throw (engine_error() << "Command '" << _command_name
            << "' has no command line (property 'command_line')");
+  if (_native && !_connector.empty())
+    throw (engine_error() << "Command '" << _command_name
+           << "' cannot be both native and run by a connector "
+           << "(properties 'native' and 'connector')");
   return ;
 }
 
@@ -136,6 +149,17 @@ command::key_type const& command::key() const throw () {
   return (_command_name);
 }
 
+/**
+ *  Load command properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void command::load(cache_reader& r) {
+  object::load(r);
+  r >> _command_line >> _command_name >> _connector >> _native;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -150,6 +174,7 @@ void command::merge(object const& obj) {
   MRG_DEFAULT(_command_line);
   MRG_DEFAULT(_command_name);
   MRG_DEFAULT(_connector);
+  MRG_OPTION(_native);
 }
 
 /**
@@ -169,6 +194,17 @@ bool command::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save command properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void command::save(cache_writer& w) const {
+  object::save(w);
+  w << _command_line << _command_name << _connector << _native;
+  return ;
+}
+
 /**
  *  Get command_line.
  *
@@ -178,6 +214,15 @@ std::string const& command::command_line() const throw () {
   return (_command_line);
 }
 
+/**
+ *  Get command_name.
+ *
+ *  @return The command_name.
+ */
+std::string& command::command_name() throw () {
+  return (_command_name);
+}
+
 /**
  *  Get command_name.
  *
@@ -196,6 +241,15 @@ std::string const& command::connector() const throw () {
   return (_connector);
 }
 
+/**
+ *  Check if the command is a native command.
+ *
+ *  @return True if the command line refers to a native check plugin.
+ */
+bool command::native() const throw () {
+  return (_native);
+}
+
 /**
  *  Set command_line value.
  *
@@ -231,3 +285,15 @@ bool command::_set_connector(std::string const& value) {
   _connector = value;
   return (true);
 }
+
+/**
+ *  Set native value.
+ *
+ *  @param[in] value The new native value.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool command::_set_native(bool value) {
+  _native = value;
+  return (true);
+}
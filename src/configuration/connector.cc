@@ -18,6 +18,8 @@
 */
 
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/connector.hh"
 #include "com/centreon/engine/error.hh"
 
@@ -133,6 +135,17 @@ connector::key_type const& connector::key() const throw () {
   return (_connector_name);
 }
 
+/**
+ *  Load connector properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void connector::load(cache_reader& r) {
+  object::load(r);
+  r >> _connector_line >> _connector_name;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -164,6 +177,17 @@ bool connector::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save connector properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void connector::save(cache_writer& w) const {
+  object::save(w);
+  w << _connector_line << _connector_name;
+  return ;
+}
+
 /**
  *  Get connector_line.
  *
@@ -173,6 +197,15 @@ std::string const& connector::connector_line() const throw () {
   return (_connector_line);
 }
 
+/**
+ *  Get connector_name.
+ *
+ *  @return The connector_name.
+ */
+std::string& connector::connector_name() throw () {
+  return (_connector_name);
+}
+
 /**
  *  Get connector_name.
  *
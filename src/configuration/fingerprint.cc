@@ -0,0 +1,240 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/configuration/fingerprint.hh"
+
+using namespace com::centreon::engine::configuration;
+
+// Lane seeds and multipliers.
+static unsigned long long const high_seed(0x6a09e667f3bcc908ull);
+static unsigned long long const low_seed(0xbb67ae8584caa73bull);
+static unsigned long long const high_mul(0x9e3779b97f4a7c15ull);
+static unsigned long long const low_mul(0xc2b2ae3d27d4eb4full);
+
+/**
+ *  Default constructor.
+ */
+fingerprint::fingerprint() throw () {
+  reset();
+}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] other  Object to copy.
+ */
+fingerprint::fingerprint(fingerprint const& other) throw ()
+  : _high(other._high), _low(other._low) {}
+
+/**
+ *  Destructor.
+ */
+fingerprint::~fingerprint() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] other  Object to copy.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator=(fingerprint const& other) throw () {
+  _high = other._high;
+  _low = other._low;
+  return (*this);
+}
+
+/**
+ *  Equal operator.
+ *
+ *  @param[in] other  Object to compare to.
+ *
+ *  @return True if both fingerprints are equal.
+ */
+bool fingerprint::operator==(fingerprint const& other) const throw () {
+  return ((_high == other._high) && (_low == other._low));
+}
+
+/**
+ *  Not equal operator.
+ *
+ *  @param[in] other  Object to compare to.
+ *
+ *  @return True if both fingerprints are different.
+ */
+bool fingerprint::operator!=(fingerprint const& other) const throw () {
+  return (!operator==(other));
+}
+
+/**
+ *  Feed a boolean.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(bool value) throw () {
+  return (*this << static_cast<long>(value));
+}
+
+/**
+ *  Feed an unsigned short.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(unsigned short value) throw () {
+  return (*this << static_cast<long>(value));
+}
+
+/**
+ *  Feed an integer.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(int value) throw () {
+  return (*this << static_cast<long>(value));
+}
+
+/**
+ *  Feed an unsigned integer.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(unsigned int value) throw () {
+  return (*this << static_cast<long>(value));
+}
+
+/**
+ *  Feed a long integer.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(long value) throw () {
+  _feed(&value, sizeof(value));
+  return (*this);
+}
+
+/**
+ *  Feed a duration.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(duration const& value) throw () {
+  return (*this << value.get());
+}
+
+/**
+ *  Feed a group, only its content is compared by group::operator==.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(group const& value) throw () {
+  return (*this << value.get());
+}
+
+/**
+ *  Feed a string list.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(
+                            std::list<std::string> const& value) throw () {
+  long size(0);
+  for (std::list<std::string>::const_iterator
+         it(value.begin()), end(value.end());
+       it != end;
+       ++it, ++size)
+    *this << *it;
+  return (*this << size);
+}
+
+/**
+ *  Feed a string map.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(
+               std::map<std::string, std::string> const& value) throw () {
+  for (std::map<std::string, std::string>::const_iterator
+         it(value.begin()), end(value.end());
+       it != end;
+       ++it)
+    *this << it->first << it->second;
+  return (*this << static_cast<long>(value.size()));
+}
+
+/**
+ *  Feed a string.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return This object.
+ */
+fingerprint& fingerprint::operator<<(std::string const& value) throw () {
+  _feed(value.data(), value.size());
+  return (*this << static_cast<long>(value.size()));
+}
+
+/**
+ *  Reset the fingerprint to the fingerprint of no data.
+ */
+void fingerprint::reset() throw () {
+  _high = high_seed;
+  _low = low_seed;
+  return ;
+}
+
+/**
+ *  Feed raw data, eight bytes at a time in two lanes.
+ *
+ *  @param[in] data  Data.
+ *  @param[in] size  Data size.
+ */
+void fingerprint::_feed(void const* data, std::size_t size) throw () {
+  unsigned char const* ptr(static_cast<unsigned char const*>(data));
+  while (size) {
+    unsigned long long word(0);
+    std::size_t len(size < sizeof(word) ? size : sizeof(word));
+    memcpy(&word, ptr, len);
+    ptr += len;
+    size -= len;
+    _high = (_high ^ word) * high_mul;
+    _high ^= _high >> 29;
+    _low = (_low ^ (word + _high)) * low_mul;
+    _low ^= _low >> 32;
+  }
+  return ;
+}
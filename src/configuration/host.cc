@@ -17,6 +17,8 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/deprecated.hh"
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/error.hh"
@@ -323,6 +325,24 @@ host::key_type const& host::key() const throw () {
   return (_host_name);
 }
 
+/**
+ *  Load host properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void host::load(cache_reader& r) {
+  object::load(r);
+  r >> _address >> _alias >> _checks_active >> _check_command
+    >> _check_freshness >> _check_interval >> _check_period
+    >> _check_timeout >> _customvariables >> _event_handler
+    >> _event_handler_enabled >> _flap_detection_enabled
+    >> _flap_detection_options >> _freshness_threshold
+    >> _high_flap_threshold >> _host_id >> _host_name >> _initial_state
+    >> _low_flap_threshold >> _max_check_attempts >> _obsess_over_host
+    >> _parents >> _retry_interval >> _timezone;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -334,6 +354,8 @@ void host::merge(object const& obj) {
            << obj.type() << "'");
   host const& tmpl(static_cast<host const&>(obj));
 
+  _invalidate_fingerprint();
+
   MRG_DEFAULT(_address);
   MRG_DEFAULT(_alias);
   MRG_OPTION(_checks_active);
@@ -368,6 +390,7 @@ void host::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool host::parse(char const* key, char const* value) {
+  _invalidate_fingerprint();
   for (unsigned int i(0);
        i < sizeof(_setters) / sizeof(*_setters);
        ++i)
@@ -391,6 +414,24 @@ bool host::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save host properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void host::save(cache_writer& w) const {
+  object::save(w);
+  w << _address << _alias << _checks_active << _check_command
+    << _check_freshness << _check_interval << _check_period
+    << _check_timeout << _customvariables << _event_handler
+    << _event_handler_enabled << _flap_detection_enabled
+    << _flap_detection_options << _freshness_threshold
+    << _high_flap_threshold << _host_id << _host_name << _initial_state
+    << _low_flap_threshold << _max_check_attempts << _obsess_over_host
+    << _parents << _retry_interval << _timezone;
+  return ;
+}
+
 /**
  *  Get address.
  *
@@ -535,6 +576,16 @@ unsigned int host::host_id() const throw() {
   return (_host_id);
 }
 
+/**
+ *  Get host_name.
+ *
+ *  @return The host_name.
+ */
+std::string& host::host_name() throw () {
+  _invalidate_fingerprint();
+  return (_host_name);
+}
+
 /**
  *  Get host_name.
  *
@@ -586,6 +637,7 @@ bool host::obsess_over_host() const throw () {
  *  @return The parents.
  */
 list_string& host::parents() throw () {
+  _invalidate_fingerprint();
   return (*_parents);
 }
 
@@ -616,6 +668,24 @@ std::string const& host::timezone() const throw () {
   return (_timezone);
 }
 
+/**
+ *  Feed the properties compared by operator==() to a fingerprint.
+ *
+ *  @param[out] fp  Fingerprint.
+ */
+void host::_compute_fingerprint(fingerprint& fp) const throw () {
+  object::_compute_fingerprint(fp);
+  fp << _address << _alias << _checks_active << _check_command
+     << _check_freshness << _check_interval << _check_period
+     << _check_timeout << _customvariables << _event_handler
+     << _event_handler_enabled << _flap_detection_enabled
+     << _flap_detection_options << _freshness_threshold
+     << _high_flap_threshold << _host_id << _host_name
+     << _initial_state << _low_flap_threshold << _max_check_attempts
+     << _obsess_over_host << _parents << _retry_interval << _timezone;
+  return ;
+}
+
 /**
  *  Set address value.
  *
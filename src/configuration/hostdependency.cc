@@ -17,6 +17,8 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/hostdependency.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -183,6 +185,18 @@ hostdependency::key_type const& hostdependency::key() const throw () {
   return (*this);
 }
 
+/**
+ *  Load hostdependency properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void hostdependency::load(cache_reader& r) {
+  object::load(r);
+  r >> _dependency_period >> _dependent_hosts >> _failure_options
+    >> _hosts >> _inherits_parent;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -218,6 +232,18 @@ bool hostdependency::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save hostdependency properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void hostdependency::save(cache_writer& w) const {
+  object::save(w);
+  w << _dependency_period << _dependent_hosts << _failure_options
+    << _hosts << _inherits_parent;
+  return ;
+}
+
 /**
  *  Set the dependency period.
  *
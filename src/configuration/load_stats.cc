@@ -0,0 +1,221 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <iomanip>
+#include <sys/time.h>
+#include <vector>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+using namespace com::centreon::engine::logging;
+
+// Load being recorded, only used by the loading thread.
+static load_stats::report _current;
+static std::string        _current_phase;
+static timeval            _phase_start;
+static bool               _running(false);
+static timeval            _start;
+
+// Last complete load, read by the status file writer.
+static load_stats::report _last;
+static bool               _has_last(false);
+static concurrency::mutex _last_lock;
+
+/**
+ *  Get the time elapsed between two instants.
+ *
+ *  @param[in] start Start time.
+ *  @param[in] end   End time.
+ *
+ *  @return Elapsed time in seconds.
+ */
+static double elapsed(timeval const& start, timeval const& end) {
+  return (end.tv_sec - start.tv_sec
+          + (end.tv_usec - start.tv_usec) / 1000000.0);
+}
+
+/**
+ *  Add the duration of the current phase to the load being recorded.
+ *
+ *  @param[in] now Current time.
+ */
+static void close_phase(timeval const& now) {
+  if (_current_phase.empty())
+    return ;
+  double duration(elapsed(_phase_start, now));
+  for (std::list<load_stats::entry>::iterator
+         it(_current.phases.begin()), end(_current.phases.end());
+       it != end;
+       ++it)
+    if (it->phase == _current_phase) {
+      it->duration += duration;
+      _current_phase.clear();
+      return ;
+    }
+  load_stats::entry e;
+  e.duration = duration;
+  e.phase = _current_phase;
+  _current.phases.push_back(e);
+  _current_phase.clear();
+  return ;
+}
+
+/**
+ *  Start recording a configuration load.
+ *
+ *  @param[in] reload True if the engine is already running.
+ */
+void load_stats::begin(bool reload) {
+  gettimeofday(&_start, NULL);
+  _current.paused_time = 0.0;
+  _current.phases.clear();
+  _current.reload = reload;
+  _current.start_time = _start.tv_sec;
+  _current.total_time = 0.0;
+  _current_phase.clear();
+  _running = true;
+  return ;
+}
+
+/**
+ *  Stop recording, publish, log and broadcast the timings of the
+ *  current load. Nothing is done if no load is being recorded.
+ *
+ *  @param[in] paused_time Time the main loop was stopped, in seconds.
+ */
+void load_stats::end(double paused_time) {
+  if (!_running)
+    return ;
+  timeval now;
+  gettimeofday(&now, NULL);
+  close_phase(now);
+  _current.paused_time = paused_time;
+  _current.total_time = elapsed(_start, now);
+  _running = false;
+
+  // Log timings.
+  if (_current.reload)
+    logger(log_info_message, basic)
+      << "Configuration reloaded in " << _current.total_time
+      << " sec, main loop paused for " << paused_time << " sec";
+  else
+    logger(log_info_message, basic)
+      << "Configuration loaded in " << _current.total_time << " sec";
+  std::vector<char const*> names;
+  std::vector<double> times;
+  for (std::list<entry>::const_iterator
+         it(_current.phases.begin()), end(_current.phases.end());
+       it != end;
+       ++it) {
+    logger(dbg_config, more)
+      << "configuration: phase '" << it->phase << "' took "
+      << it->duration << " sec";
+    names.push_back(it->phase.c_str());
+    times.push_back(it->duration);
+  }
+
+  // Send event to broker.
+  broker_configuration_load(
+    NEBTYPE_CONFIGURATIONLOAD_END,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    _current.reload,
+    _current.total_time,
+    _current.paused_time,
+    names.size(),
+    names.empty() ? NULL : &names[0],
+    times.empty() ? NULL : &times[0],
+    NULL);
+
+  // Publish.
+  concurrency::locker lock(&_last_lock);
+  _last = _current;
+  _has_last = true;
+  return ;
+}
+
+/**
+ *  Get the timings of the last complete load.
+ *
+ *  @param[out] r  Timings.
+ *
+ *  @return True if a load was completed, false otherwise.
+ */
+bool load_stats::get(report& r) {
+  concurrency::locker lock(&_last_lock);
+  if (!_has_last)
+    return (false);
+  r = _last;
+  return (true);
+}
+
+/**
+ *  Enter a new phase, ending the current one. Time spent in phases of
+ *  the same name is summed.
+ *
+ *  @param[in] name Phase name.
+ */
+void load_stats::phase(char const* name) {
+  if (!_running)
+    return ;
+  timeval now;
+  gettimeofday(&now, NULL);
+  close_phase(now);
+  _current_phase = name;
+  _phase_start = now;
+  return ;
+}
+
+/**
+ *  Write the timings of the last complete load in the status file
+ *  format.
+ *
+ *  @param[out] os  Output stream.
+ *
+ *  @return os.
+ */
+std::ostream& load_stats::save(std::ostream& os) {
+  report r;
+  if (!get(r))
+    return (os);
+  std::ios_base::fmtflags flags(os.flags());
+  std::streamsize precision(os.precision());
+  os << std::fixed << std::setprecision(6)
+     << "configurationloadstatus {\n"
+        "\treload=" << r.reload << "\n"
+        "\tstart_time=" << r.start_time << "\n"
+        "\ttotal_time=" << r.total_time << "\n"
+        "\tpaused_time=" << r.paused_time << "\n";
+  for (std::list<entry>::const_iterator
+         it(r.phases.begin()), end(r.phases.end());
+       it != end;
+       ++it)
+    os << "\tphase=" << it->phase << "," << it->duration << "\n";
+  os << "\t}\n\n";
+  os.flags(flags);
+  os.precision(precision);
+  return (os);
+}
@@ -0,0 +1,202 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/mapped_file.hh"
+
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Check if a character is a whitespace, as trimmed by string::trim().
+ *
+ *  @param[in] c  Character.
+ *
+ *  @return True if c is a whitespace.
+ */
+static bool is_whitespace(char c) throw () {
+  return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+}
+
+/**
+ *  Default constructor.
+ */
+mapped_file::mapped_file()
+  : _current(NULL),
+    _data(NULL),
+    _end(NULL) {}
+
+/**
+ *  Destructor.
+ */
+mapped_file::~mapped_file() throw () {
+  close();
+}
+
+/**
+ *  Unmap the file.
+ */
+void mapped_file::close() throw () {
+  if (_data)
+    munmap(_data, _end - _data);
+  _current = NULL;
+  _data = NULL;
+  _end = NULL;
+  return ;
+}
+
+/**
+ *  Get the mapped content.
+ *
+ *  @return First byte of the file, NULL if the file is empty or not
+ *          mapped.
+ */
+char const* mapped_file::data() const throw () {
+  return (_data);
+}
+
+/**
+ *  Get the next line that is not empty nor a comment. The line is
+ *  trimmed and NUL-terminated.
+ *
+ *  @param[out]    line               Line, valid until the next call.
+ *  @param[in,out] pos                Line number, incremented for each
+ *                                    line read.
+ *  @param[in]     join_continuations True to join lines that end with
+ *                                    a backslash with the next line.
+ *
+ *  @return True if a line was read, false at the end of the file.
+ */
+bool mapped_file::next_line(
+                    char*& line,
+                    unsigned int& pos,
+                    bool join_continuations) {
+  char* begin;
+  char* end;
+  if (!_next_range(begin, end, pos))
+    return (false);
+
+  // Join continuations by moving the next line just after the current
+  // one. The next line is always after the end of the current one.
+  if (join_continuations)
+    while ((end > begin) && (end[-1] == '\\')) {
+      --end;
+      char* next_begin;
+      char* next_end;
+      if (!_next_range(next_begin, next_end, pos))
+        break ;
+      memmove(end, next_begin, next_end - next_begin);
+      end += next_end - next_begin;
+    }
+
+  // The last line of a file without final newline cannot be
+  // terminated in place.
+  if (end == _end) {
+    _last_line.assign(begin, end);
+    line = &_last_line[0];
+    return (true);
+  }
+  *end = '\0';
+  line = begin;
+  return (true);
+}
+
+/**
+ *  Map a file.
+ *
+ *  @param[in] path  File path.
+ *
+ *  @return True on success, false if the file cannot be read.
+ */
+bool mapped_file::open(std::string const& path) {
+  close();
+  int fd(::open(path.c_str(), O_RDONLY));
+  if (fd < 0)
+    return (false);
+  struct stat st;
+  if (fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return (false);
+  }
+  if (st.st_size) {
+    void* data(mmap(
+                 NULL,
+                 st.st_size,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE,
+                 fd,
+                 0));
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      return (false);
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    _data = static_cast<char*>(data);
+    _end = _data + st.st_size;
+    _current = _data;
+  }
+  ::close(fd);
+  return (true);
+}
+
+/**
+ *  Get the size of the mapped file.
+ *
+ *  @return Size in bytes.
+ */
+std::size_t mapped_file::size() const throw () {
+  return (_end - _data);
+}
+
+/**
+ *  Find the next line that is not empty nor a comment.
+ *
+ *  @param[out]    begin  First character of the trimmed line.
+ *  @param[out]    end    Past the last character of the trimmed line.
+ *  @param[in,out] pos    Line number.
+ *
+ *  @return True if a line was found, false at the end of the file.
+ */
+bool mapped_file::_next_range(
+                    char*& begin,
+                    char*& end,
+                    unsigned int& pos) {
+  while (_current < _end) {
+    begin = _current;
+    end = static_cast<char*>(memchr(begin, '\n', _end - begin));
+    if (end)
+      _current = end + 1;
+    else
+      _current = end = _end;
+    ++pos;
+    while ((begin < end) && is_whitespace(*begin))
+      ++begin;
+    while ((end > begin) && is_whitespace(end[-1]))
+      --end;
+    if ((begin != end)
+        && (*begin != '#')
+        && (*begin != ';')
+        && (*begin != '\0'))
+      return (true);
+  }
+  return (false);
+}
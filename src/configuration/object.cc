@@ -17,6 +17,9 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/command.hh"
 #include "com/centreon/engine/configuration/connector.hh"
 #include "com/centreon/engine/configuration/hostdependency.hh"
@@ -46,7 +49,10 @@ object::setters const object::_setters[] = {
  *  @param[in] type      The object type.
  */
 object::object(object::object_type type)
-  : _is_resolve(false), _should_register(true), _type(type) {}
+  : _has_fingerprint(false),
+    _is_resolve(false),
+    _should_register(true),
+    _type(type) {}
 
 /**
  *  Copy constructor.
@@ -71,6 +77,9 @@ object::~object() throw () {}
  */
 object& object::operator=(object const& right) {
   if (this != &right) {
+    // Objects copying all their properties keep the fingerprint.
+    _fingerprint = right._fingerprint;
+    _has_fingerprint = right._has_fingerprint;
     _is_resolve = right._is_resolve;
     _name = right._name;
     _should_register = right._should_register;
@@ -88,6 +97,8 @@ object& object::operator=(object const& right) {
  *  @return True if is the same object, otherwise false.
  */
 bool object::operator==(object const& right) const throw () {
+  if (get_fingerprint() != right.get_fingerprint())
+    return (false);
   return (_name == right._name
           && _type == right._type
           && _is_resolve == right._is_resolve
@@ -132,6 +143,32 @@ object_ptr object::create(std::string const& type_name) {
   return (obj);
 }
 
+/**
+ *  Get the content fingerprint of the object. It is computed on first
+ *  use and kept until the object is modified.
+ *
+ *  @return The object fingerprint.
+ */
+fingerprint const& object::get_fingerprint() const throw () {
+  if (!_has_fingerprint) {
+    _fingerprint.reset();
+    _compute_fingerprint(_fingerprint);
+    _has_fingerprint = true;
+  }
+  return (_fingerprint);
+}
+
+/**
+ *  Load object properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void object::load(cache_reader& r) {
+  _invalidate_fingerprint();
+  r >> _name >> _is_resolve >> _should_register >> _templates;
+  return ;
+}
+
 /**
  *  Get the object name.
  *
@@ -150,6 +187,7 @@ std::string const& object::name() const throw () {
  *  @return True on success, otherwise false.
  */
 bool object::parse(char const* key, char const* value) {
+  _invalidate_fingerprint();
   for (unsigned int i(0);
        i < sizeof(_setters) / sizeof(_setters[0]);
        ++i)
@@ -181,6 +219,29 @@ bool object::parse(std::string const& line) {
   return (true);
 }
 
+/**
+ *  Parse and set the object property from a trimmed line. The line is
+ *  split in place, values are only copied by the setters that store
+ *  them.
+ *
+ *  @param[in,out] line The configuration line, restored on failure.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool object::parse_line(char* line) {
+  char* delim(line + strcspn(line, " \t\r"));
+  char saved(*delim);
+  char* value(delim);
+  if (*value) {
+    *value++ = '\0';
+    value += strspn(value, " \t\r\n");
+  }
+  if (parse(line, value) || object::parse(line, value))
+    return (true);
+  *delim = saved;
+  return (false);
+}
+
 /**
  *  Resolve template object.
  *
@@ -190,6 +251,7 @@ void object::resolve_template(map_object& templates) {
   if (_is_resolve)
     return;
 
+  _invalidate_fingerprint();
   _is_resolve = true;
   for (std::list<std::string>::const_iterator
          it(_templates.begin()), end(_templates.end());
@@ -204,6 +266,16 @@ void object::resolve_template(map_object& templates) {
   }
 }
 
+/**
+ *  Save object properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void object::save(cache_writer& w) const {
+  w << _name << _is_resolve << _should_register << _templates;
+  return ;
+}
+
 /**
  *  Check if object should be registered.
  *
@@ -240,6 +312,28 @@ std::string const& object::type_name() const throw () {
   return (tab[_type]);
 }
 
+/**
+ *  Feed the properties compared by operator==() to a fingerprint.
+ *  Object types that do not override it only fingerprint the common
+ *  properties, which is still correct as equal fingerprints are
+ *  followed by a full comparison.
+ *
+ *  @param[out] fp  Fingerprint.
+ */
+void object::_compute_fingerprint(fingerprint& fp) const throw () {
+  fp << _name << static_cast<int>(_type) << _is_resolve
+     << _should_register << _templates;
+  return ;
+}
+
+/**
+ *  Forget the fingerprint after a modification of the object.
+ */
+void object::_invalidate_fingerprint() throw () {
+  _has_fingerprint = false;
+  return ;
+}
+
 /**
  *  Set name value.
  *
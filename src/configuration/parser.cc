@@ -17,6 +17,12 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/cache.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
+#include "com/centreon/engine/configuration/mapped_file.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
@@ -26,6 +32,9 @@ using namespace com::centreon;
 using namespace com::centreon::engine::configuration;
 using namespace com::centreon::io;
 
+// Minimum number of registered objects given to a resolver thread.
+static std::size_t const min_objects_per_resolver(1000);
+
 parser::store parser::_store[] = {
   &parser::_store_into_map<command, &command::command_name>,
   &parser::_store_into_map<connector, &connector::connector_name>,
@@ -61,6 +70,7 @@ void parser::parse(std::string const& path, state& config) {
   _config = &config;
 
   // Parse the global configuration file.
+  load_stats::phase("parse main configuration");
   _parse_global_configuration(path, true);
 
   // Parse included files.
@@ -76,14 +86,61 @@ void parser::parse(std::string const& path, state& config) {
   }
   _apply(config.cfg_include_dir(), &parser::_parse_global_directory);
 
-  // Parse objects files.
-  _apply(config.cfg_file(), &parser::_parse_object_definitions);
-  _apply(config.cfg_dir(), &parser::_parse_directory_configuration);
+  // Objects files.
+  std::list<std::string> files;
+  _get_object_files(files);
+
+  // Load resolved objects from the cache when object files did not
+  // change since it was saved.
+  std::auto_ptr<cache> objects_cache;
+  bool cached(false);
+  if (!config.configuration_cache_file().empty()) {
+    load_stats::phase("load configuration cache");
+    objects_cache.reset(new cache(
+                              config.configuration_cache_file(),
+                              files,
+                              _read_options));
+    list_object objects;
+    cached = objects_cache->load(objects);
+    for (list_object::const_iterator
+           it(objects.begin()), end(objects.end());
+         it != end;
+         ++it)
+      _add_object(*it);
+  }
 
-  // Apply template.
-  _resolve_template();
+  if (!cached) {
+    // Parse objects files.
+    load_stats::phase("parse object files");
+    _apply(files, &parser::_parse_object_definitions);
+
+    // Apply template.
+    load_stats::phase("resolve templates");
+    _resolve_template();
+
+    // Save resolved objects for the next load.
+    if (objects_cache.get()) {
+      load_stats::phase("save configuration cache");
+      list_object objects;
+      for (unsigned int i(0);
+           i < sizeof(_lst_objects) / sizeof(_lst_objects[0]);
+           ++i) {
+        objects.insert(
+                  objects.end(),
+                  _lst_objects[i].begin(),
+                  _lst_objects[i].end());
+        for (map_object::const_iterator
+               it(_map_objects[i].begin()), end(_map_objects[i].end());
+             it != end;
+             ++it)
+          objects.push_back(it->second);
+      }
+      objects_cache->save(objects);
+    }
+  }
 
   // Fill state.
+  load_stats::phase("fill configuration");
   _insert(_map_objects[object::command], config.commands());
   _insert(_map_objects[object::connector], config.connectors());
   _insert(_lst_objects[object::hostdependency], config.hostdependencies());
@@ -94,6 +151,7 @@ void parser::parse(std::string const& path, state& config) {
 
   // cleanup.
   _objects_info.clear();
+  _parsed_objects.clear();
   for (unsigned int i(0);
        i < sizeof(_lst_objects) / sizeof(_lst_objects[0]);
        ++i) {
@@ -168,6 +226,29 @@ file_info const& parser::_get_file_info(object* obj) const {
                            "found into the file information cache");
 }
 
+/**
+ *  Get the object files, in parsing order: cfg_file entries first,
+ *  then the files of cfg_dir directories.
+ *
+ *  @param[out] files  Object files.
+ */
+void parser::_get_object_files(std::list<std::string>& files) const {
+  files = _config->cfg_file();
+  for (std::list<std::string>::const_iterator
+         it(_config->cfg_dir().begin()), end(_config->cfg_dir().end());
+       it != end;
+       ++it) {
+    directory_entry dir(*it);
+    std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
+    for (std::list<file_entry>::const_iterator
+           it_file(lst.begin()), end_file(lst.end());
+         it_file != end_file;
+         ++it_file)
+      files.push_back(it_file->path());
+  }
+  return ;
+}
+
 /**
  *  Build the object list with list of object name.
  *
@@ -241,21 +322,6 @@ std::string const& parser::_map_object_type(
   return (it->second->type_name());
 }
 
-/**
- *  Parse the directory configuration.
- *
- *  @param[in] path The directory path.
- */
-void parser::_parse_directory_configuration(std::string const& path) {
-  directory_entry dir(path);
-  std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
-  for (std::list<file_entry>::const_iterator
-         it(lst.begin()), end(lst.end());
-       it != end;
-       ++it)
-    _parse_object_definitions(it->path());
-}
-
 /**
  *  Parse the global configuration file.
  *
@@ -329,8 +395,8 @@ void parser::_parse_object_definitions(std::string const& path) {
   logger(logging::log_info_message, logging::basic)
     << "Processing object config file '" << path << "'";
 
-  std::ifstream stream(path.c_str(), std::ios::binary);
-  if (!stream.is_open())
+  mapped_file file;
+  if (!file.open(path))
     throw (engine_error() << "Parsing of object definition failed: "
            << "Can't open file '" << path << "'");
 
@@ -339,43 +405,37 @@ void parser::_parse_object_definitions(std::string const& path) {
 
   bool parse_object(false);
   object_ptr obj;
-  std::string input;
-  while (string::get_next_line(stream, input, _current_line)) {
-    // Multi-line.
-    while ('\\' == input[input.size() - 1]) {
-      input.resize(input.size() - 1);
-      std::string addendum;
-      if (!string::get_next_line(stream, addendum, _current_line))
-        break ;
-      input.append(addendum);
-    }
-
+  char* input;
+  while (file.next_line(input, _current_line, true)) {
     // Check if is a valid object.
     if (obj.is_null()) {
-      if (input.find("define") || !std::isspace(input[6]))
+      if (strncmp(input, "define", 6) || !std::isspace(input[6]))
         throw (engine_error() << "Parsing of object definition failed "
                << "in file '" << _current_path << "' on line "
                << _current_line << ": Unexpected start definition");
-      string::trim_left(input.erase(0, 6));
-      std::size_t last(input.size() - 1);
-      if (input.empty() || input[last] != '{')
+      char* type(input + 6);
+      type += strspn(type, " \t\r\n");
+      std::size_t size(strlen(type));
+      if (!size || type[size - 1] != '{')
         throw (engine_error() << "Parsing of object definition failed "
                << "in file '" << _current_path << "' on line "
                << _current_line << ": Unexpected start definition");
-      std::string const& type(string::trim_right(input.erase(last)));
+      type[--size] = '\0';
+      while (size && std::isspace(type[size - 1]))
+        type[--size] = '\0';
       obj = object::create(type);
       if (obj.is_null()) {
-        if ((type == "hostextinfo")
-            || (type == "serviceextinfo")
-            || (type == "hostescalation")
-            || (type == "serviceescalation")
-            || (type == "downtime")
-            || (type == "hostdowntime")
-            || (type == "servicedowntime")
-            || (type == "contact")
-            || (type == "contactgroup")
-            || (type == "hostgroup")
-            || (type == "servicegroup")) {
+        if (!strcmp(type, "hostextinfo")
+            || !strcmp(type, "serviceextinfo")
+            || !strcmp(type, "hostescalation")
+            || !strcmp(type, "serviceescalation")
+            || !strcmp(type, "downtime")
+            || !strcmp(type, "hostdowntime")
+            || !strcmp(type, "servicedowntime")
+            || !strcmp(type, "contact")
+            || !strcmp(type, "contactgroup")
+            || !strcmp(type, "hostgroup")
+            || !strcmp(type, "servicegroup")) {
           logger(logging::log_config_warning, logging::basic)
             << "Warning: " << type << " object is ignored";
           parse_object = false;
@@ -392,9 +452,9 @@ void parser::_parse_object_definitions(std::string const& path) {
       }
     }
     // Check if is the not the end of the current object.
-    else if (input != "}") {
+    else if (strcmp(input, "}")) {
       if (parse_object) {
-        if (!obj->parse(input))
+        if (!obj->parse_line(input))
           throw (engine_error() << "Parsing of object definition "
                  << "failed in file '" << _current_path << "' on line "
                  << _current_line << ": Invalid line '"
@@ -404,6 +464,7 @@ void parser::_parse_object_definitions(std::string const& path) {
     // End of the current object.
     else {
       if (parse_object) {
+        _parsed_objects.push_back(obj);
         if (!obj->name().empty())
           _add_template(obj);
         if (obj->should_register())
@@ -416,56 +477,167 @@ void parser::_parse_object_definitions(std::string const& path) {
 
 /**
  *  Resolve template for register objects.
+ *
+ *  Templates are resolved first, then registered objects are resolved
+ *  and checked by resolver threads working on consecutive ranges. The
+ *  error reported is the one of the first invalid object in file
+ *  order, whatever the number of threads.
  */
 void parser::_resolve_template() {
-  for (unsigned int i(0);
-       i < sizeof(_templates) / sizeof(_templates[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
-    for (map_object::iterator
-           it(_templates[i].begin()), end(_templates[i].end());
-         it != end;
-         ++it)
-      it->second->resolve_template(templates);
+  // Resolve templates. Each template is resolved once, after the
+  // templates it inherits from.
+  for (list_object::const_iterator
+         it(_parsed_objects.begin()), end(_parsed_objects.end());
+       it != end;
+       ++it)
+    if (!(*it)->name().empty())
+      (*it)->resolve_template(_templates[(*it)->type()]);
+
+  // Registered objects in file order.
+  std::vector<object*> objects;
+  objects.reserve(_parsed_objects.size());
+  for (list_object::const_iterator
+         it(_parsed_objects.begin()), end(_parsed_objects.end());
+       it != end;
+       ++it)
+    if ((*it)->should_register())
+      objects.push_back(it->get());
+
+  // Split objects between resolvers.
+  std::size_t count(objects.size() / min_objects_per_resolver);
+  long cpus(sysconf(_SC_NPROCESSORS_ONLN));
+  if ((cpus > 0) && (count > static_cast<std::size_t>(cpus)))
+    count = cpus;
+  if (!count)
+    count = 1;
+  std::vector<resolver*> resolvers;
+  resolvers.reserve(count);
+  for (std::size_t i(0); i < count; ++i)
+    resolvers.push_back(new resolver(
+                              objects,
+                              objects.size() * i / count,
+                              objects.size() * (i + 1) / count,
+                              _templates));
+
+  // The first range is resolved by the current thread.
+  std::size_t started(1);
+  try {
+    for (; started < count; ++started)
+      resolvers[started]->exec();
   }
-
-  for (unsigned int i(0);
-       i < sizeof(_lst_objects) / sizeof(_lst_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
-    for (list_object::iterator
-           it(_lst_objects[i].begin()), end(_lst_objects[i].end());
-         it != end;
-         ++it) {
-      (*it)->resolve_template(templates);
-      try {
-        (*it)->check_validity();
-      }
-      catch (std::exception const& e) {
-        throw (engine_error() << "Configuration parsing failed "
-               << _get_file_info(it->get()) << ": " << e.what());
-      }
+  catch (...) {
+    for (std::size_t i(1); i < started; ++i)
+      resolvers[i]->wait();
+    for (std::size_t i(0); i < count; ++i)
+      delete resolvers[i];
+    throw;
+  }
+  resolvers[0]->resolve();
+  for (std::size_t i(1); i < count; ++i)
+    resolvers[i]->wait();
+
+  // Report the first error.
+  std::string error;
+  object* failed(NULL);
+  bool invalid(false);
+  for (std::size_t i(0); i < count; ++i) {
+    if (!failed && (resolvers[i]->failed() < objects.size())) {
+      error = resolvers[i]->error();
+      failed = objects[resolvers[i]->failed()];
+      invalid = resolvers[i]->invalid();
     }
+    delete resolvers[i];
   }
+  if (invalid)
+    throw (engine_error() << "Configuration parsing failed "
+           << _get_file_info(failed) << ": " << error);
+  else if (failed)
+    throw (engine_error() << error);
+  return ;
+}
 
-  for (unsigned int i(0);
-       i < sizeof(_map_objects) / sizeof(_map_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
-    for (map_object::iterator
-           it(_map_objects[i].begin()), end(_map_objects[i].end());
-         it != end;
-         ++it) {
-      it->second->resolve_template(templates);
-      try {
-        it->second->check_validity();
-      }
-      catch (std::exception const& e) {
-        throw (engine_error() << "Configuration parsing failed "
-               << _get_file_info(it->second.get()) << ": " << e.what());
-      }
+/**
+ *  Constructor.
+ *
+ *  @param[in] objects   Registered objects.
+ *  @param[in] begin     Index of the first object to resolve.
+ *  @param[in] end       Index past the last object to resolve.
+ *  @param[in] templates Resolved templates, by object type.
+ */
+parser::resolver::resolver(
+                    std::vector<object*> const& objects,
+                    std::size_t begin,
+                    std::size_t end,
+                    map_object* templates)
+  : _begin(begin),
+    _end(end),
+    _failed(objects.size()),
+    _invalid(false),
+    _objects(objects),
+    _templates(templates) {}
+
+/**
+ *  Destructor.
+ */
+parser::resolver::~resolver() throw () {}
+
+/**
+ *  Get the error message of the first failed object.
+ *
+ *  @return Error message.
+ */
+std::string const& parser::resolver::error() const throw () {
+  return (_error);
+}
+
+/**
+ *  Get the index of the first failed object.
+ *
+ *  @return Index of the object, or the number of objects if all
+ *          objects of the range were resolved and checked.
+ */
+std::size_t parser::resolver::failed() const throw () {
+  return (_failed);
+}
+
+/**
+ *  Check if the first failed object was resolved but is invalid.
+ *
+ *  @return True if check_validity() failed, false if the template
+ *          resolution failed.
+ */
+bool parser::resolver::invalid() const throw () {
+  return (_invalid);
+}
+
+/**
+ *  Resolve and check objects of the range.
+ */
+void parser::resolver::resolve() {
+  for (std::size_t i(_begin); i < _end; ++i) {
+    object* obj(_objects[i]);
+    try {
+      _invalid = false;
+      obj->resolve_template(_templates[obj->type()]);
+      _invalid = true;
+      obj->check_validity();
+    }
+    catch (std::exception const& e) {
+      _error = e.what();
+      _failed = i;
+      return ;
     }
   }
+  _invalid = false;
+  return ;
+}
+
+/**
+ *  Thread entry point.
+ */
+void parser::resolver::_run() {
+  resolve();
+  return ;
 }
 
 /**
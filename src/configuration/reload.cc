@@ -19,6 +19,7 @@
 
 #include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/configuration/reload.hh"
 #include "com/centreon/engine/configuration/state.hh"
@@ -82,6 +83,7 @@ void reload::_run() {
   try {
     configuration::state config;
     {
+      load_stats::begin(true);
       configuration::parser p;
       std::string path(::config->cfg_main());
       p.parse(path, config);
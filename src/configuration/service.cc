@@ -17,6 +17,8 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/deprecated.hh"
 #include "com/centreon/engine/configuration/service.hh"
 #include "com/centreon/engine/error.hh"
@@ -328,6 +330,24 @@ service::key_type service::key() const {
   return (k);
 }
 
+/**
+ *  Load service properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void service::load(cache_reader& r) {
+  object::load(r);
+  r >> _checks_active >> _check_command >> _check_freshness
+    >> _check_interval >> _check_period >> _check_timeout
+    >> _customvariables >> _event_handler >> _event_handler_enabled
+    >> _flap_detection_enabled >> _flap_detection_options
+    >> _freshness_threshold >> _high_flap_threshold >> _hosts
+    >> _initial_state >> _is_volatile >> _low_flap_threshold
+    >> _max_check_attempts >> _obsess_over_service >> _retry_interval
+    >> _service_description >> _service_id >> _timezone;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -339,6 +359,8 @@ void service::merge(object const& obj) {
            << obj.type() << "'");
   service const& tmpl(static_cast<service const&>(obj));
 
+  _invalidate_fingerprint();
+
   MRG_OPTION(_checks_active);
   MRG_DEFAULT(_check_command);
   MRG_OPTION(_check_freshness);
@@ -372,6 +394,7 @@ void service::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool service::parse(char const* key, char const* value) {
+  _invalidate_fingerprint();
   for (unsigned int i(0);
        i < sizeof(_setters) / sizeof(*_setters);
        ++i)
@@ -395,6 +418,24 @@ bool service::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save service properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void service::save(cache_writer& w) const {
+  object::save(w);
+  w << _checks_active << _check_command << _check_freshness
+    << _check_interval << _check_period << _check_timeout
+    << _customvariables << _event_handler << _event_handler_enabled
+    << _flap_detection_enabled << _flap_detection_options
+    << _freshness_threshold << _high_flap_threshold << _hosts
+    << _initial_state << _is_volatile << _low_flap_threshold
+    << _max_check_attempts << _obsess_over_service << _retry_interval
+    << _service_description << _service_id << _timezone;
+  return ;
+}
+
 /**
  *  Get checks_active.
  *
@@ -518,6 +559,7 @@ unsigned int service::high_flap_threshold() const throw () {
  *  @return The hosts.
  */
 list_string& service::hosts() throw () {
+  _invalidate_fingerprint();
   return (*_hosts);
 }
 
@@ -590,6 +632,7 @@ duration const& service::retry_interval() const throw () {
  *  @return The service_description.
  */
 std::string& service::service_description() throw () {
+  _invalidate_fingerprint();
   return (_service_description);
 }
 
@@ -617,6 +660,7 @@ unsigned int service::service_id() const throw() {
  *  @param[in] tz  New service timezone.
  */
 void service::timezone(std::string const& tz) {
+  _invalidate_fingerprint();
   _timezone = tz;
   return ;
 }
@@ -639,6 +683,24 @@ bool service::timezone_defined() const throw () {
   return (_timezone.is_set());
 }
 
+/**
+ *  Feed the properties compared by operator==() to a fingerprint.
+ *
+ *  @param[out] fp  Fingerprint.
+ */
+void service::_compute_fingerprint(fingerprint& fp) const throw () {
+  object::_compute_fingerprint(fp);
+  fp << _checks_active << _check_command << _check_freshness
+     << _check_interval << _check_period << _check_timeout
+     << _customvariables << _event_handler << _event_handler_enabled
+     << _flap_detection_enabled << _flap_detection_options
+     << _freshness_threshold << _high_flap_threshold << _hosts
+     << _initial_state << _is_volatile << _low_flap_threshold
+     << _max_check_attempts << _obsess_over_service << _retry_interval
+     << _service_description << _service_id << _timezone;
+  return ;
+}
+
 /**
  *  Set check_command value.
  *
@@ -17,6 +17,8 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/servicedependency.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -216,6 +218,19 @@ servicedependency::key_type const& servicedependency::key() const throw () {
   return (*this);
 }
 
+/**
+ *  Load servicedependency properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void servicedependency::load(cache_reader& r) {
+  object::load(r);
+  r >> _dependency_period >> _dependent_hosts
+    >> _dependent_service_description >> _failure_options >> _hosts
+    >> _inherits_parent >> _service_description;
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -253,6 +268,19 @@ bool servicedependency::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Save servicedependency properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void servicedependency::save(cache_writer& w) const {
+  object::save(w);
+  w << _dependency_period << _dependent_hosts
+    << _dependent_service_description << _failure_options << _hosts
+    << _inherits_parent << _service_description;
+  return ;
+}
+
 /**
  *  Set the dependency period.
  *
@@ -18,6 +18,7 @@
 */
 
 #include <limits>
+#include <pthread.h>
 #include "compatibility/locations.h"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/configuration/deprecated.hh"
@@ -47,6 +48,105 @@ static bool set_user_helper(
   return (true);
 }
 
+/**
+ *  Check whether two objects have the same key.
+ *
+ *  @param[in] obj1  First object.
+ *  @param[in] obj2  Second object.
+ *
+ *  @return True if both objects have the same key.
+ */
+template <typename T>
+static bool same_key(T const& obj1, T const& obj2) {
+  return (obj1.key() == obj2.key());
+}
+
+/**
+ *  Check whether two services have the same key, without building
+ *  their keys.
+ *
+ *  @param[in] obj1  First service.
+ *  @param[in] obj2  Second service.
+ *
+ *  @return True if both services have the same key.
+ */
+static bool same_key(
+              configuration::service const& obj1,
+              configuration::service const& obj2) {
+  return (!obj1.hosts().empty()
+          && !obj2.hosts().empty()
+          && (obj1.service_description() == obj2.service_description())
+          && (obj1.hosts().front() == obj2.hosts().front()));
+}
+
+/**
+ *  @class lookup_probe
+ *  @brief Per-thread lookup probes.
+ *
+ *  Object sets are ordered by object, so looking an object up by its
+ *  key requires an object holding this key. Each thread allocates one
+ *  probe per object type and only overwrites its key afterwards, which
+ *  does not allocate once the key strings have grown large enough.
+ *  Probes are held in thread-specific data and freed when their thread
+ *  exits.
+ */
+template <typename T>
+class lookup_probe {
+public:
+  /**
+   *  Get the probe of the calling thread.
+   *
+   *  @return Probe object.
+   */
+  static shared_ptr<T> const& get() {
+    pthread_once(&_once, &_create_key);
+    shared_ptr<T>* probe(
+      static_cast<shared_ptr<T>*>(pthread_getspecific(_key)));
+    if (!probe) {
+      probe = new shared_ptr<T>(new T);
+      pthread_setspecific(_key, probe);
+    }
+    return (*probe);
+  }
+
+private:
+  static void _create_key() {
+    pthread_key_create(&_key, &_destroy);
+    return ;
+  }
+
+  static void _destroy(void* probe) {
+    delete static_cast<shared_ptr<T>*>(probe);
+    return ;
+  }
+
+  static pthread_key_t  _key;
+  static pthread_once_t _once;
+};
+
+template <typename T>
+pthread_key_t lookup_probe<T>::_key;
+template <typename T>
+pthread_once_t lookup_probe<T>::_once = PTHREAD_ONCE_INIT;
+
+/**
+ *  Find an object in a set from a probe holding its key.
+ *
+ *  @param[in] objects  Object set.
+ *  @param[in] probe    Object holding the searched key.
+ *
+ *  @return Iterator to the object if found, objects.end() otherwise.
+ */
+template <typename I, typename S>
+static I find_object(S& objects, typename S::key_type const& probe) {
+  I it(objects.upper_bound(probe));
+  if ((it != objects.end()) && same_key(**it, *probe))
+    return (it);
+  else if ((it != objects.begin()) && same_key(**--it, *probe))
+    return (it);
+  return (objects.end());
+}
+
 #define SETTER(type, method) \
   &state::setter<type, &state::method>::generic
 
@@ -60,16 +160,19 @@ state::setters const state::_setters[] = {
   { "cfg_file",                                    SETTER(std::string const&, _set_cfg_file) },
   { "cfg_include",                                 SETTER(std::string const&, _set_cfg_include) },
   { "cfg_include_dir",                             SETTER(std::string const&, _set_cfg_include_dir) },
+  { "check_coalescing_window",                     SETTER(unsigned int, check_coalescing_window) },
   { "check_host_freshness",                        SETTER(bool, check_host_freshness) },
   { "check_result_reaper_frequency",               SETTER(duration const&, check_reaper_interval) },
   { "check_service_freshness",                     SETTER(bool, check_service_freshness) },
   { "command_check_interval",                      SETTER(duration const&, command_check_interval) },
   { "command_file",                                SETTER(std::string const&, command_file) },
+  { "configuration_cache_file",                    SETTER(std::string const&, configuration_cache_file) },
   { "debug_file",                                  SETTER(std::string const&, debug_file) },
   { "debug_level",                                 SETTER(unsigned long long, debug_level) },
   { "debug_verbosity",                             SETTER(unsigned int, debug_verbosity) },
   { "enable_event_handlers",                       SETTER(bool, enable_event_handlers) },
   { "enable_flap_detection",                       SETTER(bool, enable_flap_detection) },
+  { "enable_neb_callback_stats",                   SETTER(bool, enable_neb_callback_stats) },
   { "enable_predictive_host_dependency_checks",    SETTER(bool, enable_predictive_host_dependency_checks) },
   { "enable_predictive_service_dependency_checks", SETTER(bool, enable_predictive_service_dependency_checks) },
   { "event_broker_options",                        SETTER(std::string const&, _set_event_broker_options) },
@@ -94,8 +197,13 @@ state::setters const state::_setters[] = {
   { "low_host_flap_threshold",                     SETTER(float, low_host_flap_threshold) },
   { "low_service_flap_threshold",                  SETTER(float, low_service_flap_threshold) },
   { "max_concurrent_checks",                       SETTER(unsigned int, max_parallel_service_checks) },
+  { "max_concurrent_checks_per_command",           SETTER(unsigned int, max_concurrent_checks_per_command) },
+  { "max_concurrent_checks_per_host",              SETTER(unsigned int, max_concurrent_checks_per_host) },
+  { "max_concurrent_event_handlers",               SETTER(unsigned int, max_concurrent_event_handlers) },
   { "max_debug_file_size",                         SETTER(unsigned long, max_debug_file_size) },
   { "max_log_file_size",                           SETTER(unsigned long, max_log_file_size) },
+  { "min_concurrent_checks",                       SETTER(unsigned int, min_concurrent_checks) },
+  { "native_check_workers",                        SETTER(unsigned int, native_check_workers) },
   { "obsess_over_hosts",                           SETTER(bool, obsess_over_hosts) },
   { "obsess_over_services",                        SETTER(bool, obsess_over_services) },
   { "ochp_command",                                SETTER(std::string const&, ochp_command) },
@@ -112,6 +220,8 @@ state::setters const state::_setters[] = {
   { "status_file",                                 SETTER(std::string const&, status_file) },
   { "time_change_threshold",                       SETTER(duration const&, time_change_threshold) },
   { "timezone",                                    SETTER(std::string const&, use_timezone) },
+  { "use_adaptive_concurrent_checks",              SETTER(bool, use_adaptive_concurrent_checks) },
+  { "use_load_aware_scheduling",                   SETTER(bool, use_load_aware_scheduling) },
   { "use_setpgid",                                 SETTER(bool, use_setpgid) },
   { "use_syslog",                                  SETTER(bool, use_syslog) },
   { "use_timezone",                                SETTER(std::string const&, use_timezone) },
@@ -466,16 +576,19 @@ static long const                      default_additional_freshness_latency(15);
 static std::string const               default_broker_module_directory("");
 static long const                      default_cached_host_check_horizon(15);
 static long const                      default_cached_service_check_horizon(15);
+static unsigned int const              default_check_coalescing_window(0);
 static bool const                      default_check_host_freshness(false);
 static long const                      default_check_reaper_interval(10);
 static bool const                      default_check_service_freshness(true);
 static long const                      default_command_check_interval(-1);
 static std::string const               default_command_file(DEFAULT_COMMAND_FILE);
+static std::string const               default_configuration_cache_file("");
 static std::string const               default_debug_file(DEFAULT_DEBUG_FILE);
 static unsigned long long const        default_debug_level(0);
 static unsigned int const              default_debug_verbosity(1);
 static bool const                      default_enable_event_handlers(true);
 static bool const                      default_enable_flap_detection(false);
+static bool const                      default_enable_neb_callback_stats(false);
 static bool const                      default_enable_predictive_host_dependency_checks(true);
 static bool const                      default_enable_predictive_service_dependency_checks(true);
 static unsigned long const             default_event_broker_options(std::numeric_limits<unsigned long>::max());
@@ -499,9 +612,14 @@ static bool const                      default_log_pid(true);
 static bool const                      default_log_service_retries(false);
 static float const                     default_low_host_flap_threshold(20.0);
 static float const                     default_low_service_flap_threshold(20.0);
+static unsigned int const              default_max_concurrent_checks_per_command(0);
+static unsigned int const              default_max_concurrent_checks_per_host(0);
+static unsigned int const              default_max_concurrent_event_handlers(0);
 static unsigned long const             default_max_debug_file_size(1000000);
 static unsigned long const             default_max_log_file_size(0);
 static unsigned int const              default_max_parallel_service_checks(0);
+static unsigned int const              default_min_concurrent_checks(1);
+static unsigned int const              default_native_check_workers(8);
 static bool const                      default_obsess_over_hosts(false);
 static bool const                      default_obsess_over_services(false);
 static std::string const               default_ochp_command("");
@@ -516,6 +634,8 @@ static bool const                      default_soft_state_dependencies(false);
 static std::string const               default_state_retention_file(DEFAULT_RETENTION_FILE);
 static std::string const               default_status_file(DEFAULT_STATUS_FILE);
 static long const                      default_time_change_threshold(900);
+static bool const                      default_use_adaptive_concurrent_checks(false);
+static bool const                      default_use_load_aware_scheduling(false);
 static bool const                      default_use_setpgid(true);
 static bool const                      default_use_syslog(false);
 static std::string const               default_use_timezone("");
@@ -551,16 +671,19 @@ state::state()
   : _additional_freshness_latency(default_additional_freshness_latency),
     _cached_host_check_horizon(default_cached_host_check_horizon),
     _cached_service_check_horizon(default_cached_service_check_horizon),
+    _check_coalescing_window(default_check_coalescing_window),
     _check_host_freshness(default_check_host_freshness),
     _check_reaper_interval(default_check_reaper_interval),
     _check_service_freshness(default_check_service_freshness),
     _command_check_interval(default_command_check_interval),
     _command_file(default_command_file),
+    _configuration_cache_file(default_configuration_cache_file),
     _debug_file(default_debug_file),
     _debug_level(default_debug_level),
     _debug_verbosity(default_debug_verbosity),
     _enable_event_handlers(default_enable_event_handlers),
     _enable_flap_detection(default_enable_flap_detection),
+    _enable_neb_callback_stats(default_enable_neb_callback_stats),
     _enable_predictive_host_dependency_checks(default_enable_predictive_host_dependency_checks),
     _enable_predictive_service_dependency_checks(default_enable_predictive_service_dependency_checks),
     _event_broker_options(default_event_broker_options),
@@ -584,9 +707,14 @@ state::state()
     _log_service_retries(default_log_service_retries),
     _low_host_flap_threshold(default_low_host_flap_threshold),
     _low_service_flap_threshold(default_low_service_flap_threshold),
+    _max_concurrent_checks_per_command(default_max_concurrent_checks_per_command),
+    _max_concurrent_checks_per_host(default_max_concurrent_checks_per_host),
+    _max_concurrent_event_handlers(default_max_concurrent_event_handlers),
     _max_debug_file_size(default_max_debug_file_size),
     _max_log_file_size(default_max_log_file_size),
     _max_parallel_service_checks(default_max_parallel_service_checks),
+    _min_concurrent_checks(default_min_concurrent_checks),
+    _native_check_workers(default_native_check_workers),
     _obsess_over_hosts(default_obsess_over_hosts),
     _obsess_over_services(default_obsess_over_services),
     _ochp_command(default_ochp_command),
@@ -601,6 +729,8 @@ state::state()
     _state_retention_file(default_state_retention_file),
     _status_file(default_status_file),
     _time_change_threshold(default_time_change_threshold),
+    _use_adaptive_concurrent_checks(default_use_adaptive_concurrent_checks),
+    _use_load_aware_scheduling(default_use_load_aware_scheduling),
     _use_setpgid(default_use_setpgid),
     _use_syslog(default_use_syslog),
     _use_timezone(default_use_timezone) {
@@ -634,18 +764,21 @@ state& state::operator=(state const& other) {
     _broker_module_directory = other._broker_module_directory;
     _cached_host_check_horizon = other._cached_host_check_horizon;
     _cached_service_check_horizon = other._cached_service_check_horizon;
+    _check_coalescing_window = other._check_coalescing_window;
     _check_host_freshness = other._check_host_freshness;
     _check_reaper_interval = other._check_reaper_interval;
     _check_service_freshness = other._check_service_freshness;
     _commands = other._commands;
     _command_check_interval = other._command_check_interval;
     _command_file = other._command_file;
+    _configuration_cache_file = other._configuration_cache_file;
     _connectors = other._connectors;
     _debug_file = other._debug_file;
     _debug_level = other._debug_level;
     _debug_verbosity = other._debug_verbosity;
     _enable_event_handlers = other._enable_event_handlers;
     _enable_flap_detection = other._enable_flap_detection;
+    _enable_neb_callback_stats = other._enable_neb_callback_stats;
     _enable_predictive_host_dependency_checks = other._enable_predictive_host_dependency_checks;
     _enable_predictive_service_dependency_checks = other._enable_predictive_service_dependency_checks;
     _event_broker_options = other._event_broker_options;
@@ -671,9 +804,14 @@ state& state::operator=(state const& other) {
     _log_service_retries = other._log_service_retries;
     _low_host_flap_threshold = other._low_host_flap_threshold;
     _low_service_flap_threshold = other._low_service_flap_threshold;
+    _max_concurrent_checks_per_command = other._max_concurrent_checks_per_command;
+    _max_concurrent_checks_per_host = other._max_concurrent_checks_per_host;
+    _max_concurrent_event_handlers = other._max_concurrent_event_handlers;
     _max_debug_file_size = other._max_debug_file_size;
     _max_log_file_size = other._max_log_file_size;
     _max_parallel_service_checks = other._max_parallel_service_checks;
+    _min_concurrent_checks = other._min_concurrent_checks;
+    _native_check_workers = other._native_check_workers;
     _obsess_over_hosts = other._obsess_over_hosts;
     _obsess_over_services = other._obsess_over_services;
     _ochp_command = other._ochp_command;
@@ -691,6 +829,8 @@ state& state::operator=(state const& other) {
     _status_file = other._status_file;
     _timeperiods = other._timeperiods;
     _time_change_threshold = other._time_change_threshold;
+    _use_adaptive_concurrent_checks = other._use_adaptive_concurrent_checks;
+    _use_load_aware_scheduling = other._use_load_aware_scheduling;
     _users = other._users;
     _use_setpgid = other._use_setpgid;
     _use_syslog = other._use_syslog;
@@ -711,18 +851,21 @@ bool state::operator==(state const& other) const {
           && _broker_module_directory == other._broker_module_directory
           && _cached_host_check_horizon == other._cached_host_check_horizon
           && _cached_service_check_horizon == other._cached_service_check_horizon
+          && _check_coalescing_window == other._check_coalescing_window
           && _check_host_freshness == other._check_host_freshness
           && _check_reaper_interval == other._check_reaper_interval
           && _check_service_freshness == other._check_service_freshness
           && cmp_set_ptr(_commands, other._commands)
           && _command_check_interval == other._command_check_interval
           && _command_file == other._command_file
+          && _configuration_cache_file == other._configuration_cache_file
           && cmp_set_ptr(_connectors, other._connectors)
           && _debug_file == other._debug_file
           && _debug_level == other._debug_level
           && _debug_verbosity == other._debug_verbosity
           && _enable_event_handlers == other._enable_event_handlers
           && _enable_flap_detection == other._enable_flap_detection
+          && _enable_neb_callback_stats == other._enable_neb_callback_stats
           && _enable_predictive_host_dependency_checks == other._enable_predictive_host_dependency_checks
           && _enable_predictive_service_dependency_checks == other._enable_predictive_service_dependency_checks
           && _event_broker_options == other._event_broker_options
@@ -748,9 +891,14 @@ bool state::operator==(state const& other) const {
           && _log_service_retries == other._log_service_retries
           && _low_host_flap_threshold == other._low_host_flap_threshold
           && _low_service_flap_threshold == other._low_service_flap_threshold
+          && _max_concurrent_checks_per_command == other._max_concurrent_checks_per_command
+          && _max_concurrent_checks_per_host == other._max_concurrent_checks_per_host
+          && _max_concurrent_event_handlers == other._max_concurrent_event_handlers
           && _max_debug_file_size == other._max_debug_file_size
           && _max_log_file_size == other._max_log_file_size
           && _max_parallel_service_checks == other._max_parallel_service_checks
+          && _min_concurrent_checks == other._min_concurrent_checks
+          && _native_check_workers == other._native_check_workers
           && _obsess_over_hosts == other._obsess_over_hosts
           && _obsess_over_services == other._obsess_over_services
           && _ochp_command == other._ochp_command
@@ -768,6 +916,8 @@ bool state::operator==(state const& other) const {
           && _status_file == other._status_file
           && cmp_set_ptr(_timeperiods, other._timeperiods)
           && _time_change_threshold == other._time_change_threshold
+          && _use_adaptive_concurrent_checks == other._use_adaptive_concurrent_checks
+          && _use_load_aware_scheduling == other._use_load_aware_scheduling
           && _users == other._users
           && _use_setpgid == other._use_setpgid
           && _use_syslog == other._use_syslog
@@ -884,6 +1034,24 @@ void state::cached_service_check_horizon(duration const& value) {
   return ;
 }
 
+/**
+ *  Get check_coalescing_window value.
+ *
+ *  @return The check_coalescing_window value.
+ */
+unsigned int state::check_coalescing_window() const throw () {
+  return (_check_coalescing_window);
+}
+
+/**
+ *  Set check_coalescing_window value.
+ *
+ *  @param[in] value The new check_coalescing_window value.
+ */
+void state::check_coalescing_window(unsigned int value) {
+  _check_coalescing_window = value;
+}
+
 /**
  *  Get cfg_dir value.
  *
@@ -1033,16 +1201,10 @@ set_command& state::commands() throw () {
  */
 set_command::const_iterator state::commands_find(
                                      command::key_type const& k) const {
-  shared_ptr<configuration::command>
-    below_searched(new configuration::command(k));
-  set_command::const_iterator
-    it(_commands.upper_bound(below_searched));
-  if ((it != _commands.end()) && ((*it)->command_name() == k))
-    return (it);
-  else if ((it != _commands.begin())
-           && ((*--it)->command_name() == k))
-    return (it);
-  return (_commands.end());
+  shared_ptr<configuration::command> const&
+    probe(lookup_probe<configuration::command>::get());
+  probe->command_name() = k;
+  return (find_object<set_command::const_iterator>(_commands, probe));
 }
 
 /**
@@ -1055,16 +1217,10 @@ set_command::const_iterator state::commands_find(
  */
 set_command::iterator state::commands_find(
                                command::key_type const& k) {
-  shared_ptr<configuration::command>
-    below_searched(new configuration::command(k));
-  set_command::iterator
-    it(_commands.upper_bound(below_searched));
-  if ((it != _commands.end()) && ((*it)->command_name() == k))
-    return (it);
-  else if ((it != _commands.begin())
-           && ((*--it)->command_name() == k))
-    return (it);
-  return (_commands.end());
+  shared_ptr<configuration::command> const&
+    probe(lookup_probe<configuration::command>::get());
+  probe->command_name() = k;
+  return (find_object<set_command::iterator>(_commands, probe));
 }
 
 /**
@@ -1108,6 +1264,30 @@ void state::command_file(std::string const& value) {
   _command_file = value;
 }
 
+/**
+ *  Get configuration_cache_file value.
+ *
+ *  @return The configuration_cache_file value.
+ */
+std::string const& state::configuration_cache_file() const throw () {
+  return (_configuration_cache_file);
+}
+
+/**
+ *  Set configuration_cache_file value.
+ *
+ *  @param[in] value The new configuration_cache_file value.
+ */
+void state::configuration_cache_file(std::string const& value) {
+  if (value.empty() || value[0] == '/')
+    _configuration_cache_file = value;
+  else {
+    io::file_entry fe(_cfg_main);
+    std::string base_name(fe.directory_name());
+    _configuration_cache_file = base_name + "/" + value;
+  }
+}
+
 /**
  *  Get all engine connectors.
  *
@@ -1136,16 +1316,10 @@ set_connector& state::connectors() throw () {
  */
 set_connector::const_iterator state::connectors_find(
                                        connector::key_type const& k) const {
-  shared_ptr<configuration::connector>
-    below_searched(new configuration::connector(k));
-  set_connector::const_iterator
-    it(_connectors.upper_bound(below_searched));
-  if ((it != _connectors.end()) && ((*it)->connector_name() == k))
-    return (it);
-  else if ((it != _connectors.begin())
-           && ((*--it)->connector_name() == k))
-    return (it);
-  return (_connectors.end());
+  shared_ptr<configuration::connector> const&
+    probe(lookup_probe<configuration::connector>::get());
+  probe->connector_name() = k;
+  return (find_object<set_connector::const_iterator>(_connectors, probe));
 }
 
 /**
@@ -1158,16 +1332,10 @@ set_connector::const_iterator state::connectors_find(
  */
 set_connector::iterator state::connectors_find(
                                  connector::key_type const& k) {
-  shared_ptr<configuration::connector>
-    below_searched(new configuration::connector(k));
-  set_connector::iterator
-    it(_connectors.upper_bound(below_searched));
-  if ((it != _connectors.end()) && ((*it)->connector_name() == k))
-    return (it);
-  else if ((it != _connectors.begin())
-           && ((*--it)->connector_name() == k))
-    return (it);
-  return (_connectors.end());
+  shared_ptr<configuration::connector> const&
+    probe(lookup_probe<configuration::connector>::get());
+  probe->connector_name() = k;
+  return (find_object<set_connector::iterator>(_connectors, probe));
 }
 
 /**
@@ -1267,6 +1435,24 @@ void state::enable_flap_detection(bool value) {
   _enable_flap_detection = value;
 }
 
+/**
+ *  Get enable_neb_callback_stats value.
+ *
+ *  @return The enable_neb_callback_stats value.
+ */
+bool state::enable_neb_callback_stats() const throw () {
+  return (_enable_neb_callback_stats);
+}
+
+/**
+ *  Set enable_neb_callback_stats value.
+ *
+ *  @param[in] value The new enable_neb_callback_stats value.
+ */
+void state::enable_neb_callback_stats(bool value) {
+  _enable_neb_callback_stats = value;
+}
+
 /**
  *  Get enable_predictive_host_dependency_checks value.
  *
@@ -1486,14 +1672,10 @@ set_host& state::hosts() throw () {
  */
 set_host::const_iterator state::hosts_find(
                                   host::key_type const& k) const {
-  shared_ptr<configuration::host>
-    below_searched(new configuration::host(k));
-  set_host::const_iterator it(_hosts.upper_bound(below_searched));
-  if ((it != _hosts.end()) && ((*it)->host_name() == k))
-    return (it);
-  else if ((it != _hosts.begin()) && ((*--it)->host_name() == k))
-    return (it);
-  return (_hosts.end());
+  shared_ptr<configuration::host> const&
+    probe(lookup_probe<configuration::host>::get());
+  probe->host_name() = k;
+  return (find_object<set_host::const_iterator>(_hosts, probe));
 }
 
 /**
@@ -1505,14 +1687,10 @@ set_host::const_iterator state::hosts_find(
  */
 set_host::iterator state::hosts_find(
                             host::key_type const& k) {
-  shared_ptr<configuration::host>
-    below_searched(new configuration::host(k));
-  set_host::iterator it(_hosts.upper_bound(below_searched));
-  if ((it != _hosts.end()) && ((*it)->host_name() == k))
-    return (it);
-  else if ((it != _hosts.begin()) && ((*--it)->host_name() == k))
-    return (it);
-  return (_hosts.end());
+  shared_ptr<configuration::host> const&
+    probe(lookup_probe<configuration::host>::get());
+  probe->host_name() = k;
+  return (find_object<set_host::iterator>(_hosts, probe));
 }
 
 /**
@@ -1782,6 +1960,60 @@ void state::low_service_flap_threshold(float value) {
   _low_service_flap_threshold = value;
 }
 
+/**
+ *  Get max_concurrent_checks_per_command value.
+ *
+ *  @return The max_concurrent_checks_per_command value.
+ */
+unsigned int state::max_concurrent_checks_per_command() const throw () {
+  return (_max_concurrent_checks_per_command);
+}
+
+/**
+ *  Set max_concurrent_checks_per_command value.
+ *
+ *  @param[in] value The new max_concurrent_checks_per_command value.
+ */
+void state::max_concurrent_checks_per_command(unsigned int value) {
+  _max_concurrent_checks_per_command = value;
+}
+
+/**
+ *  Get max_concurrent_checks_per_host value.
+ *
+ *  @return The max_concurrent_checks_per_host value.
+ */
+unsigned int state::max_concurrent_checks_per_host() const throw () {
+  return (_max_concurrent_checks_per_host);
+}
+
+/**
+ *  Set max_concurrent_checks_per_host value.
+ *
+ *  @param[in] value The new max_concurrent_checks_per_host value.
+ */
+void state::max_concurrent_checks_per_host(unsigned int value) {
+  _max_concurrent_checks_per_host = value;
+}
+
+/**
+ *  Get max_concurrent_event_handlers value.
+ *
+ *  @return The max_concurrent_event_handlers value.
+ */
+unsigned int state::max_concurrent_event_handlers() const throw () {
+  return (_max_concurrent_event_handlers);
+}
+
+/**
+ *  Set max_concurrent_event_handlers value.
+ *
+ *  @param[in] value The new max_concurrent_event_handlers value.
+ */
+void state::max_concurrent_event_handlers(unsigned int value) {
+  _max_concurrent_event_handlers = value;
+}
+
 /**
  *  Get max_debug_file_size value.
  *
@@ -1836,6 +2068,42 @@ void state::max_parallel_service_checks(unsigned int value) {
   _max_parallel_service_checks = value;
 }
 
+/**
+ *  Get min_concurrent_checks value.
+ *
+ *  @return The min_concurrent_checks value.
+ */
+unsigned int state::min_concurrent_checks() const throw () {
+  return (_min_concurrent_checks);
+}
+
+/**
+ *  Set min_concurrent_checks value.
+ *
+ *  @param[in] value The new min_concurrent_checks value.
+ */
+void state::min_concurrent_checks(unsigned int value) {
+  _min_concurrent_checks = value;
+}
+
+/**
+ *  Get native_check_workers value.
+ *
+ *  @return The native_check_workers value.
+ */
+unsigned int state::native_check_workers() const throw () {
+  return (_native_check_workers);
+}
+
+/**
+ *  Set native_check_workers value.
+ *
+ *  @param[in] value The new native_check_workers value.
+ */
+void state::native_check_workers(unsigned int value) {
+  _native_check_workers = value;
+}
+
 /**
  *  Get obsess_over_hosts value.
  *
@@ -2021,21 +2289,15 @@ set_service& state::services() throw () {
  */
 set_service::const_iterator state::services_find(
                                      service::key_type const& k) const {
-  shared_ptr<configuration::service>
-    below_searched(new configuration::service);
-  below_searched->hosts().push_back(k.first);
-  below_searched->service_description() = k.second;
-  set_service::const_iterator
-    it(_services.upper_bound(below_searched));
-  if ((it != _services.end())
-      && ((*it)->hosts().front() == k.first)
-      && ((*it)->service_description() == k.second))
-    return (it);
-  else if ((it != _services.begin())
-           && ((*--it)->hosts().front() == k.first)
-           && ((*it)->service_description() == k.second))
-    return (it);
-  return (_services.end());
+  shared_ptr<configuration::service> const&
+    probe(lookup_probe<configuration::service>::get());
+  list_string& hosts(probe->hosts());
+  if (hosts.empty())
+    hosts.push_back(k.first);
+  else
+    hosts.front() = k.first;
+  probe->service_description() = k.second;
+  return (find_object<set_service::const_iterator>(_services, probe));
 }
 
 /**
@@ -2048,21 +2310,15 @@ set_service::const_iterator state::services_find(
  */
 set_service::iterator state::services_find(
                                service::key_type const& k) {
-  shared_ptr<configuration::service>
-    below_searched(new configuration::service);
-  below_searched->hosts().push_back(k.first);
-  below_searched->service_description() = k.second;
-  set_service::iterator
-    it(_services.upper_bound(below_searched));
-  if ((it != _services.end())
-      && ((*it)->hosts().front() == k.first)
-      && ((*it)->service_description() == k.second))
-    return (it);
-  else if ((it != _services.begin())
-           && ((*--it)->hosts().front() == k.first)
-           && ((*it)->service_description() == k.second))
-    return (it);
-  return (_services.end());
+  shared_ptr<configuration::service> const&
+    probe(lookup_probe<configuration::service>::get());
+  list_string& hosts(probe->hosts());
+  if (hosts.empty())
+    hosts.push_back(k.first);
+  else
+    hosts.front() = k.first;
+  probe->service_description() = k.second;
+  return (find_object<set_service::iterator>(_services, probe));
 }
 
 /**
@@ -2252,16 +2508,10 @@ set_timeperiod& state::timeperiods() throw () {
  */
 set_timeperiod::const_iterator state::timeperiods_find(
                                         timeperiod::key_type const& k) const {
-  shared_ptr<configuration::timeperiod>
-    below_searched(new configuration::timeperiod(k));
-  set_timeperiod::const_iterator
-    it(_timeperiods.upper_bound(below_searched));
-  if ((it != _timeperiods.end()) && ((*it)->timeperiod_name() == k))
-    return (it);
-  else if ((it != _timeperiods.begin())
-           && ((*--it)->timeperiod_name() == k))
-    return (it);
-  return (_timeperiods.end());
+  shared_ptr<configuration::timeperiod> const&
+    probe(lookup_probe<configuration::timeperiod>::get());
+  probe->timeperiod_name() = k;
+  return (find_object<set_timeperiod::const_iterator>(_timeperiods, probe));
 }
 
 /**
@@ -2274,16 +2524,10 @@ set_timeperiod::const_iterator state::timeperiods_find(
  */
 set_timeperiod::iterator state::timeperiods_find(
                                   timeperiod::key_type const& k) {
-  shared_ptr<configuration::timeperiod>
-    below_searched(new configuration::timeperiod(k));
-  set_timeperiod::iterator
-    it(_timeperiods.upper_bound(below_searched));
-  if ((it != _timeperiods.end()) && ((*it)->timeperiod_name() == k))
-    return (it);
-  else if ((it != _timeperiods.begin())
-           && ((*--it)->timeperiod_name() == k))
-    return (it);
-  return (_timeperiods.end());
+  shared_ptr<configuration::timeperiod> const&
+    probe(lookup_probe<configuration::timeperiod>::get());
+  probe->timeperiod_name() = k;
+  return (find_object<set_timeperiod::iterator>(_timeperiods, probe));
 }
 
 /**
@@ -2309,6 +2553,42 @@ void state::time_change_threshold(duration const& value) {
   return ;
 }
 
+/**
+ *  Get use_adaptive_concurrent_checks value.
+ *
+ *  @return The use_adaptive_concurrent_checks value.
+ */
+bool state::use_adaptive_concurrent_checks() const throw () {
+  return (_use_adaptive_concurrent_checks);
+}
+
+/**
+ *  Set use_adaptive_concurrent_checks value.
+ *
+ *  @param[in] value The new use_adaptive_concurrent_checks value.
+ */
+void state::use_adaptive_concurrent_checks(bool value) {
+  _use_adaptive_concurrent_checks = value;
+}
+
+/**
+ *  Get use_load_aware_scheduling value.
+ *
+ *  @return The use_load_aware_scheduling value.
+ */
+bool state::use_load_aware_scheduling() const throw () {
+  return (_use_load_aware_scheduling);
+}
+
+/**
+ *  Set use_load_aware_scheduling value.
+ *
+ *  @param[in] value The new use_load_aware_scheduling value.
+ */
+void state::use_load_aware_scheduling(bool value) {
+  _use_load_aware_scheduling = value;
+}
+
 /**
  *  Get user resources.
  *
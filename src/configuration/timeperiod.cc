@@ -19,6 +19,8 @@
 
 #include <cstdio>
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/configuration/cache_reader.hh"
+#include "com/centreon/engine/configuration/cache_writer.hh"
 #include "com/centreon/engine/configuration/timeperiod.hh"
 #include "com/centreon/engine/configuration/timerange.hh"
 #include "com/centreon/engine/error.hh"
@@ -36,6 +38,119 @@ timeperiod::setters const timeperiod::_setters[] = {
   { "timeperiod_name", SETTER(std::string const&, _set_timeperiod_name) }
 };
 
+/**
+ *  Load time ranges from the configuration cache.
+ *
+ *  @param[in]  r           Cache reader.
+ *  @param[out] timeranges  Time ranges.
+ */
+static void load_timeranges(
+              cache_reader& r,
+              std::list<timerange>& timeranges) {
+  unsigned long size;
+  r >> size;
+  timeranges.clear();
+  while (size--) {
+    unsigned long start;
+    unsigned long end;
+    r >> start >> end;
+    timeranges.push_back(timerange(start, end));
+  }
+  return ;
+}
+
+/**
+ *  Save time ranges in the configuration cache.
+ *
+ *  @param[out] w           Cache writer.
+ *  @param[in]  timeranges  Time ranges.
+ */
+static void save_timeranges(
+              cache_writer& w,
+              std::list<timerange> const& timeranges) {
+  w << static_cast<unsigned long>(timeranges.size());
+  for (std::list<timerange>::const_iterator
+         it(timeranges.begin()), end(timeranges.end());
+       it != end;
+       ++it)
+    w << it->start() << it->end();
+  return ;
+}
+
+/**
+ *  Load date ranges from the configuration cache.
+ *
+ *  @param[in]  r           Cache reader.
+ *  @param[out] dateranges  Date ranges.
+ */
+static void load_dateranges(
+              cache_reader& r,
+              std::list<daterange>& dateranges) {
+  unsigned long size;
+  r >> size;
+  dateranges.clear();
+  while (size--) {
+    int type;
+    unsigned int month_end;
+    unsigned int month_start;
+    int month_day_end;
+    int month_day_start;
+    unsigned int skip_interval;
+    unsigned int week_day_end;
+    unsigned int week_day_start;
+    int week_day_end_offset;
+    int week_day_start_offset;
+    unsigned int year_end;
+    unsigned int year_start;
+    std::list<timerange> timeranges;
+    r >> type >> month_end >> month_start >> month_day_end
+      >> month_day_start >> skip_interval >> week_day_end
+      >> week_day_start >> week_day_end_offset >> week_day_start_offset
+      >> year_end >> year_start;
+    load_timeranges(r, timeranges);
+    daterange range(static_cast<daterange::type_range>(type));
+    range.month_end(month_end);
+    range.month_start(month_start);
+    range.month_day_end(month_day_end);
+    range.month_day_start(month_day_start);
+    range.skip_interval(skip_interval);
+    range.timeranges(timeranges);
+    range.week_day_end(week_day_end);
+    range.week_day_start(week_day_start);
+    range.week_day_end_offset(week_day_end_offset);
+    range.week_day_start_offset(week_day_start_offset);
+    range.year_end(year_end);
+    range.year_start(year_start);
+    dateranges.push_back(range);
+  }
+  return ;
+}
+
+/**
+ *  Save date ranges in the configuration cache.
+ *
+ *  @param[out] w           Cache writer.
+ *  @param[in]  dateranges  Date ranges.
+ */
+static void save_dateranges(
+              cache_writer& w,
+              std::list<daterange> const& dateranges) {
+  w << static_cast<unsigned long>(dateranges.size());
+  for (std::list<daterange>::const_iterator
+         it(dateranges.begin()), end(dateranges.end());
+       it != end;
+       ++it) {
+    w << static_cast<int>(it->type()) << it->month_end()
+      << it->month_start() << it->month_day_end()
+      << it->month_day_start() << it->skip_interval()
+      << it->week_day_end() << it->week_day_start()
+      << it->week_day_end_offset() << it->week_day_start_offset()
+      << it->year_end() << it->year_start();
+    save_timeranges(w, it->timeranges());
+  }
+  return ;
+}
+
 /**
  *  Constructor.
  *
@@ -151,6 +266,21 @@ timeperiod::key_type const& timeperiod::key() const throw () {
   return (_timeperiod_name);
 }
 
+/**
+ *  Load timeperiod properties from the configuration cache.
+ *
+ *  @param[in] r  Cache reader.
+ */
+void timeperiod::load(cache_reader& r) {
+  object::load(r);
+  r >> _alias >> _exclude >> _timeperiod_name;
+  for (unsigned int i(0); i < _exceptions.size(); ++i)
+    load_dateranges(r, _exceptions[i]);
+  for (unsigned int i(0); i < _timeranges.size(); ++i)
+    load_timeranges(r, _timeranges[i]);
+  return ;
+}
+
 /**
  *  Merge object.
  *
@@ -221,6 +351,33 @@ bool timeperiod::parse(std::string const& line) {
   return (false);
 }
 
+/**
+ *  Parse and set the timeperiod property from a trimmed line. Date
+ *  ranges need the whole line, so it is not split in place.
+ *
+ *  @param[in] line  The configuration line.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool timeperiod::parse_line(char* line) {
+  return (parse(std::string(line)));
+}
+
+/**
+ *  Save timeperiod properties in the configuration cache.
+ *
+ *  @param[out] w  Cache writer.
+ */
+void timeperiod::save(cache_writer& w) const {
+  object::save(w);
+  w << _alias << _exclude << _timeperiod_name;
+  for (unsigned int i(0); i < _exceptions.size(); ++i)
+    save_dateranges(w, _exceptions[i]);
+  for (unsigned int i(0); i < _timeranges.size(); ++i)
+    save_timeranges(w, _timeranges[i]);
+  return ;
+}
+
 /**
  *  Get alias value.
  *
@@ -248,6 +405,15 @@ list_string const& timeperiod::exclude() const throw () {
   return (*_exclude);
 }
 
+/**
+ *  Get timeperiod_name value.
+ *
+ *  @return The timeperiod_name value.
+ */
+std::string& timeperiod::timeperiod_name() throw () {
+  return (_timeperiod_name);
+}
+
 /**
  *  Get timeperiod_name value.
  *
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/commandsmember.hh"
 #include "com/centreon/engine/objects/commandsmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -36,5 +37,5 @@ void deleter::commandsmember(void* ptr) throw () {
   delete[] obj->cmd;
   obj->cmd = NULL;
 
-  delete obj;
+  node_pool<commandsmember_struct>::release(obj);
 }
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/customvariablesmember.hh"
 #include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -38,5 +39,5 @@ void deleter::customvariablesmember(void* ptr) throw () {
   delete[] obj->variable_value;
   obj->variable_value = NULL;
 
-  delete obj;
+  node_pool<customvariablesmember_struct>::release(obj);
 }
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/deleter/listmember.hh"
 #include "com/centreon/engine/deleter/timerange.hh"
 #include "com/centreon/engine/objects/daterange.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/timerange.hh"
 
 using namespace com::centreon::engine;
@@ -38,5 +39,5 @@ void deleter::daterange(void* ptr) throw () {
 
   listmember(obj->times, &timerange);
 
-  delete obj;
+  node_pool<daterange_struct>::release(obj);
 }
@@ -27,7 +27,9 @@
 #include "com/centreon/engine/objects/host.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -41,24 +43,22 @@ void deleter::host(void* ptr) throw () {
     return;
 
   host_struct* obj(static_cast<host_struct*>(ptr));
+  scheduling_table<host_struct>::remove(obj);
 
   listmember(obj->parent_hosts, &hostsmember);
   listmember(obj->child_hosts, &hostsmember);
   listmember(obj->services, &servicesmember);
   listmember(obj->custom_variables, &customvariablesmember);
+  unindex_customvariables(obj->custom_variables_index);
 
-  delete[] obj->name;
-  obj->name = NULL;
+  string::release(obj->name);
   delete[] obj->alias;
   obj->alias = NULL;
   delete[] obj->address;
   obj->address = NULL;
-  delete[] obj->host_check_command;
-  obj->host_check_command = NULL;
-  delete[] obj->event_handler;
-  obj->event_handler = NULL;
-  delete[] obj->check_period;
-  obj->check_period = NULL;
+  string::release(obj->host_check_command);
+  string::release(obj->event_handler);
+  string::release(obj->check_period);
   delete[] obj->plugin_output;
   obj->plugin_output = NULL;
   delete[] obj->long_plugin_output;
@@ -19,6 +19,8 @@
 
 #include "com/centreon/engine/deleter/hostsmember.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,8 +35,7 @@ void deleter::hostsmember(void* ptr) throw () {
 
   hostsmember_struct* obj(static_cast<hostsmember_struct*>(ptr));
 
-  delete[] obj->host_name;
-  obj->host_name = NULL;
+  string::release(obj->host_name);
 
-  delete obj;
+  node_pool<hostsmember_struct>::release(obj);
 }
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/objectlist.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -29,5 +30,5 @@ using namespace com::centreon::engine;
  */
 void deleter::objectlist(void* ptr) throw () {
   objectlist_struct* obj(static_cast<objectlist_struct*>(ptr));
-  delete obj;
+  node_pool<objectlist_struct>::release(obj);
 }
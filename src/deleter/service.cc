@@ -23,7 +23,9 @@
 #include "com/centreon/engine/deleter/service.hh"
 #include "com/centreon/engine/objects/customvariablesmember.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/objects/service.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -37,19 +39,16 @@ void deleter::service(void* ptr) throw () {
     return;
 
   service_struct* obj(static_cast<service_struct*>(ptr));
+  scheduling_table<service_struct>::remove(obj);
 
   listmember(obj->custom_variables, &customvariablesmember);
+  unindex_customvariables(obj->custom_variables_index);
 
-  delete[] obj->host_name;
-  obj->host_name = NULL;
-  delete[] obj->description;
-  obj->description = NULL;
-  delete[] obj->service_check_command;
-  obj->service_check_command = NULL;
-  delete[] obj->event_handler;
-  obj->event_handler = NULL;
-  delete[] obj->check_period;
-  obj->check_period = NULL;
+  string::release(obj->host_name);
+  string::release(obj->description);
+  string::release(obj->service_check_command);
+  string::release(obj->event_handler);
+  string::release(obj->check_period);
   delete[] obj->plugin_output;
   obj->plugin_output = NULL;
   delete[] obj->long_plugin_output;
@@ -19,6 +19,8 @@
 
 #include "com/centreon/engine/deleter/servicesmember.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,10 +35,8 @@ void deleter::servicesmember(void* ptr) throw () {
 
   servicesmember_struct* obj(static_cast<servicesmember_struct*>(ptr));
 
-  delete[] obj->host_name;
-  obj->host_name = NULL;
-  delete[] obj->service_description;
-  obj->service_description = NULL;
+  string::release(obj->host_name);
+  string::release(obj->service_description);
 
-  delete obj;
+  node_pool<servicesmember_struct>::release(obj);
 }
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -36,5 +37,5 @@ void deleter::timeperiodexclusion(void* ptr) throw () {
   delete[] obj->timeperiod_name;
   obj->timeperiod_name = NULL;
 
-  delete obj;
+  node_pool<timeperiodexclusion_struct>::release(obj);
 }
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/timerange.hh"
 #include "com/centreon/engine/objects/timerange.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -29,5 +30,5 @@ using namespace com::centreon::engine;
  */
 void deleter::timerange(void* ptr) throw () {
   timerange_struct* obj(static_cast<timerange_struct*>(ptr));
-  delete obj;
+  node_pool<timerange_struct>::release(obj);
 }
@@ -23,6 +23,9 @@
 #include <ctime>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/checks/admission.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
+#include "com/centreon/engine/commands/handler_runner.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
@@ -188,6 +191,12 @@ void loop::_dispatching() {
     // Keep track of the last time.
     _last_time = current_time;
 
+    // Report completed event handlers and start delayed ones.
+    commands::handler_runner::instance().reap();
+
+    // Adapt the number of concurrent checks.
+    checks::parallelism::instance().update(current_time);
+
     // Log messages about event lists.
     logger(dbg_events, more)
       << "** Event Check Loop";
@@ -208,7 +217,7 @@ void loop::_dispatching() {
     logger(dbg_events, more)
       << "Current/Max Service Checks: "
       << currently_running_service_checks << '/'
-      << config->max_parallel_service_checks();
+      << checks::parallelism::instance().limit();
 
     // Update status information occassionally - NagVis watches the
     // NDOUtils DB to see if Engine is alive.
@@ -250,71 +259,27 @@ void loop::_dispatching() {
 
       // Run a few checks before executing a service check...
       if (event_list_low->event_type == EVENT_SERVICE_CHECK) {
-        int nudge_seconds(0);
         service* temp_service(
                    static_cast<service*>(event_list_low->event_data));
 
-        // Don't run a service check if we're already maxed out on the
-        // number of parallel service checks...
-        if (config->max_parallel_service_checks() != 0
-            && (currently_running_service_checks
-                >= config->max_parallel_service_checks())) {
-          // Move it at least 5 seconds (to overcome the current peak),
-          // with a random 10 seconds (to spread the load).
-          nudge_seconds = 5 + (rand() % 10);
-          logger(dbg_events | dbg_checks, basic)
-            << "**WARNING** Max concurrent service checks ("
-            << currently_running_service_checks << "/"
-            << config->max_parallel_service_checks()
-            << ") has been reached!  Nudging "
-            << temp_service->host_name << ":"
-            << temp_service->description << " by "
-            << nudge_seconds << " seconds...";
-          logger(log_runtime_warning, basic)
-            << "\tMax concurrent service checks ("
-            << currently_running_service_checks << "/"
-            << config->max_parallel_service_checks()
-            << ") has been reached.  Nudging "
-            << temp_service->host_name << ":"
-            << temp_service->description << " by "
-            << nudge_seconds << " seconds...";
-          run_event = false;
-        }
-
-        // Forced checks override normal check logic.
-        if (temp_service->check_options & CHECK_OPTION_FORCE_EXECUTION)
-          run_event = true;
-
-        // Reschedule the check if we can't run it now.
-        if (!run_event) {
+        // Don't run a service check if a concurrency limit is reached,
+        // it will be moved back as soon as a slot is released. Forced
+        // checks override normal check logic.
+        if (!checks::admission::instance().acquire(
+                   temp_service,
+                   temp_service->check_options
+                   & CHECK_OPTION_FORCE_EXECUTION)) {
           // Remove the service check from the event queue and
-          // reschedule it for a later time. Since event was not
-          // executed, it needs to be remove()'ed to maintain sync with
-          // event broker modules.
+          // reschedule it after the longest time a slot can be held.
+          // Since event was not executed, it needs to be remove()'ed
+          // to maintain sync with event broker modules.
           timed_event* temp_event(event_list_low);
           remove_event(
             temp_event,
             &event_list_low,
             &event_list_low_tail);
-
-          // We nudge the next check time when it is
-          // due to too many concurrent service checks.
-          if (nudge_seconds)
-            temp_service->next_check
-              = (time_t)(temp_service->next_check + nudge_seconds);
-          // Otherwise reschedule (TODO: This should be smarter as it
-          // doesn't consider its timeperiod).
-          else {
-            if ((SOFT_STATE == temp_service->state_type)
-                && (temp_service->current_state != STATE_OK))
-              temp_service->next_check
-                = (time_t)(temp_service->next_check
-                           + temp_service->retry_interval);
-            else
-              temp_service->next_check
-                = (time_t)(temp_service->next_check
-                           + temp_service->check_interval);
-          }
+          temp_service->next_check
+            = current_time + config->service_check_timeout().get();
           temp_event->run_time = temp_service->next_check;
           reschedule_event(temp_event, &event_list_low, &event_list_low_tail);
           update_service_status(temp_service);
@@ -370,11 +335,22 @@ void loop::_dispatching() {
           event_list_low->prev = NULL;
         quick_timed_event.erase(hash_timed_event::low, temp_event);
 
+        service* temp_service(
+                   (EVENT_SERVICE_CHECK == temp_event->event_type)
+                   ? static_cast<service*>(temp_event->event_data)
+                   : NULL);
+
         // Handle the event.
         logger(dbg_events, more)
           << "Running event...";
         handle_timed_event(temp_event);
 
+        // Give back the slots of an admitted check that did not start.
+        if (temp_service && !temp_service->is_executing)
+          checks::admission::instance().release(
+            temp_service->host_name,
+            temp_service->description);
+
         // Reschedule the event if necessary.
         if (temp_event->recurring)
           reschedule_event(
@@ -417,24 +393,28 @@ void loop::_dispatching() {
             NULL);
         }
 
-        // Set time to sleep so we don't hog the CPU...
-        timespec sleep_time;
-        sleep_time.tv_sec = (time_t)config->sleep_time();
-        sleep_time.tv_nsec
-          = (long)((config->sleep_time()
-                    - (double)sleep_time.tv_sec) * 1000000000ull);
-
-        // Populate fake "sleep" event.
-        _sleep_event.run_time = current_time;
-        _sleep_event.event_data = (void*)&sleep_time;
-
-        // Send event data to broker.
-        broker_timed_event(
-          NEBTYPE_TIMEDEVENT_SLEEP,
-          NEBFLAG_NONE,
-          NEBATTR_NONE,
-          &_sleep_event,
-          NULL);
+        // Only build the fake "sleep" event if someone listens.
+        if (neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA)) {
+          // Set time to sleep so we don't hog the CPU...
+          timespec sleep_time;
+          sleep_time.tv_sec = (time_t)config->sleep_time();
+          sleep_time.tv_nsec
+            = (long)((config->sleep_time()
+                      - (double)sleep_time.tv_sec) * 1000000000ull);
+
+          // Populate fake "sleep" event.
+          _sleep_event.run_time = current_time;
+          _sleep_event.event_data = (void*)&sleep_time;
+
+          // Send event data to broker.
+          broker_timed_event(
+            NEBTYPE_TIMEDEVENT_SLEEP,
+            NEBFLAG_NONE,
+            NEBATTR_NONE,
+            &_sleep_event,
+            NULL);
+          _sleep_event.event_data = NULL;
+        }
 
         // Wait a while so we don't hog the CPU...
         concurrency::thread::nsleep(
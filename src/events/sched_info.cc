@@ -54,6 +54,10 @@ void adjust_check_scheduling() {
   logger(dbg_functions, basic)
     << "adjust_check_scheduling()";
 
+  // Checks are spread as their results arrive.
+  if (config->use_load_aware_scheduling())
+    return;
+
   /* TODO:
      - Track host check overhead on a per-host basis
      - Figure out how to calculate service check overhead
@@ -641,29 +641,19 @@ void remove_event(
   else if (*event_list == event_list_high)
     quick_timed_event.erase(hash_timed_event::high, event);
 
-  if (*event_list == event) {
-    event->prev = NULL;
+  // Events know their predecessor, unlink them directly.
+  if (event->prev)
+    event->prev->next = event->next;
+  else if (*event_list == event)
     *event_list = event->next;
-    if (!(*event_list))
-      *event_list_tail = NULL;
-    else
-      (*event_list)->prev = NULL;
-  }
-
-  else {
-    for (timed_event* tmp(*event_list); tmp; tmp = tmp->next) {
-      if (tmp->next == event) {
-        tmp->next = tmp->next->next;
-        if (!tmp->next)
-          *event_list_tail = tmp;
-        else
-          tmp->next->prev = tmp;
-        event->next = NULL;
-        event->prev = NULL;
-        break;
-      }
-    }
-  }
+  else
+    return;
+  if (event->next)
+    event->next->prev = event->prev;
+  else
+    *event_list_tail = event->prev;
+  event->next = NULL;
+  event->prev = NULL;
   return;
 }
 
@@ -882,14 +872,15 @@ bool operator==(
   if (is_not_null && obj1.event_type == EVENT_HOST_CHECK) {
     host& hst1(*(host*)obj1.event_data);
     host& hst2(*(host*)obj2.event_data);
-    if (strcmp(hst1.name, hst2.name))
+    // Names are interned, compare addresses.
+    if (hst1.name != hst2.name)
       return (false);
   }
   else if (is_not_null && obj1.event_type == EVENT_SERVICE_CHECK) {
     service& svc1(*(service*)obj1.event_data);
     service& svc2(*(service*)obj2.event_data);
-    if (strcmp(svc1.host_name, svc2.host_name)
-        || strcmp(svc1.description, svc2.description))
+    if ((svc1.host_name != svc2.host_name)
+        || (svc1.description != svc2.description))
       return (false);
   }
   else if (obj1.event_data != obj2.event_data)
@@ -108,6 +108,7 @@ unsigned int        log_initial_states(false);
 unsigned int        log_passive_checks(true);
 unsigned int        log_service_retries(false);
 unsigned int        max_parallel_service_checks(0);
+unsigned int        neb_callback_bitmap[NEB_CALLBACK_BITMAP_SIZE];
 unsigned int        obsess_over_hosts(false);
 unsigned int        obsess_over_services(false);
 unsigned int        ochp_timeout(15);
@@ -22,6 +22,7 @@
 #include <cstdlib>
 #include <iomanip>
 #include <sstream>
+#include "com/centreon/engine/deleter/customvariablesmember.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
@@ -32,6 +33,29 @@
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
+/**
+ *  Get the value of a custom variable of an object.
+ *
+ *  @param[in]  name    Custom variable name, without object prefix.
+ *  @param[in]  vars    Custom variables of the object.
+ *  @param[in]  index   Custom variables index of the object, if any.
+ *  @param[out] output  Custom variable value.
+ *
+ *  @return OK if the custom variable was found, ERROR otherwise.
+ */
+static int grab_custom_indexed_macro_r(
+             char const* name,
+             customvariablesmember* vars,
+             customvariablesindex_struct const* index,
+             char** output) {
+  customvariablesmember* m(find_customvariable(vars, index, name));
+  if (!m)
+    return (ERROR);
+  if (m->variable_value)
+    *output = string::dup(m->variable_value);
+  return (OK);
+}
+
 /******************************************************************/
 /******************* MACRO GENERATION FUNCTIONS *******************/
 /******************************************************************/
@@ -61,10 +85,10 @@ int grab_custom_macro_value_r(
       return (ERROR);
 
     /* get the host macro value */
-    result = grab_custom_object_macro_r(
-               mac,
+    result = grab_custom_indexed_macro_r(
                macro_name + 5,
                temp_host->custom_variables,
+               temp_host->custom_variables_index,
                output);
   }
   /***** CUSTOM SERVICE MACRO *****/
@@ -77,10 +101,10 @@ int grab_custom_macro_value_r(
         return (ERROR);
 
       /* get the service macro value */
-      result = grab_custom_object_macro_r(
-                 mac,
+      result = grab_custom_indexed_macro_r(
                  macro_name + 8,
                  temp_service->custom_variables,
+                 temp_service->custom_variables_index,
                  output);
     }
     /* else and ondemand macro... */
@@ -95,10 +119,10 @@ int grab_custom_macro_value_r(
         return (ERROR);
 
       /* get the service macro value */
-      result = grab_custom_object_macro_r(
-                 mac,
+      result = grab_custom_indexed_macro_r(
                  macro_name + 8,
                  temp_service->custom_variables,
+                 temp_service->custom_variables_index,
                  output);
     }
   }
@@ -189,30 +213,11 @@ int grab_custom_object_macro_r(
       char* macro_name,
       customvariablesmember* vars,
       char** output) {
-  customvariablesmember* temp_customvariablesmember = NULL;
-  int result = ERROR;
-
   (void)mac;
 
   if (macro_name == NULL || vars == NULL || output == NULL)
     return (ERROR);
-
-  /* get the custom variable */
-  for (temp_customvariablesmember = vars;
-       temp_customvariablesmember != NULL;
-       temp_customvariablesmember = temp_customvariablesmember->next) {
-
-    if (temp_customvariablesmember->variable_name == NULL)
-      continue;
-
-    if (!strcmp(macro_name, temp_customvariablesmember->variable_name)) {
-      if (temp_customvariablesmember->variable_value)
-        *output = string::dup(temp_customvariablesmember->variable_value);
-      result = OK;
-      break;
-    }
-  }
-  return (result);
+  return (grab_custom_indexed_macro_r(macro_name, vars, NULL, output));
 }
 
 /******************************************************************/
@@ -499,9 +504,7 @@ int clear_volatile_macros_r(nagios_macros* mac) {
        this_customvariablesmember != NULL;
        this_customvariablesmember = next_customvariablesmember) {
     next_customvariablesmember = this_customvariablesmember->next;
-    delete[] this_customvariablesmember->variable_name;
-    delete[] this_customvariablesmember->variable_value;
-    delete this_customvariablesmember;
+    deleter::customvariablesmember(this_customvariablesmember);
   }
   mac->custom_host_vars = NULL;
 
@@ -510,9 +513,7 @@ int clear_volatile_macros_r(nagios_macros* mac) {
        this_customvariablesmember != NULL;
        this_customvariablesmember = next_customvariablesmember) {
     next_customvariablesmember = this_customvariablesmember->next;
-    delete[] this_customvariablesmember->variable_name;
-    delete[] this_customvariablesmember->variable_value;
-    delete this_customvariablesmember;
+    deleter::customvariablesmember(this_customvariablesmember);
   }
   mac->custom_service_vars = NULL;
 
@@ -18,10 +18,13 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/deleter/customvariablesmember.hh"
 #include "com/centreon/engine/macros/clear_service.hh"
 #include "com/centreon/engine/macros/defines.hh"
 #include "com/centreon/engine/macros/misc.hh"
 
+using namespace com::centreon::engine;
+
 extern "C" {
 
 /**
@@ -75,9 +78,7 @@ int clear_service_macros_r(nagios_macros* mac) {
        it != NULL;
        it = next) {
     next = it->next;
-    delete[] it->variable_name;
-    delete[] it->variable_value;
-    delete it;
+    deleter::customvariablesmember(it);
   }
 
   // Clear pointers.
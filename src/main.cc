@@ -38,10 +38,16 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/broker/compatibility.hh"
 #include "com/centreon/engine/broker/loader.hh"
+#include "com/centreon/engine/checks/admission.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
+#include "com/centreon/engine/commands/handler_runner.hh"
+#include "com/centreon/engine/commands/native_pool.hh"
+#include "com/centreon/engine/commands/reactor.hh"
 #include "com/centreon/engine/commands/set.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/diagnostic.hh"
@@ -112,7 +118,12 @@ int main(int argc, char* argv[]) {
   com::centreon::engine::timezone_manager::load();
   com::centreon::engine::commands::set::load();
   com::centreon::engine::configuration::applier::state::load();
+  com::centreon::engine::checks::admission::load();
+  com::centreon::engine::checks::parallelism::load();
   com::centreon::engine::checks::checker::load();
+  com::centreon::engine::commands::handler_runner::load();
+  com::centreon::engine::commands::native_pool::load();
+  com::centreon::engine::commands::reactor::load();
   com::centreon::engine::events::loop::load();
   com::centreon::engine::broker::loader::load();
   com::centreon::engine::broker::compatibility::load();
@@ -255,6 +266,7 @@ int main(int argc, char* argv[]) {
         // resource and object config files).
         configuration::state config;
         {
+          configuration::load_stats::begin(false);
           configuration::parser p;
           p.parse(config_file, config);
         }
@@ -292,6 +304,7 @@ int main(int argc, char* argv[]) {
         // Parse configuration.
         configuration::state config;
         {
+          configuration::load_stats::begin(false);
           configuration::parser p;
           p.parse(config_file, config);
         }
@@ -299,6 +312,7 @@ int main(int argc, char* argv[]) {
         // Parse retention.
         retention::state state;
         if (!config.state_retention_file().empty()) {
+          configuration::load_stats::phase("parse retention");
           retention::parser p;
           try {
             p.parse(config.state_retention_file(), state);
@@ -333,6 +347,7 @@ int main(int argc, char* argv[]) {
         // Parse configuration.
         configuration::state config;
         {
+          configuration::load_stats::begin(false);
           configuration::parser p;
           p.parse(config_file, config);
         }
@@ -340,6 +355,7 @@ int main(int argc, char* argv[]) {
         // Parse retention.
         retention::state state;
         {
+          configuration::load_stats::phase("parse retention");
           retention::parser p;
           try {
             p.parse(config.state_retention_file(), state);
@@ -489,7 +505,12 @@ int main(int argc, char* argv[]) {
   com::centreon::engine::broker::loader::unload();
   com::centreon::engine::configuration::applier::state::unload();
   com::centreon::engine::commands::set::unload();
+  com::centreon::engine::commands::reactor::unload();
+  com::centreon::engine::commands::native_pool::unload();
+  com::centreon::engine::commands::handler_runner::unload();
   com::centreon::engine::checks::checker::unload();
+  com::centreon::engine::checks::parallelism::unload();
+  com::centreon::engine::checks::admission::unload();
   delete config;
   config = NULL;
   com::centreon::engine::timezone_manager::unload();
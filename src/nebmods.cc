@@ -21,6 +21,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include "com/centreon/engine/broker/callback_stats.hh"
 #include "com/centreon/engine/broker/handle.hh"
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/globals.hh"
@@ -289,6 +290,16 @@ int neb_set_module_info(void* handle, int type, char const* data) {
 /****************************************************************************/
 /****************************************************************************/
 
+/* update subscription bit of a callback type */
+static void neb_update_callback_bitmap(int callback_type) {
+  unsigned int mask(1u << (callback_type % 32));
+  if (neb_callback_list[callback_type])
+    neb_callback_bitmap[callback_type / 32] |= mask;
+  else
+    neb_callback_bitmap[callback_type / 32] &= ~mask;
+  return;
+}
+
 /* allows a module to register a callback function */
 int neb_register_callback(
       int callback_type,
@@ -318,6 +329,11 @@ int neb_register_callback(
   new_callback->priority = priority;
   new_callback->module_handle = (void*)mod_handle;
   new_callback->callback_func = callback.data;
+  new_callback->stats.calls = 0;
+  new_callback->stats.cancels = 0;
+  new_callback->stats.max_ticks = 0;
+  new_callback->stats.overrides = 0;
+  new_callback->stats.total_ticks = 0;
 
   /* add new function to callback list, sorted by priority (first come, first served for same priority) */
   new_callback->next = NULL;
@@ -344,6 +360,7 @@ int neb_register_callback(
       }
     }
   }
+  neb_update_callback_bitmap(callback_type);
   return (OK);
 }
 
@@ -416,13 +433,14 @@ int neb_deregister_callback(
     return (NEBERROR_CALLBACKNOTFOUND);
 
   else {
-    /* only one item in the list */
+    /* first item in the list */
     if (temp_callback != last_callback->next)
-      neb_callback_list[callback_type] = NULL;
+      neb_callback_list[callback_type] = next_callback;
     else
       last_callback->next = next_callback;
     delete temp_callback;
   }
+  neb_update_callback_bitmap(callback_type);
 
   return (OK);
 }
@@ -441,6 +459,9 @@ int neb_make_callbacks(int callback_type, void* data) {
   logger(dbg_eventbroker, more)
     << "Making callbacks (type " << callback_type << ")...";
 
+  /* measure callback cost if requested */
+  bool measure(config && config->enable_neb_callback_stats());
+
   /* make the callbacks... */
   for (temp_callback = neb_callback_list[callback_type];
        temp_callback != NULL;
@@ -452,7 +473,29 @@ int neb_make_callbacks(int callback_type, void* data) {
       void* data;
     } neb;
     neb.data = temp_callback->callback_func;
-    cbresult = (*neb.func)(callback_type, data);
+    if (!measure)
+      cbresult = (*neb.func)(callback_type, data);
+    else {
+      unsigned long long start(broker::callback_stats::ticks());
+      cbresult = (*neb.func)(callback_type, data);
+      unsigned long long elapsed(broker::callback_stats::ticks() - start);
+
+      /* the callback might have deregistered itself */
+      nebcallback* cb(neb_callback_list[callback_type]);
+      while (cb && cb != temp_callback)
+        cb = cb->next;
+      if (cb) {
+        nebcallback_stats& stats(cb->stats);
+        ++stats.calls;
+        stats.total_ticks += elapsed;
+        if (elapsed > stats.max_ticks)
+          stats.max_ticks = elapsed;
+        if (cbresult == NEBERROR_CALLBACKCANCEL)
+          ++stats.cancels;
+        else if (cbresult == NEBERROR_CALLBACKOVERRIDE)
+          ++stats.overrides;
+      }
+    }
 
     temp_callback = next_callback;
 
@@ -479,6 +522,8 @@ int neb_init_callback_list() {
   /* initialize list pointers */
   for (int x = 0; x < NEBCALLBACK_NUMITEMS; x++)
     neb_callback_list[x] = NULL;
+  for (int x = 0; x < NEB_CALLBACK_BITMAP_SIZE; x++)
+    neb_callback_bitmap[x] = 0;
   return (OK);
 }
 
@@ -497,6 +542,8 @@ int neb_free_callback_list() {
 
     neb_callback_list[x] = NULL;
   }
+  for (int x = 0; x < NEB_CALLBACK_BITMAP_SIZE; x++)
+    neb_callback_bitmap[x] = 0;
 
   return (OK);
 }
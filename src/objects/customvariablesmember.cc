@@ -17,10 +17,13 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstring>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/deleter/customvariablesmember.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/tool.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/string.hh"
@@ -30,6 +33,34 @@ using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::string;
 
+/**
+ *  Order custom variables by name.
+ *
+ *  @param[in] m1  First custom variable.
+ *  @param[in] m2  Second custom variable.
+ *
+ *  @return True if m1 name is lower than m2 name.
+ */
+static bool name_less(
+              customvariablesmember const* m1,
+              customvariablesmember const* m2) {
+  return (strcmp(m1->variable_name, m2->variable_name) < 0);
+}
+
+/**
+ *  Check whether two custom variables have the same name.
+ *
+ *  @param[in] m1  First custom variable.
+ *  @param[in] m2  Second custom variable.
+ *
+ *  @return True if both names are equal.
+ */
+static bool name_equal(
+              customvariablesmember const* m1,
+              customvariablesmember const* m2) {
+  return (!strcmp(m1->variable_name, m2->variable_name));
+}
+
 /**
  *  Equal operator.
  *
@@ -119,6 +150,10 @@ customvariablesmember* add_custom_variable_to_host(
                                   varname,
                                   varvalue));
 
+  // The index does not know the new member, lookups will walk the
+  // list until the index is rebuilt.
+  unindex_customvariables(hst->custom_variables_index);
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(NULL));
   broker_custom_variable(
@@ -159,7 +194,7 @@ customvariablesmember* add_custom_variable_to_object(
   }
 
   // Allocate memory for a new member.
-  customvariablesmember* obj(new customvariablesmember);
+  customvariablesmember* obj(node_pool<customvariablesmember>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -198,6 +233,10 @@ customvariablesmember* add_custom_variable_to_service(
                                   varname,
                                   varvalue));
 
+  // The index does not know the new member, lookups will walk the
+  // list until the index is rebuilt.
+  unindex_customvariables(svc->custom_variables_index);
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(NULL));
   broker_custom_variable(
@@ -219,6 +258,7 @@ customvariablesmember* add_custom_variable_to_service(
  */
 void remove_all_custom_variables_from_host(host_struct* hst) {
   // Browse all custom vars.
+  unindex_customvariables(hst->custom_variables_index);
   customvariablesmember* m(hst->custom_variables);
   hst->custom_variables = NULL;
   while (m) {
@@ -250,6 +290,7 @@ void remove_all_custom_variables_from_host(host_struct* hst) {
  */
 void remove_all_custom_variables_from_service(service_struct* svc) {
   // Browse all custom vars.
+  unindex_customvariables(svc->custom_variables_index);
   customvariablesmember* m(svc->custom_variables);
   svc->custom_variables = NULL;
   while (m) {
@@ -274,6 +315,81 @@ void remove_all_custom_variables_from_service(service_struct* svc) {
   return ;
 }
 
+/**
+ *  Find a custom variable by name.
+ *
+ *  @param[in] lst    The custom variables list.
+ *  @param[in] index  Index of lst, if any. Without index the list is
+ *                    walked.
+ *  @param[in] name   Custom variable name.
+ *
+ *  @return The custom variable if found, NULL otherwise.
+ */
+customvariablesmember* engine::find_customvariable(
+                         customvariablesmember* lst,
+                         customvariablesindex_struct const* index,
+                         char const* name) {
+  if (!index) {
+    for (customvariablesmember* m(lst); m; m = m->next)
+      if (m->variable_name && !strcmp(name, m->variable_name))
+        return (m);
+    return (NULL);
+  }
+
+  // Binary search in the sorted index.
+  std::vector<customvariablesmember*> const& members(index->members);
+  size_t low(0);
+  size_t high(members.size());
+  while (low < high) {
+    size_t middle(low + (high - low) / 2);
+    int cmp(strcmp(name, members[middle]->variable_name));
+    if (!cmp)
+      return (members[middle]);
+    if (cmp < 0)
+      high = middle;
+    else
+      low = middle + 1;
+  }
+  return (NULL);
+}
+
+/**
+ *  Build the lookup index of a custom variable list. When a name
+ *  appears several times, the first member of the list is kept, as
+ *  with a list walk.
+ *
+ *  @param[in,out] index  Index to (re)build.
+ *  @param[in]     lst    The custom variables list.
+ */
+void engine::index_customvariables(
+               customvariablesindex_struct*& index,
+               customvariablesmember* lst) {
+  if (!index)
+    index = new customvariablesindex_struct;
+  std::vector<customvariablesmember*>& members(index->members);
+  members.clear();
+  for (customvariablesmember* m(lst); m; m = m->next)
+    if (m->variable_name)
+      members.push_back(m);
+  std::stable_sort(members.begin(), members.end(), &name_less);
+  members.erase(
+            std::unique(members.begin(), members.end(), &name_equal),
+            members.end());
+  return ;
+}
+
+/**
+ *  Release the lookup index of a custom variable list.
+ *
+ *  @param[in,out] index  Index to release, set to NULL.
+ */
+void engine::unindex_customvariables(
+               customvariablesindex_struct*& index) throw () {
+  delete index;
+  index = NULL;
+  return ;
+}
+
 /**
  *  Update the custom variable value.
  *
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/deleter/daterange.hh"
 #include "com/centreon/engine/objects/daterange.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timerange.hh"
 #include "com/centreon/engine/objects/tool.hh"
@@ -290,7 +291,7 @@ daterange* add_exception_to_timeperiod(
     return (NULL);
 
   // Allocate memory for the date range range.
-  daterange* obj(new daterange);
+  daterange* obj(node_pool<daterange>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -27,6 +27,7 @@
 #include "com/centreon/engine/objects/customvariablesmember.hh"
 #include "com/centreon/engine/objects/host.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
 #include "com/centreon/engine/objects/tool.hh"
 #include "com/centreon/engine/shared.hh"
@@ -94,6 +95,7 @@ bool operator==(
           && obj1.last_problem_id == obj2.last_problem_id
           && obj1.latency == obj2.latency
           && obj1.execution_time == obj2.execution_time
+          && obj1.average_execution_time == obj2.average_execution_time
           && obj1.is_executing == obj2.is_executing
           && obj1.check_options == obj2.check_options
           && obj1.next_check == obj2.next_check
@@ -194,6 +196,7 @@ std::ostream& operator<<(std::ostream& os, host const& obj) {
     "  last_problem_id:                      " << obj.last_problem_id << "\n"
     "  latency:                              " << obj.latency << "\n"
     "  execution_time:                       " << obj.execution_time << "\n"
+    "  average_execution_time:               " << obj.average_execution_time << "\n"
     "  is_executing:                         " << obj.is_executing << "\n"
     "  check_options:                        " << obj.check_options << "\n"
     "  next_check:                           " << string::ctime(obj.next_check) << "\n"
@@ -297,115 +300,32 @@ host* add_host(
         int should_be_drawn,
         int obsess_over_host,
         char const* timezone) {
-  // Make sure we have the data we need.
-  if (!name || !name[0] || !address || !address[0]) {
-    logger(log_config_error, basic)
-      << "Error: Host name or address is NULL";
-    return (NULL);
-  }
-  if (max_attempts <= 0) {
-    logger(log_config_error, basic)
-      << "Error: Invalid max_check_attempts value for host '"
-      << name << "'";
-    return (NULL);
-  }
-  if (check_interval < 0) {
-    logger(log_config_error, basic)
-      << "Error: Invalid check_interval value for host '"
-      << name << "'";
-    return (NULL);
-  }
-  if (freshness_threshold < 0) {
-    logger(log_config_error, basic)
-      << "Error: Invalid freshness_threshold value for host '"
-      << name << "'";
-    return (NULL);
-  }
-
-  // Check if the host is already exist.
-  std::string id(name);
-  if (is_host_exist(id)) {
-    logger(log_config_error, basic)
-      << "Error: Host '" << name << "' has already been defined";
-    return (NULL);
-  }
-
-  // Allocate memory for a new host.
-  shared_ptr<host> obj(new host, deleter::host);
-  memset(obj.get(), 0, sizeof(*obj));
-
-  try {
-    // Duplicate string vars.
-    obj->id = host_id;
-    obj->name = string::dup(name);
-    obj->address = string::dup(address);
-    obj->alias = string::dup(alias ? alias : name);
-    if (check_period)
-      obj->check_period = string::dup(check_period);
-    if (event_handler)
-      obj->event_handler = string::dup(event_handler);
-    if (check_command)
-      obj->host_check_command = string::dup(check_command);
-    if (timezone)
-      obj->timezone = string::dup(timezone);
-
-    // Duplicate non-string vars.
-    obj->check_freshness = (check_freshness > 0);
-    obj->check_interval = check_interval;
-    obj->check_options = CHECK_OPTION_NONE;
-    obj->check_type = HOST_CHECK_ACTIVE;
-    obj->checks_enabled = (checks_enabled > 0);
-    obj->check_timeout = check_timeout;
-    obj->current_attempt = (initial_state == HOST_UP) ? 1 : max_attempts;
-    obj->current_state = initial_state;
-    obj->event_handler_enabled = (event_handler_enabled > 0);
-    obj->flap_detection_enabled = (flap_detection_enabled > 0);
-    obj->flap_detection_on_down = (flap_detection_on_down > 0);
-    obj->flap_detection_on_unreachable = (flap_detection_on_unreachable > 0);
-    obj->flap_detection_on_up = (flap_detection_on_up > 0);
-    obj->freshness_threshold = freshness_threshold;
-    obj->high_flap_threshold = high_flap_threshold;
-    obj->initial_state = initial_state;
-    obj->last_hard_state = initial_state;
-    obj->last_state = initial_state;
-    obj->low_flap_threshold = low_flap_threshold;
-    obj->max_attempts = max_attempts;
-    obj->modified_attributes = MODATTR_NONE;
-    obj->obsess_over_host = (obsess_over_host > 0);
-    obj->retry_interval = retry_interval;
-    obj->should_be_drawn = (should_be_drawn > 0);
-    obj->should_be_scheduled = true;
-    obj->state_type = HARD_STATE;
-
-    // STATE_OK = 0, so we don't need to set state_history (memset
-    // is used before).
-    // for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
-    //   obj->state_history[x] = STATE_OK;
-
-    // Add new items to the configuration state.
-    state::instance().hosts()[id] = obj;
-
-    // Add new items to the list.
-    obj->next = host_list;
-    host_list = obj.get();
-
-    // Notify event broker.
-    timeval tv(get_broker_timestamp(NULL));
-    broker_adaptive_host_data(
-      NEBTYPE_HOST_ADD,
-      NEBFLAG_NONE,
-      NEBATTR_NONE,
-      obj.get(),
-      CMD_NONE,
-      MODATTR_ALL,
-      MODATTR_ALL,
-      &tv);
-  }
-  catch (...) {
-    obj.clear();
-  }
-
-  return (obj.get());
+  return (register_host(create_host(
+            host_id,
+            name,
+            alias,
+            address,
+            check_period,
+            initial_state,
+            check_interval,
+            retry_interval,
+            max_attempts,
+            check_timeout,
+            check_command,
+            checks_enabled,
+            event_handler,
+            event_handler_enabled,
+            flap_detection_enabled,
+            low_flap_threshold,
+            high_flap_threshold,
+            flap_detection_on_up,
+            flap_detection_on_down,
+            flap_detection_on_unreachable,
+            check_freshness,
+            freshness_threshold,
+            should_be_drawn,
+            obsess_over_host,
+            timezone)));
 }
 
 /**
@@ -563,3 +483,172 @@ bool engine::is_host_exist(std::string const& name) throw () {
     it(state::instance().hosts().find(name));
   return (it != state::instance().hosts().end());
 }
+
+/**
+ *  Create a host definition. The host is neither checked nor
+ *  registered, see register_host(). Only its own memory is touched so
+ *  hosts can be created while the main loop runs.
+ *
+ *  Parameters are those of add_host().
+ *
+ *  @return New host, NULL on error.
+ */
+shared_ptr<host> engine::create_host(
+                   unsigned int host_id,
+                   char const* name,
+                   char const* alias,
+                   char const* address,
+                   char const* check_period,
+                   int initial_state,
+                   double check_interval,
+                   double retry_interval,
+                   int max_attempts,
+                   unsigned int check_timeout,
+                   char const* check_command,
+                   int checks_enabled,
+                   char const* event_handler,
+                   int event_handler_enabled,
+                   int flap_detection_enabled,
+                   double low_flap_threshold,
+                   double high_flap_threshold,
+                   int flap_detection_on_up,
+                   int flap_detection_on_down,
+                   int flap_detection_on_unreachable,
+                   int check_freshness,
+                   int freshness_threshold,
+                   int should_be_drawn,
+                   int obsess_over_host,
+                   char const* timezone) {
+  // Allocate memory for a new host.
+  shared_ptr<host> obj(new host, deleter::host);
+  memset(obj.get(), 0, sizeof(*obj));
+
+  try {
+    // Duplicate string vars.
+    obj->id = host_id;
+    obj->name = string::intern(name);
+    obj->address = string::dup(address);
+    obj->alias = string::dup(alias ? alias : name);
+    if (check_period)
+      obj->check_period = string::intern(check_period);
+    if (event_handler)
+      obj->event_handler = string::intern(event_handler);
+    if (check_command)
+      obj->host_check_command = string::intern(check_command);
+    if (timezone)
+      obj->timezone = string::dup(timezone);
+
+    // Duplicate non-string vars.
+    obj->check_freshness = (check_freshness > 0);
+    obj->check_interval = check_interval;
+    obj->check_options = CHECK_OPTION_NONE;
+    obj->check_type = HOST_CHECK_ACTIVE;
+    obj->checks_enabled = (checks_enabled > 0);
+    obj->check_timeout = check_timeout;
+    obj->current_attempt = (initial_state == HOST_UP) ? 1 : max_attempts;
+    obj->current_state = initial_state;
+    obj->event_handler_enabled = (event_handler_enabled > 0);
+    obj->flap_detection_enabled = (flap_detection_enabled > 0);
+    obj->flap_detection_on_down = (flap_detection_on_down > 0);
+    obj->flap_detection_on_unreachable = (flap_detection_on_unreachable > 0);
+    obj->flap_detection_on_up = (flap_detection_on_up > 0);
+    obj->freshness_threshold = freshness_threshold;
+    obj->high_flap_threshold = high_flap_threshold;
+    obj->initial_state = initial_state;
+    obj->last_hard_state = initial_state;
+    obj->last_state = initial_state;
+    obj->low_flap_threshold = low_flap_threshold;
+    obj->max_attempts = max_attempts;
+    obj->modified_attributes = MODATTR_NONE;
+    obj->obsess_over_host = (obsess_over_host > 0);
+    obj->retry_interval = retry_interval;
+    obj->should_be_drawn = (should_be_drawn > 0);
+    obj->should_be_scheduled = true;
+    obj->state_type = HARD_STATE;
+
+    // STATE_OK = 0, so we don't need to set state_history (memset
+    // is used before).
+    // for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    //   obj->state_history[x] = STATE_OK;
+  }
+  catch (...) {
+    obj.clear();
+  }
+
+  return (obj);
+}
+
+/**
+ *  Register a host created by create_host(): check its values, add it
+ *  to the host list and notify the event broker.
+ *
+ *  @param[in] obj  Host to register, can be NULL.
+ *
+ *  @return The registered host, NULL on error.
+ */
+host* engine::register_host(shared_ptr<host> const& obj) {
+  if (!obj)
+    return (NULL);
+
+  // Make sure we have the data we need.
+  if (!obj->name || !obj->name[0] || !obj->address || !obj->address[0]) {
+    logger(log_config_error, basic)
+      << "Error: Host name or address is NULL";
+    return (NULL);
+  }
+  if (obj->max_attempts <= 0) {
+    logger(log_config_error, basic)
+      << "Error: Invalid max_check_attempts value for host '"
+      << obj->name << "'";
+    return (NULL);
+  }
+  if (obj->check_interval < 0) {
+    logger(log_config_error, basic)
+      << "Error: Invalid check_interval value for host '"
+      << obj->name << "'";
+    return (NULL);
+  }
+  if (obj->freshness_threshold < 0) {
+    logger(log_config_error, basic)
+      << "Error: Invalid freshness_threshold value for host '"
+      << obj->name << "'";
+    return (NULL);
+  }
+
+  // Check if the host is already exist.
+  std::string id(obj->name);
+  if (is_host_exist(id)) {
+    logger(log_config_error, basic)
+      << "Error: Host '" << obj->name << "' has already been defined";
+    return (NULL);
+  }
+
+  try {
+    // Add new items to the configuration state.
+    state::instance().hosts()[id] = obj;
+
+    // Add new items to the list.
+    obj->next = host_list;
+    if (host_list)
+      host_list->prev = obj.get();
+    host_list = obj.get();
+    scheduling_table<host_struct>::add(obj.get());
+
+    // Notify event broker.
+    timeval tv(get_broker_timestamp(NULL));
+    broker_adaptive_host_data(
+      NEBTYPE_HOST_ADD,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      obj.get(),
+      CMD_NONE,
+      MODATTR_ALL,
+      MODATTR_ALL,
+      &tv);
+  }
+  catch (...) {
+    return (NULL);
+  }
+
+  return (obj.get());
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/deleter/hostsmember.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/tool.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/string.hh"
@@ -106,13 +107,13 @@ hostsmember* add_child_link_to_host(host* parent, host* child) {
     return (NULL);
 
   // Allocate memory.
-  hostsmember* obj(new hostsmember);
+  hostsmember* obj(node_pool<hostsmember>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
     // Initialize values.
     obj->host_ptr = child;
-    obj->host_name = string::dup(child->name);
+    obj->host_name = string::intern(child->name);
 
     // Add the child entry to the host definition.
     obj->next = parent->child_hosts;
@@ -165,12 +166,12 @@ hostsmember* add_parent_host_to_host(
   }
 
   // Allocate memory.
-  hostsmember* obj(new hostsmember);
+  hostsmember* obj(node_pool<hostsmember>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
     // Duplicate string vars.
-    obj->host_name = string::dup(host_name);
+    obj->host_name = string::intern(host_name);
 
     // Add the parent host entry to the host definition */
     obj->next = hst->parent_hosts;
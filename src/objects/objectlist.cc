@@ -21,6 +21,7 @@
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/deleter/objectlist.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
+#include "com/centreon/engine/objects/pool.hh"
 
 using namespace com::centreon::engine;
 
@@ -42,7 +43,7 @@ int add_object_to_objectlist(objectlist** list, void* ptr) {
       return (OK);
 
   // Allocate memory for a new list item.
-  objectlist* obj(new objectlist);
+  objectlist* obj(node_pool<objectlist>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -77,7 +78,7 @@ int free_objectlist(objectlist** list) {
        obj;
        obj = next_objectlist) {
     next_objectlist = obj->next;
-    delete obj;
+    deleter::objectlist(obj);
   }
   *list = NULL;
 
@@ -104,7 +105,7 @@ int remove_object_to_objectlist(objectlist** list, void* ptr) {
 	*list = obj->next;
       else
 	prev->next = obj->next;
-      delete obj;
+      deleter::objectlist(obj);
       return (OK);
     }
   }
@@ -25,6 +25,7 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/commandsmember.hh"
 #include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
 #include "com/centreon/engine/objects/service.hh"
 #include "com/centreon/engine/objects/tool.hh"
 #include "com/centreon/engine/shared.hh"
@@ -99,6 +100,7 @@ bool operator==(
           && obj1.is_being_freshened == obj2.is_being_freshened
           && obj1.latency == obj2.latency
           && obj1.execution_time == obj2.execution_time
+          && obj1.average_execution_time == obj2.average_execution_time
           && obj1.is_executing == obj2.is_executing
           && obj1.check_options == obj2.check_options
           && is_equal(obj1.state_history, obj2.state_history, MAX_STATE_HISTORY_ENTRIES)
@@ -198,6 +200,7 @@ std::ostream& operator<<(std::ostream& os, service const& obj) {
     "  is_being_freshened:                   " << obj.is_being_freshened << "\n"
     "  latency:                              " << obj.latency << "\n"
     "  execution_time:                       " << obj.execution_time << "\n"
+    "  average_execution_time:               " << obj.average_execution_time << "\n"
     "  is_executing:                         " << obj.is_executing << "\n"
     "  check_options:                        " << obj.check_options << "\n"
     "  timezone:                             " << chkstr(obj.timezone) << "\n";
@@ -291,40 +294,116 @@ service* add_service(
            int freshness_threshold,
            int obsess_over_service,
            char const* timezone) {
-  // Make sure we have everything we need.
-  if (!description || !description[0]) {
-    logger(log_config_error, basic)
-      << "Error: Service description is not set";
-    return (NULL);
-  }
-  else if (!host_name || !host_name[0]) {
-    logger(log_config_error, basic)
-      << "Error: Host name of service '"
-      << description << "' is not set";
-    return (NULL);
-  }
+  return (register_service(create_service(
+            host_id,
+            host_name,
+            service_id,
+            description,
+            check_period,
+            initial_state,
+            max_attempts,
+            check_timeout,
+            check_interval,
+            retry_interval,
+            is_volatile,
+            event_handler,
+            event_handler_enabled,
+            check_command,
+            checks_enabled,
+            flap_detection_enabled,
+            low_flap_threshold,
+            high_flap_threshold,
+            flap_detection_on_ok,
+            flap_detection_on_warning,
+            flap_detection_on_unknown,
+            flap_detection_on_critical,
+            check_freshness,
+            freshness_threshold,
+            obsess_over_service,
+            timezone)));
+}
 
-  // Check values.
-  if ((max_attempts <= 0)
-      || (check_interval < 0)
-      || (retry_interval < 0)) {
-    logger(log_config_error, basic)
-      << "Error: Invalid max_attempts, check_interval or retry_interval"
-         " value for service '"
-      << description << "' on host '" << host_name << "'";
-    return (NULL);
-  }
+/**
+ *  Get number of registered services.
+ *
+ *  @return Number of registered services.
+ */
+int get_service_count() {
+  return (state::instance().services().size());
+}
 
-  // Check if the service is already exist.
+/**
+ *  Get service by host name and service description.
+ *
+ *  @param[in] host_name           The host name.
+ *  @param[in] service_description The service_description.
+ *
+ *  @return The struct service or throw exception if the
+ *          service is not found.
+ */
+service& engine::find_service(
+           std::string const& host_name,
+           std::string const& service_description) {
   std::pair<std::string, std::string>
-    id(std::make_pair(host_name, description));
-  if (is_service_exist(id)) {
-    logger(log_config_error, basic)
-      << "Error: Service '" << description << "' on host '"
-      << host_name << "' has already been defined";
-    return (NULL);
-  }
+    id(std::make_pair(host_name, service_description));
+  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
+    it(state::instance().services().find(id));
+  if (it == state::instance().services().end())
+    throw (engine_error() << "Service '" << service_description
+           << "' on host '" << host_name << "' was not found");
+  return (*it->second);
+}
+
+/**
+ *  Get if service exist.
+ *
+ *  @param[in] id The service id.
+ *
+ *  @return True if the service is found, otherwise false.
+ */
+bool engine::is_service_exist(
+       std::pair<std::string, std::string> const& id) {
+  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
+    it(state::instance().services().find(id));
+  return (it != state::instance().services().end());
+}
 
+/**
+ *  Create a service definition. The service is neither checked nor
+ *  registered, see register_service(). Only its own memory is touched
+ *  so services can be created while the main loop runs.
+ *
+ *  Parameters are those of add_service().
+ *
+ *  @return New service, NULL on error.
+ */
+shared_ptr<service> engine::create_service(
+                      unsigned int host_id,
+                      char const* host_name,
+                      unsigned int service_id,
+                      char const* description,
+                      char const* check_period,
+                      int initial_state,
+                      int max_attempts,
+                      unsigned int check_timeout,
+                      double check_interval,
+                      double retry_interval,
+                      int is_volatile,
+                      char const* event_handler,
+                      int event_handler_enabled,
+                      char const* check_command,
+                      int checks_enabled,
+                      int flap_detection_enabled,
+                      double low_flap_threshold,
+                      double high_flap_threshold,
+                      int flap_detection_on_ok,
+                      int flap_detection_on_warning,
+                      int flap_detection_on_unknown,
+                      int flap_detection_on_critical,
+                      int check_freshness,
+                      int freshness_threshold,
+                      int obsess_over_service,
+                      char const* timezone) {
   // Allocate memory.
   shared_ptr<service> obj(new service, deleter::service);
   memset(obj.get(), 0, sizeof(*obj));
@@ -332,14 +411,14 @@ service* add_service(
   try {
     // Duplicate vars.
     obj->host_id = host_id;
-    obj->host_name = string::dup(host_name);
+    obj->host_name = string::intern(host_name);
     obj->id = service_id;
-    obj->description = string::dup(description);
-    obj->service_check_command = string::dup(check_command);
+    obj->description = string::intern(description);
+    obj->service_check_command = string::intern(check_command);
     if (event_handler)
-      obj->event_handler = string::dup(event_handler);
+      obj->event_handler = string::intern(event_handler);
     if (check_period)
-      obj->check_period = string::dup(check_period);
+      obj->check_period = string::intern(check_period);
     if (timezone)
       obj->timezone = string::dup(timezone);
 
@@ -375,13 +454,70 @@ service* add_service(
     // is used before).
     // for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
     //   obj->state_history[x] = STATE_OK;
+  }
+  catch (...) {
+    obj.clear();
+  }
 
+  return (obj);
+}
+
+/**
+ *  Register a service created by create_service(): check its values,
+ *  add it to the service list and notify the event broker.
+ *
+ *  @param[in] obj  Service to register, can be NULL.
+ *
+ *  @return The registered service, NULL on error.
+ */
+service* engine::register_service(shared_ptr<service> const& obj) {
+  if (!obj)
+    return (NULL);
+
+  // Make sure we have everything we need.
+  if (!obj->description || !obj->description[0]) {
+    logger(log_config_error, basic)
+      << "Error: Service description is not set";
+    return (NULL);
+  }
+  else if (!obj->host_name || !obj->host_name[0]) {
+    logger(log_config_error, basic)
+      << "Error: Host name of service '"
+      << obj->description << "' is not set";
+    return (NULL);
+  }
+
+  // Check values.
+  if ((obj->max_attempts <= 0)
+      || (obj->check_interval < 0)
+      || (obj->retry_interval < 0)) {
+    logger(log_config_error, basic)
+      << "Error: Invalid max_attempts, check_interval or retry_interval"
+         " value for service '"
+      << obj->description << "' on host '" << obj->host_name << "'";
+    return (NULL);
+  }
+
+  // Check if the service is already exist.
+  std::pair<std::string, std::string>
+    id(std::make_pair(obj->host_name, obj->description));
+  if (is_service_exist(id)) {
+    logger(log_config_error, basic)
+      << "Error: Service '" << obj->description << "' on host '"
+      << obj->host_name << "' has already been defined";
+    return (NULL);
+  }
+
+  try {
     // Add new items to the configuration state.
     state::instance().services()[id] = obj;
 
     // Add new items to the list.
     obj->next = service_list;
+    if (service_list)
+      service_list->prev = obj.get();
     service_list = obj.get();
+    scheduling_table<service_struct>::add(obj.get());
 
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
@@ -396,53 +532,8 @@ service* add_service(
       &tv);
   }
   catch (...) {
-    obj.clear();
+    return (NULL);
   }
 
   return (obj.get());
 }
-
-/**
- *  Get number of registered services.
- *
- *  @return Number of registered services.
- */
-int get_service_count() {
-  return (state::instance().services().size());
-}
-
-/**
- *  Get service by host name and service description.
- *
- *  @param[in] host_name           The host name.
- *  @param[in] service_description The service_description.
- *
- *  @return The struct service or throw exception if the
- *          service is not found.
- */
-service& engine::find_service(
-           std::string const& host_name,
-           std::string const& service_description) {
-  std::pair<std::string, std::string>
-    id(std::make_pair(host_name, service_description));
-  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
-    it(state::instance().services().find(id));
-  if (it == state::instance().services().end())
-    throw (engine_error() << "Service '" << service_description
-           << "' on host '" << host_name << "' was not found");
-  return (*it->second);
-}
-
-/**
- *  Get if service exist.
- *
- *  @param[in] id The service id.
- *
- *  @return True if the service is found, otherwise false.
- */
-bool engine::is_service_exist(
-       std::pair<std::string, std::string> const& id) {
-  umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::const_iterator
-    it(state::instance().services().find(id));
-  return (it != state::instance().services().end());
-}
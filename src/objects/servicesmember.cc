@@ -21,6 +21,7 @@
 #include "com/centreon/engine/deleter/servicesmember.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/service.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
 #include "com/centreon/engine/objects/tool.hh"
@@ -94,7 +95,7 @@ servicesmember* add_service_link_to_host(host* hst, service* svc) {
     return (NULL);
 
   // Allocate memory.
-  servicesmember* obj(new servicesmember);
+  servicesmember* obj(node_pool<servicesmember>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/deleter/timeperiodexclusion.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/tool.hh"
@@ -90,7 +91,7 @@ timeperiodexclusion* add_exclusion_to_timeperiod(
     return (NULL);
 
   // Allocate memory.
-  timeperiodexclusion* obj(new timeperiodexclusion);
+  timeperiodexclusion* obj(node_pool<timeperiodexclusion>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
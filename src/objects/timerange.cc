@@ -21,6 +21,7 @@
 #include "com/centreon/engine/deleter/timerange.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/daterange.hh"
+#include "com/centreon/engine/objects/pool.hh"
 #include "com/centreon/engine/objects/timerange.hh"
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/string.hh"
@@ -117,7 +118,7 @@ timerange* add_timerange_to_daterange(
   }
 
   // Allocate memory for the new time range.
-  timerange* obj(new timerange);
+  timerange* obj(node_pool<timerange>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -183,7 +184,7 @@ timerange* add_timerange_to_timeperiod(
   }
 
   // Allocate memory for the new time range.
-  timerange* obj(new timerange);
+  timerange* obj(node_pool<timerange>::allocate());
   memset(obj, 0, sizeof(*obj));
 
   try {
@@ -144,7 +144,7 @@ void applier::host::_update(
   if (state.check_command().is_set()
       && (obj.modified_attributes & MODATTR_CHECK_COMMAND)) {
     if (utils::is_command_exist(*state.check_command()))
-      string::setstr(obj.host_check_command, *state.check_command());
+      string::setintern(obj.host_check_command, *state.check_command());
     else
       obj.modified_attributes -= MODATTR_CHECK_COMMAND;
   }
@@ -152,7 +152,7 @@ void applier::host::_update(
   if (state.check_period().is_set()
       && (obj.modified_attributes & MODATTR_CHECK_TIMEPERIOD)) {
     if (is_timeperiod_exist(*state.check_period()))
-      string::setstr(obj.check_period, *state.check_period());
+      string::setintern(obj.check_period, *state.check_period());
     else
       obj.modified_attributes -= MODATTR_CHECK_TIMEPERIOD;
   }
@@ -160,7 +160,7 @@ void applier::host::_update(
   if (state.event_handler().is_set()
       && (obj.modified_attributes & MODATTR_EVENT_HANDLER_COMMAND)) {
     if (utils::is_command_exist(*state.event_handler()))
-      string::setstr(obj.host_check_command, *state.event_handler());
+      string::setintern(obj.event_handler, *state.event_handler());
     else
       obj.modified_attributes -= MODATTR_CHECK_COMMAND;
   }
@@ -148,7 +148,7 @@ void applier::service::_update(
   if (state.check_command().is_set()
       && (obj.modified_attributes & MODATTR_CHECK_COMMAND)) {
     if (utils::is_command_exist(*state.check_command()))
-      string::setstr(obj.service_check_command, *state.check_command());
+      string::setintern(obj.service_check_command, *state.check_command());
     else
       obj.modified_attributes -= MODATTR_CHECK_COMMAND;
   }
@@ -156,7 +156,7 @@ void applier::service::_update(
   if (state.check_period().is_set()
       && (obj.modified_attributes & MODATTR_CHECK_TIMEPERIOD)) {
     if (is_timeperiod_exist(*state.check_period()))
-      string::setstr(obj.check_period, *state.check_period());
+      string::setintern(obj.check_period, *state.check_period());
     else
       obj.modified_attributes -= MODATTR_CHECK_TIMEPERIOD;
   }
@@ -164,7 +164,7 @@ void applier::service::_update(
   if (state.event_handler().is_set()
       && (obj.modified_attributes & MODATTR_EVENT_HANDLER_COMMAND)) {
     if (utils::is_command_exist(*state.event_handler()))
-      string::setstr(obj.event_handler, *state.event_handler());
+      string::setintern(obj.event_handler, *state.event_handler());
     else
       obj.modified_attributes -= MODATTR_EVENT_HANDLER_COMMAND;
   }
@@ -19,7 +19,10 @@
 */
 
 #include <sstream>
+#include <string>
+#include <sys/time.h>
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/handler_runner.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -28,6 +31,7 @@
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/utils.hh"
 
+using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
 /******************************************************************/
@@ -39,8 +43,6 @@ int obsessive_compulsive_service_check_processor(service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   host* temp_host = NULL;
-  int early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros mac;
 
@@ -99,32 +101,20 @@ int obsessive_compulsive_service_check_processor(service* svc) {
     << "Processed obsessive compulsive service "
     "processor command line: " << processed_command;
 
-  /* run the command */
-  try {
-      my_system_r(
-      &mac,
-      processed_command,
-      config->ocsp_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute compulsive service processor command line '"
-      << processed_command << "' : " << e.what();
-  }
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  gettimeofday(&j.start_time, NULL);
+  j.timeout = config->ocsp_timeout();
+  std::ostringstream oss;
+  oss << "OCSP command '" << processed_command
+      << "' for service '" << svc->description << "' on host '"
+      << svc->host_name << "'";
+  j.timeout_message = oss.str();
+  commands::handler_runner::instance().run(j);
 
   clear_volatile_macros_r(&mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: OCSP command '" << processed_command
-      << "' for service '" << svc->description << "' on host '"
-      << svc->host_name << "' timed out after "
-      << config->ocsp_timeout() << " seconds";
-
   /* free memory */
   delete[] raw_command;
   delete[] processed_command;
@@ -136,8 +126,6 @@ int obsessive_compulsive_service_check_processor(service* svc) {
 int obsessive_compulsive_host_check_processor(host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros mac;
 
@@ -191,29 +179,18 @@ int obsessive_compulsive_host_check_processor(host* hst) {
     << "Processed obsessive compulsive host processor "
     "command line: " << processed_command;
 
-  /* run the command */
-  try {
-    my_system_r(
-      &mac,
-      processed_command,
-      config->ochp_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute compulsive host processor command line '"
-      << processed_command << "' : " << e.what();
-  }
-  clear_volatile_macros_r(&mac);
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  gettimeofday(&j.start_time, NULL);
+  j.timeout = config->ochp_timeout();
+  std::ostringstream oss;
+  oss << "OCHP command '" << processed_command
+      << "' for host '" << hst->name << "'";
+  j.timeout_message = oss.str();
+  commands::handler_runner::instance().run(j);
 
-  /* check to see if the command timed out */
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: OCHP command '" << processed_command
-      << "' for host '" << hst->name << "' timed out after "
-      << config->ochp_timeout() << " seconds";
+  clear_volatile_macros_r(&mac);
 
   /* free memory */
   delete[] raw_command;
@@ -292,7 +269,6 @@ int run_global_service_event_handler(nagios_macros* mac, service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -391,55 +367,22 @@ int run_global_service_event_handler(nagios_macros* mac, service* svc) {
     return ((neb_result == NEBERROR_CALLBACKCANCEL) ? ERROR : OK);
   }
 
-  /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute global service event handler "
-         "command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Global service event handler command '"
-      << processed_command << "' timed out after "
-      << config->event_handler_timeout() << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    GLOBAL_SERVICE_EVENTHANDLER,
-    (void*)svc,
-    svc->current_state,
-    svc->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    config->global_service_event_handler().c_str(),
-    processed_command,
-    command_output,
-    NULL);
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  j.command_name = config->global_service_event_handler().c_str();
+  j.handler_type = GLOBAL_SERVICE_EVENTHANDLER;
+  j.host_name = svc->host_name;
+  j.service_description = svc->description;
+  j.start_time = start_time;
+  j.state = svc->current_state;
+  j.state_type = svc->state_type;
+  j.timeout = config->event_handler_timeout();
+  j.timeout_message = std::string("Global service event handler command '")
+    + processed_command + "'";
+  commands::handler_runner::instance().run(j);
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -452,7 +395,6 @@ int run_service_event_handler(nagios_macros* mac, service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -551,54 +493,22 @@ int run_service_event_handler(nagios_macros* mac, service* svc) {
     return ((neb_result == NEBERROR_CALLBACKCANCEL) ? ERROR : OK);
   }
 
-  /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute service event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Service event handler command '" << processed_command
-      << "' timed out after " << config->event_handler_timeout()
-      << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    SERVICE_EVENTHANDLER,
-    (void*)svc,
-    svc->current_state,
-    svc->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    svc->event_handler,
-    processed_command,
-    command_output,
-    NULL);
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  j.command_name = svc->event_handler;
+  j.handler_type = SERVICE_EVENTHANDLER;
+  j.host_name = svc->host_name;
+  j.service_description = svc->description;
+  j.start_time = start_time;
+  j.state = svc->current_state;
+  j.state_type = svc->state_type;
+  j.timeout = config->event_handler_timeout();
+  j.timeout_message = std::string("Service event handler command '")
+    + processed_command + "'";
+  commands::handler_runner::instance().run(j);
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -669,7 +579,6 @@ int run_global_host_event_handler(nagios_macros* mac, host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -768,54 +677,21 @@ int run_global_host_event_handler(nagios_macros* mac, host* hst) {
     return ((neb_result == NEBERROR_CALLBACKCANCEL) ? ERROR : OK);
   }
 
-  /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute global host event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check for a timeout in the execution of the event handler command */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Global host event handler command '"
-      << processed_command << "' timed out after "
-      << config->event_handler_timeout() << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    GLOBAL_HOST_EVENTHANDLER,
-    (void*)hst,
-    hst->current_state,
-    hst->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    config->global_host_event_handler().c_str(),
-    processed_command,
-    command_output,
-    NULL);
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  j.command_name = config->global_host_event_handler().c_str();
+  j.handler_type = GLOBAL_HOST_EVENTHANDLER;
+  j.host_name = hst->name;
+  j.start_time = start_time;
+  j.state = hst->current_state;
+  j.state_type = hst->state_type;
+  j.timeout = config->event_handler_timeout();
+  j.timeout_message = std::string("Global host event handler command '")
+    + processed_command + "'";
+  commands::handler_runner::instance().run(j);
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -828,7 +704,6 @@ int run_host_event_handler(nagios_macros* mac, host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -924,54 +799,21 @@ int run_host_event_handler(nagios_macros* mac, host* hst) {
     return ((neb_result == NEBERROR_CALLBACKCANCEL) ? ERROR : OK);
   }
 
-  /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute host event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Host event handler command '" << processed_command
-      << "' timed out after " << config->event_handler_timeout()
-      << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    HOST_EVENTHANDLER,
-    (void*)hst,
-    hst->current_state,
-    hst->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    hst->event_handler,
-    processed_command,
-    command_output,
-    NULL);
+  /* run the command, its completion is reported by the main loop */
+  commands::handler_runner::job j;
+  j.command_line = processed_command;
+  j.command_name = hst->event_handler;
+  j.handler_type = HOST_EVENTHANDLER;
+  j.host_name = hst->name;
+  j.start_time = start_time;
+  j.state = hst->current_state;
+  j.state_type = hst->state_type;
+  j.timeout = config->event_handler_timeout();
+  j.timeout_message = std::string("Host event handler command '")
+    + processed_command + "'";
+  commands::handler_runner::instance().run(j);
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -17,12 +17,40 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/unordered_hash.hh"
 
+using namespace com::centreon;
 using namespace com::centreon::engine;
 
 static char const* whitespaces(" \t\r\n");
 
+/**
+ *  Get the table of interned strings and their reference count. It is
+ *  never destroyed so that objects released at exit remain valid.
+ *
+ *  @return Interned strings.
+ */
+static umap<std::string, unsigned int>& interned() {
+  static umap<std::string, unsigned int>*
+    strings(new umap<std::string, unsigned int>);
+  return (*strings);
+}
+
+/**
+ *  Get the lock of the interned strings table. Objects are created by
+ *  the configuration loading thread while the main loop runs. Like the
+ *  table, it is never destroyed.
+ *
+ *  @return Lock of interned().
+ */
+static concurrency::mutex& interned_lock() {
+  static concurrency::mutex* lock(new concurrency::mutex);
+  return (*lock);
+}
+
 /**
  *  Get the next valid line.
  *
@@ -48,6 +76,57 @@ bool string::get_next_line(
   return (false);
 }
 
+/**
+ *  Get a shared copy of a string. Identical strings share the same
+ *  storage, so interned strings can be compared by address. The
+ *  returned string must not be modified and must be freed with
+ *  release().
+ *
+ *  @param[in] value  String to intern, can be NULL.
+ *
+ *  @return Interned string, NULL if value is NULL.
+ */
+char* string::intern(char const* value) {
+  if (!value)
+    return (NULL);
+  concurrency::locker lock(&interned_lock());
+  umap<std::string, unsigned int>& strings(interned());
+  umap<std::string, unsigned int>::iterator it(strings.find(value));
+  if (it == strings.end())
+    it = strings.insert(std::make_pair(std::string(value), 0u)).first;
+  ++it->second;
+  return (const_cast<char*>(it->first.c_str()));
+}
+
+/**
+ *  Release a string obtained with intern(). Strings that were not
+ *  interned were allocated with dup() and are deleted.
+ *
+ *  @param[in,out] buf  Interned string, set to NULL.
+ */
+void string::release(char*& buf) throw () {
+  if (buf) {
+    umap<std::string, unsigned int>& strings(interned());
+    // Leak the string if it cannot be looked up.
+    bool is_interned(true);
+    try {
+      concurrency::locker lock(&interned_lock());
+      umap<std::string, unsigned int>::iterator it(strings.find(buf));
+      if ((it != strings.end()) && (it->first.c_str() == buf)) {
+        if (!--it->second)
+          strings.erase(it);
+      }
+      else
+        is_interned = false;
+    }
+    catch (...) {}
+    if (!is_interned)
+      delete[] buf;
+    buf = NULL;
+  }
+  return ;
+}
+
 /**
  *  Get key and value from line.
  *
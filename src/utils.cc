@@ -25,6 +25,7 @@
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <dirent.h>
 #include <fcntl.h>
@@ -294,7 +295,61 @@ int free_check_result(check_result* info) {
   return (OK);
 }
 
-/* parse raw plugin output and return: short and long output, perf data */
+/**
+ *  Copy a part of the plugin output in a newly allocated string.
+ *
+ *  @param[in] begin     Beginning of the part.
+ *  @param[in] end       End of the part (excluded).
+ *  @param[in] tail      Perf data lines that follow the part, or NULL.
+ *  @param[in] tail_end  End of the perf data lines.
+ *
+ *  @return New string, NULL if empty.
+ */
+static char* extract_output(
+               char const* begin,
+               char const* end,
+               char const* tail,
+               char const* tail_end) {
+  size_t len(end - begin);
+  size_t tail_len(tail ? tail_end - tail + 1 : 0);
+  if (!len && !tail_len)
+    return (NULL);
+  char* str(new char[len + tail_len + 1]);
+  memcpy(str, begin, len);
+  if (tail_len) {
+    // Perf data lines are joined by spaces.
+    char* ptr(str + len);
+    char* ptr_end(ptr + tail_len - 1);
+    memcpy(ptr, tail, tail_len - 1);
+    for (char* nl(ptr);
+         (nl = static_cast<char*>(memchr(nl, '\n', ptr_end - nl)));
+         ++nl)
+      *nl = ' ';
+    *ptr_end = ' ';
+  }
+  str[len + tail_len] = '\x0';
+  return (str);
+}
+
+/**
+ *  Parse raw plugin output and return short and long output and perf
+ *  data.
+ *
+ *  The first line holds the short output, optionally followed by perf
+ *  data after a '|'. Following lines are long output until a line
+ *  containing a '|' is found. The remaining part of that line and all
+ *  subsequent lines are perf data. The buffer is scanned once and each
+ *  result is allocated once at its final size.
+ *
+ *  @param[in,out] buf                    Plugin output. Modified.
+ *  @param[out]    short_output           Short output.
+ *  @param[out]    long_output            Long output.
+ *  @param[out]    perf_data              Perf data.
+ *  @param[in]     escape_newlines_please Escape newlines of long output.
+ *  @param[in]     newlines_are_escaped   Newlines of buf are escaped.
+ *
+ *  @return OK.
+ */
 int parse_check_output(
       char* buf,
       char** short_output,
@@ -302,19 +357,6 @@ int parse_check_output(
       char** perf_data,
       int escape_newlines_please,
       int newlines_are_escaped) {
-  int current_line = 0;
-  bool found_newline = false;
-  bool eof = false;
-  int used_buf = 0;
-  int dbuf_chunk = 1024;
-  dbuf db1;
-  dbuf db2;
-  char* ptr = NULL;
-  bool in_perf_data = false;
-  char* tempbuf = NULL;
-  int x = 0;
-  int y = 0;
-
   /* initialize values */
   if (short_output)
     *short_output = NULL;
@@ -327,168 +369,109 @@ int parse_check_output(
   if (buf == NULL || *buf == 0)
     return (OK);
 
-  used_buf = strlen(buf) + 1;
-
-  /* initialize dynamic buffers (1KB chunk size) */
-  dbuf_init(&db1, dbuf_chunk);
-  dbuf_init(&db2, dbuf_chunk);
-
   /* unescape newlines and escaped backslashes first */
+  size_t len(strlen(buf));
   if (newlines_are_escaped) {
-    for (x = 0, y = 0; buf[x] != '\x0'; x++) {
-      if (buf[x] == '\\' && buf[x + 1] == '\\') {
-        x++;
-        buf[y++] = buf[x];
-      }
-      else if (buf[x] == '\\' && buf[x + 1] == 'n') {
-        x++;
-        buf[y++] = '\n';
+    char* first(static_cast<char*>(memchr(buf, '\\', len)));
+    if (first) {
+      char* in(first);
+      char* out(first);
+      while (*in) {
+        if (in[0] == '\\' && in[1] == '\\') {
+          *out++ = '\\';
+          in += 2;
+        }
+        else if (in[0] == '\\' && in[1] == 'n') {
+          *out++ = '\n';
+          in += 2;
+        }
+        /* an unescaped backslash followed by n is a newline too */
+        else if (in[0] == 'n' && out > buf && out[-1] == '\\') {
+          out[-1] = '\n';
+          ++in;
+        }
+        else
+          *out++ = *in++;
       }
-      else
-        buf[y++] = buf[x];
+      *out = '\x0';
+      len = out - buf;
     }
-    buf[y] = '\x0';
   }
-
-  /* process each line of input */
-  for (x = 0; !eof; x++) {
-
-    /* we found the end of a line */
-    if (buf[x] == '\n')
-      found_newline = true;
-    else if (buf[x] == '\\' && buf[x + 1] == 'n'
-             && newlines_are_escaped == true) {
-      found_newline = true;
-      buf[x] = '\x0';
-      x++;
+  char* end(buf + len);
+
+  /* first line contains short plugin output and optional perf data */
+  char* line_end(static_cast<char*>(memchr(buf, '\n', len)));
+  if (!line_end)
+    line_end = end;
+  char* short_begin(buf);
+  while (short_begin < line_end && *short_begin == '|')
+    ++short_begin;
+  char* short_end(line_end);
+  char* perf_begin(line_end);
+  if (short_begin < line_end) {
+    char* pipe(static_cast<char*>(
+                 memchr(short_begin, '|', line_end - short_begin)));
+    if (pipe) {
+      short_end = pipe;
+      perf_begin = pipe + 1;
     }
-    else if (buf[x] == '\x0') {
-      found_newline = true;
-      eof = true;
+  }
+  else
+    short_begin = short_end = line_end;
+
+  /* additional lines contain long plugin output until a line */
+  /* contains a perf data separator, perf data follows        */
+  char* long_begin(line_end < end ? line_end + 1 : end);
+  char* long_end(end);
+  char* tail(NULL);
+  char* pipe(static_cast<char*>(
+               memchr(long_begin, '|', end - long_begin)));
+  if (pipe) {
+    long_end = pipe;
+    tail = pipe + 1;
+    if (tail == end || *tail == '\n') {
+      /* no perf data on the separator line itself */
+      tail = (tail < end ? tail + 1 : NULL);
     }
-    else
-      found_newline = false;
-
-    if (found_newline == true) {
-
-      current_line++;
-
-      /* handle this line of input */
-      buf[x] = '\x0';
-      tempbuf = string::dup(buf);
-
-      /* first line contains short plugin output and optional perf data */
-      if (current_line == 1) {
-
-        /* get the short plugin output */
-        if ((ptr = strtok(tempbuf, "|"))) {
-          if (short_output)
-            *short_output = string::dup(ptr);
-
-          /* get the optional perf data */
-          if ((ptr = strtok(NULL, "\n")))
-            dbuf_strcat(&db2, ptr);
-        }
-      }
-
-      /* additional lines contain long plugin output and optional perf data */
-      else {
-
-        /* rest of the output is perf data */
-        if (in_perf_data) {
-          dbuf_strcat(&db2, tempbuf);
-          dbuf_strcat(&db2, " ");
-        }
-
-        /* we're still in long output */
-        else {
-
-          /* perf data separator has been found */
-          if (strstr(tempbuf, "|")) {
-
-            /* NOTE: strtok() causes problems if first character of tempbuf='|', so use my_strtok() instead */
-            /* get the remaining long plugin output */
-            if ((ptr = my_strtok(tempbuf, "|"))) {
-
-              if (current_line > 2)
-                dbuf_strcat(&db1, "\n");
-              dbuf_strcat(&db1, ptr);
-
-              /* get the perf data */
-              if ((ptr = my_strtok(NULL, "\n"))) {
-                dbuf_strcat(&db2, ptr);
-                dbuf_strcat(&db2, " ");
-              }
-            }
-
-            /* set the perf data flag */
-            in_perf_data = true;
-          }
-
-          /* just long output */
-          else {
-            if (current_line > 2)
-              dbuf_strcat(&db1, "\n");
-            dbuf_strcat(&db1, tempbuf);
-          }
-        }
-      }
+  }
 
-      delete[] tempbuf;
-      tempbuf = NULL;
-
-      /* shift data back to front of buffer and adjust counters */
-      memmove(
-        (void*)&buf[0],
-        (void*)&buf[x + 1],
-        (size_t)((int)used_buf - x - 1));
-      used_buf -= (x + 1);
-      buf[used_buf] = '\x0';
-      x = -1;
-    }
+  if (short_output) {
+    *short_output = extract_output(short_begin, short_end, NULL, NULL);
+    strip(*short_output);
   }
 
-  /* save long output */
-  if (long_output && (db1.buf && strcmp(db1.buf, ""))) {
-    if (escape_newlines_please == false)
-      *long_output = string::dup(db1.buf);
+  if (long_output && long_end > long_begin) {
+    if (!escape_newlines_please)
+      *long_output = extract_output(long_begin, long_end, NULL, NULL);
     else {
       /* escape newlines (and backslashes) in long output */
-      tempbuf = new char[strlen(db1.buf) * 2 + 1];
-
-      for (x = 0, y = 0; db1.buf[x] != '\x0'; x++) {
-
-        if (db1.buf[x] == '\n') {
-          tempbuf[y++] = '\\';
-          tempbuf[y++] = 'n';
+      size_t escaped(0);
+      for (char const* ptr(long_begin); ptr < long_end; ++ptr)
+        if (*ptr == '\n' || *ptr == '\\')
+          ++escaped;
+      char* str(new char[long_end - long_begin + escaped + 1]);
+      char* out(str);
+      for (char const* ptr(long_begin); ptr < long_end; ++ptr) {
+        if (*ptr == '\n') {
+          *out++ = '\\';
+          *out++ = 'n';
         }
-        else if (db1.buf[x] == '\\') {
-          tempbuf[y++] = '\\';
-          tempbuf[y++] = '\\';
+        else if (*ptr == '\\') {
+          *out++ = '\\';
+          *out++ = '\\';
         }
         else
-          tempbuf[y++] = db1.buf[x];
+          *out++ = *ptr;
       }
-
-      tempbuf[y] = '\x0';
-      *long_output = string::dup(tempbuf);
-      delete[] tempbuf;
+      *out = '\x0';
+      *long_output = str;
     }
   }
 
-  /* save perf data */
-  if (perf_data && (db2.buf && strcmp(db2.buf, "")))
-    *perf_data = string::dup(db2.buf);
-
-  /* strip short output and perf data */
-  if (short_output)
-    strip(*short_output);
-  if (perf_data)
+  if (perf_data) {
+    *perf_data = extract_output(perf_begin, line_end, tail, end);
     strip(*perf_data);
-
-  /* free dynamic buffers */
-  dbuf_free(&db1);
-  dbuf_free(&db2);
+  }
 
   return (OK);
 }
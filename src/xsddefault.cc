@@ -28,7 +28,11 @@
 #include <string>
 #include <sys/stat.h>
 #include <unistd.h>
+#include "com/centreon/engine/broker/callback_stats.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/configuration/load_stats.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
@@ -191,8 +195,27 @@ int xsddefault_save_status_data() {
     << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
     << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
     << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tactive_checks_executed="
+    << checks::checker::instance().executed_checks() << "\n"
+       "\tactive_checks_coalesced="
+    << checks::checker::instance().coalesced_checks() << "\n"
+       "\tactive_checks_limit="
+    << checks::parallelism::instance().limit() << "\n"
+       "\tactive_checks_latency="
+    << checks::parallelism::instance().latency() << "\n"
+       "\tactive_checks_completion_rate="
+    << checks::parallelism::instance().completion_rate() << "\n"
+       "\trun_queue_load="
+    << checks::parallelism::instance().run_queue_load() << "\n"
        "\t}\n\n";
 
+  // save broker module callback statistics
+  if (config->enable_neb_callback_stats())
+    broker::callback_stats::save(stream);
+
+  // save configuration load timings
+  configuration::load_stats::save(stream);
+
   /* save host status data */
   for (host* hst = host_list; hst; hst = hst->next) {
     stream
@@ -0,0 +1,134 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <sys/time.h>
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+static int          dummy_module;
+static unsigned int iterations(1000000);
+
+/**
+ *  Callback registered by the fake module.
+ */
+static int callback(int type, void* data) {
+  (void)type;
+  (void)data;
+  return (0);
+}
+
+/**
+ *  Send check and status events of a service to the broker.
+ *
+ *  @param[in] svc  Service.
+ *
+ *  @return Average time of one iteration in nanoseconds.
+ */
+static double run(service* svc) {
+  timeval start;
+  gettimeofday(&start, NULL);
+  for (unsigned int i(0); i < iterations; ++i) {
+    broker_service_check(
+      NEBTYPE_SERVICECHECK_PROCESSED,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      svc,
+      SERVICE_CHECK_ACTIVE,
+      start,
+      start,
+      "check_dummy!arg1!arg2",
+      0.0,
+      0.0,
+      60,
+      false,
+      0,
+      const_cast<char*>("/usr/lib/nagios/plugins/check_dummy 0"),
+      NULL);
+    broker_service_status(
+      NEBTYPE_SERVICESTATUS_UPDATE,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      svc,
+      NULL);
+  }
+  timeval end;
+  gettimeofday(&end, NULL);
+  return (((end.tv_sec - start.tv_sec) * 1000000000.0
+           + (end.tv_usec - start.tv_usec) * 1000.0)
+          / iterations);
+}
+
+/**
+ *  Bench the broker calls made on the check hot path, with and
+ *  without a module subscribed to them, and with callback statistics
+ *  enabled.
+ */
+int main_test(int argc, char** argv) {
+  if (argc > 1)
+    iterations = strtoul(argv[1], NULL, 0);
+  if (!iterations)
+    iterations = 1;
+
+  service* svc(unittest::add_generic_service());
+  if (!svc)
+    throw (engine_error() << "cannot create service.");
+
+  neb_init_callback_list();
+  std::cout << "without module: " << run(svc) << " ns/check\n";
+
+  neb_register_callback(
+    NEBCALLBACK_SERVICE_CHECK_DATA,
+    &dummy_module,
+    0,
+    &callback);
+  neb_register_callback(
+    NEBCALLBACK_SERVICE_STATUS_DATA,
+    &dummy_module,
+    0,
+    &callback);
+  double with_module(run(svc));
+  std::cout << "with module:    " << with_module << " ns/check\n";
+
+  // Two callbacks are made per iteration.
+  config->enable_neb_callback_stats(true);
+  double with_stats(run(svc));
+  config->enable_neb_callback_stats(false);
+  std::cout << "with stats:     " << with_stats << " ns/check\n"
+            << "stats overhead: " << (with_stats - with_module) / 2
+            << " ns/callback\n";
+  neb_free_callback_list();
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,180 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <sys/time.h>
+#include <vector>
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+// Number of allocations made by the process.
+static unsigned long long allocations(0);
+
+/**
+ *  Count allocations.
+ *
+ *  @param[in] size  Size to allocate.
+ *
+ *  @return Allocated memory.
+ */
+void* operator new(std::size_t size) throw (std::bad_alloc) {
+  ++allocations;
+  void* ptr(malloc(size ? size : 1));
+  if (!ptr)
+    throw (std::bad_alloc());
+  return (ptr);
+}
+
+/**
+ *  Count allocations.
+ *
+ *  @param[in] size  Size to allocate.
+ *
+ *  @return Allocated memory.
+ */
+void* operator new[](std::size_t size) throw (std::bad_alloc) {
+  return (operator new(size));
+}
+
+/**
+ *  Release memory allocated by operator new.
+ *
+ *  @param[in] ptr  Memory to release.
+ */
+void operator delete(void* ptr) throw () {
+  free(ptr);
+}
+
+/**
+ *  Release memory allocated by operator new[].
+ *
+ *  @param[in] ptr  Memory to release.
+ */
+void operator delete[](void* ptr) throw () {
+  free(ptr);
+}
+
+/**
+ *  Get the current time in microseconds.
+ */
+static double now() {
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  return (tv.tv_sec * 1000000.0 + tv.tv_usec);
+}
+
+/**
+ *  Bench the configuration lookups made for every object on reload
+ *  (modify_object(), remove_object(), resolve_object()) over a large
+ *  synthetic configuration. Run it on two revisions to compare them.
+ *
+ *  Usage: centengine_bench_config [services] [services_per_host]
+ */
+int main_test(int argc, char** argv) {
+  unsigned int services(argc > 1 ? strtoul(argv[1], NULL, 0) : 200000);
+  unsigned int per_host(argc > 2 ? strtoul(argv[2], NULL, 0) : 20);
+  if (!services)
+    services = 1;
+  if (!per_host)
+    per_host = 1;
+
+  // Build configuration.
+  configuration::state config;
+  std::vector<configuration::host::key_type> host_keys;
+  std::vector<configuration::service::key_type> service_keys;
+  for (unsigned int i(0); i < services; ++i) {
+    std::ostringstream host_name;
+    host_name << "synthetic_host_" << i / per_host;
+    if (!(i % per_host)) {
+      configuration::host_ptr hst(
+        new configuration::host(host_name.str()));
+      config.hosts().insert(hst);
+      host_keys.push_back(hst->key());
+    }
+    std::ostringstream description;
+    description << "synthetic_service_" << i % per_host;
+    configuration::service_ptr svc(new configuration::service);
+    svc->hosts().push_back(host_name.str());
+    svc->service_description() = description.str();
+    config.services().insert(svc);
+    service_keys.push_back(svc->key());
+  }
+
+  // Host lookups.
+  unsigned long long allocs(allocations);
+  double start(now());
+  unsigned int found(0);
+  for (std::vector<configuration::host::key_type>::const_iterator
+         it(host_keys.begin()), end(host_keys.end());
+       it != end;
+       ++it)
+    if (config.hosts_find(*it) != config.hosts().end())
+      ++found;
+  double host_time(now() - start);
+  unsigned long long host_allocs(allocations - allocs);
+  if (found != host_keys.size())
+    throw (engine_error() << "found " << found << " hosts out of "
+           << static_cast<unsigned int>(host_keys.size()));
+
+  // Service lookups.
+  allocs = allocations;
+  start = now();
+  found = 0;
+  for (std::vector<configuration::service::key_type>::const_iterator
+         it(service_keys.begin()), end(service_keys.end());
+       it != end;
+       ++it)
+    if (config.services_find(*it) != config.services().end())
+      ++found;
+  double service_time(now() - start);
+  unsigned long long service_allocs(allocations - allocs);
+  if (found != service_keys.size())
+    throw (engine_error() << "found " << found << " services out of "
+           << static_cast<unsigned int>(service_keys.size()));
+
+  std::cout
+    << "hosts:                      " << host_keys.size() << "\n"
+    << "services:                   " << service_keys.size() << "\n"
+    << "host lookup:                "
+    << host_time * 1000.0 / host_keys.size() << " ns\n"
+    << "host lookup allocations:    "
+    << static_cast<double>(host_allocs) / host_keys.size() << "\n"
+    << "service lookup:             "
+    << service_time * 1000.0 / service_keys.size() << " ns\n"
+    << "service lookup allocations: "
+    << static_cast<double>(service_allocs) / service_keys.size() << "\n";
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,152 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/time.h>
+#include "com/centreon/concurrency/condvar.hh"
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/commands/command_listener.hh"
+#include "com/centreon/engine/commands/native.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/commands/reactor.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  Count the completed checks.
+ */
+class                  counter : public command_listener {
+public:
+                       counter() : _completed(0), _failed(0) {}
+                       ~counter() throw () {}
+  void                 finished(result const& res) throw () {
+    concurrency::locker lock(&_lock);
+    ++_completed;
+    if (res.exit_code != STATE_OK)
+      ++_failed;
+    _cv.wake_all();
+  }
+  unsigned int         failed() const {
+    concurrency::locker lock(&_lock);
+    return (_failed);
+  }
+  void                 wait(unsigned int completed) {
+    concurrency::locker lock(&_lock);
+    while (_completed < completed)
+      _cv.wait(&_lock);
+  }
+
+private:
+  unsigned int         _completed;
+  concurrency::condvar _cv;
+  unsigned int         _failed;
+  mutable concurrency::mutex
+                       _lock;
+};
+
+/**
+ *  Get the current time in microseconds.
+ */
+static double now() {
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  return (tv.tv_sec * 1000000.0 + tv.tv_usec);
+}
+
+/**
+ *  Run checks with at most window of them in flight.
+ *
+ *  @param[in] cmd     Command to run.
+ *  @param[in] checks  Number of checks.
+ *  @param[in] window  Maximum number of concurrent checks.
+ *
+ *  @return Elapsed time in microseconds.
+ */
+static double bench(
+                commands::command& cmd,
+                unsigned int checks,
+                unsigned int window) {
+  counter c;
+  cmd.set_listener(&c);
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  double start(now());
+  for (unsigned int i(0); i < checks; ++i) {
+    if (i >= window)
+      c.wait(i - window + 1);
+    cmd.run(cmd.get_command_line(), mac, 10);
+  }
+  c.wait(checks);
+  double elapsed(now() - start);
+  if (c.failed())
+    throw (engine_error() << c.failed() << " checks of '"
+           << cmd.get_command_line() << "' failed");
+  cmd.set_listener(NULL);
+  return (elapsed);
+}
+
+/**
+ *  Compare the cost of a trivial check run by a forked plugin and by
+ *  a native plugin. The forked path also reports how often the
+ *  process reactor woke up.
+ *
+ *  Usage: centengine_bench_native [checks] [concurrency] [plugin dir]
+ */
+int main_test(int argc, char** argv) {
+  unsigned int checks(argc > 1 ? strtoul(argv[1], NULL, 0) : 10000);
+  unsigned int window(argc > 2 ? strtoul(argv[2], NULL, 0) : 8);
+  std::string dir(argc > 3 ? argv[3] : ".");
+  if (!checks)
+    checks = 1;
+  if (!window)
+    window = 1;
+  config->native_check_workers(window);
+
+  raw forked("bench_raw", dir + "/check_sleep -s 0 -t 0");
+  native in_process("bench_native", dir + "/native_check_sleep.so -s 0");
+  unsigned long long wakeups(reactor::instance().wakeups());
+  double forked_time(bench(forked, checks, window));
+  wakeups = reactor::instance().wakeups() - wakeups;
+  double native_time(bench(in_process, checks, window));
+
+  std::cout
+    << "checks:      " << checks << " (" << window << " concurrent)\n"
+    << "raw fork:    " << forked_time / checks << " us/check, "
+    << checks * 1000000.0 / forked_time << " checks/s, "
+    << static_cast<double>(wakeups) / checks << " reactor wakeups/check\n"
+    << "native:      " << native_time / checks << " us/check, "
+    << checks * 1000000.0 / native_time << " checks/s\n";
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,109 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/service.hh"
+#include "com/centreon/engine/objects/servicesmember.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Get the resident set size of the current process.
+ *
+ *  @return RSS in kilobytes.
+ */
+static unsigned long rss() {
+  unsigned long size(0);
+  unsigned long resident(0);
+  FILE* f(fopen("/proc/self/statm", "r"));
+  if (f) {
+    if (fscanf(f, "%lu %lu", &size, &resident) != 2)
+      resident = 0;
+    fclose(f);
+  }
+  return (resident * (sysconf(_SC_PAGESIZE) / 1024));
+}
+
+/**
+ *  Report the memory used by a large object configuration. Run it on
+ *  two revisions to compare their memory footprint.
+ *
+ *  Usage: centengine_bench_objects [services] [services_per_host]
+ */
+int main_test(int argc, char** argv) {
+  unsigned int services(argc > 1 ? strtoul(argv[1], NULL, 0) : 500000);
+  unsigned int per_host(argc > 2 ? strtoul(argv[2], NULL, 0) : 20);
+  if (!per_host)
+    per_host = 1;
+
+  unsigned long before(rss());
+  host* hst(NULL);
+  for (unsigned int i(0); i < services; ++i) {
+    if (!(i % per_host)) {
+      std::ostringstream name;
+      name << "host_" << i / per_host;
+      hst = add_host(
+              i / per_host + 1, name.str().c_str(), NULL, "127.0.0.1",
+              "24x7", 0, 5.0, 1.0, 3, 60, "check_host_alive", 1,
+              "notify_admins", 1, 0, 0.0, 0.0, 0, 0, 0, 0, 0, 1, 0,
+              NULL);
+      if (!hst)
+        throw (engine_error() << "cannot create host " << name.str());
+    }
+    std::ostringstream description;
+    description << "service_" << i % per_host;
+    service* svc(add_service(
+                   hst->id, hst->name, i + 1, description.str().c_str(),
+                   "24x7", 0, 3, 60, 5.0, 1.0, 0, "notify_admins", 1,
+                   "check_dummy!0!OK", 1, 0, 0.0, 0.0, 0, 0, 0, 0, 0, 0,
+                   0, NULL));
+    if (!svc)
+      throw (engine_error() << "cannot create service "
+             << description.str());
+    add_service_link_to_host(hst, svc);
+  }
+  unsigned long after(rss());
+
+  std::cout
+    << "services:          " << services << "\n"
+    << "services per host: " << per_host << "\n"
+    << "RSS before:        " << before << " kB\n"
+    << "RSS after:         " << after << " kB\n"
+    << "RSS per service:   "
+    << (services ? (after - before) * 1024.0 / services : 0.0)
+    << " bytes\n";
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
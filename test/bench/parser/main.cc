@@ -0,0 +1,245 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/load_stats.hh"
+#include "com/centreon/engine/configuration/parser.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/io/directory_entry.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+// Size of generated object files.
+static unsigned long long const file_size(64ull * 1024 * 1024);
+
+// Services of each generated host.
+static unsigned int const services_per_host(10);
+
+/**
+ *  Write a file and remember it.
+ *
+ *  @param[in]     path     File path.
+ *  @param[in]     content  File content.
+ *  @param[in,out] files    Generated files.
+ *
+ *  @return Size of the file.
+ */
+static unsigned long long write_file(
+                            std::string const& path,
+                            std::string const& content,
+                            std::list<std::string>& files) {
+  std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+  ofs << content;
+  if (!ofs.good())
+    throw (engine_error() << "cannot write '" << path << "'");
+  files.push_back(path);
+  return (content.size());
+}
+
+/**
+ *  Generate a configuration tree.
+ *
+ *  @param[in]  dir    Directory of the tree.
+ *  @param[in]  size   Approximate size of object files in bytes.
+ *  @param[out] files  Generated files.
+ */
+static void generate(
+              std::string const& dir,
+              unsigned long long size,
+              std::list<std::string>& files) {
+  std::string objects(dir + "/objects");
+  if (mkdir(objects.c_str(), 0755))
+    throw (engine_error() << "cannot create '" << objects << "'");
+  write_file(
+    dir + "/centengine.cfg",
+    "cfg_dir=" + objects + "\n",
+    files);
+  unsigned long long total(write_file(
+    objects + "/templates.cfg",
+    "define command {\n"
+    "  command_name   check_ping\n"
+    "  command_line   $USER1$/check_ping -H $HOSTADDRESS$ -w $ARG1$ -c $ARG2$\n"
+    "}\n"
+    "\n"
+    "define host {\n"
+    "  name                 generic-host\n"
+    "  check_command        check_ping!100.0,20%!500.0,60%\n"
+    "  max_check_attempts   3\n"
+    "  check_interval       5\n"
+    "  register             0\n"
+    "}\n"
+    "\n"
+    "define service {\n"
+    "  name                 generic-service\n"
+    "  max_check_attempts   3\n"
+    "  check_interval       5\n"
+    "  retry_interval       1\n"
+    "  register             0\n"
+    "}\n",
+    files));
+
+  unsigned int host_id(0);
+  unsigned int service_id(0);
+  for (unsigned int file(0); total < size; ++file) {
+    std::ostringstream oss;
+    while ((static_cast<unsigned long long>(oss.tellp()) < file_size)
+           && (total + oss.tellp() < size)) {
+      ++host_id;
+      oss << "# Host " << host_id << ".\n"
+             "define host {\n"
+             "  host_name            host_" << host_id << "\n"
+             "  alias                Generated host " << host_id << "\n"
+             "  address              10." << (host_id >> 16) % 256
+          << "." << (host_id >> 8) % 256 << "." << host_id % 256 << "\n"
+             "  host_id              " << host_id << "\n"
+             "  use                  generic-host\n"
+             "  _SNMP_COMMUNITY      public\n"
+             "  notes                Host generated by the parser bench\n"
+             "}\n\n";
+      for (unsigned int i(0); i < services_per_host; ++i) {
+        ++service_id;
+        oss << "define service {\n"
+               "  host_name            host_" << host_id << "\n"
+               "  service_description  service_" << i << "\n"
+               "  service_id           " << service_id << "\n"
+               "  use                  generic-service\n"
+               "  check_command        check_ping!100.0,20%\\\n"
+               "                       !500.0,60%\n"
+               "  _CRITICALITY         " << i % 5 << "\n"
+               "}\n\n";
+      }
+    }
+    std::ostringstream path;
+    path << objects << "/hosts_" << file << ".cfg";
+    total += write_file(path.str(), oss.str(), files);
+  }
+  return ;
+}
+
+/**
+ *  Bench the configuration parser on a generated configuration tree.
+ *  The tree is kept when a directory is given, so that it can be
+ *  parsed again by another revision.
+ *
+ *  Usage: centengine_bench_parser [size_in_MB] [directory]
+ */
+int main_test(int argc, char** argv) {
+  unsigned long long size(
+    (argc > 1 ? strtoull(argv[1], NULL, 0) : 1024) * 1024 * 1024);
+  std::string dir;
+  bool keep(argc > 2);
+  if (keep)
+    dir = argv[2];
+  else {
+    char tmpl[] = "/tmp/centengine_bench_parser.XXXXXX";
+    if (!mkdtemp(tmpl))
+      throw (engine_error() << "cannot create temporary directory");
+    dir = tmpl;
+  }
+
+  // Generate the tree unless it already exists.
+  std::list<std::string> files;
+  std::string main_file(dir + "/centengine.cfg");
+  if (access(main_file.c_str(), R_OK))
+    generate(dir, size, files);
+
+  // Parse.
+  configuration::state config;
+  {
+    configuration::parser p;
+    configuration::load_stats::begin(false);
+    try {
+      p.parse(main_file, config);
+    }
+    catch (...) {
+      configuration::load_stats::end();
+      throw ;
+    }
+    configuration::load_stats::end();
+  }
+
+  // Size of object files.
+  unsigned long long bytes(0);
+  for (std::list<std::string>::const_iterator
+         it(config.cfg_dir().begin()), end(config.cfg_dir().end());
+       it != end;
+       ++it) {
+    io::directory_entry objects(*it);
+    std::list<io::file_entry> const& lst(objects.entry_list("*.cfg"));
+    for (std::list<io::file_entry>::const_iterator
+           it_file(lst.begin()), end_file(lst.end());
+         it_file != end_file;
+         ++it_file)
+      bytes += it_file->size();
+  }
+
+  // Report.
+  configuration::load_stats::report r;
+  configuration::load_stats::get(r);
+  double read_time(0.0);
+  std::cout
+    << "size:                 " << bytes / (1024.0 * 1024.0) << " MB\n"
+    << "hosts:                " << config.hosts().size() << "\n"
+    << "services:             " << config.services().size() << "\n";
+  for (std::list<configuration::load_stats::entry>::const_iterator
+         it(r.phases.begin()), end(r.phases.end());
+       it != end;
+       ++it) {
+    std::cout << it->phase << ": " << it->duration << " s\n";
+    if (it->phase == "parse object files")
+      read_time = it->duration;
+  }
+  std::cout
+    << "total:                " << r.total_time << " s\n"
+    << "object files:         "
+    << (read_time ? bytes / (1024.0 * 1024.0) / read_time : 0.0)
+    << " MB/s\n"
+    << "whole parse:          "
+    << bytes / (1024.0 * 1024.0) / r.total_time << " MB/s\n";
+
+  // Remove the temporary tree.
+  if (!keep) {
+    for (std::list<std::string>::const_iterator
+           it(files.begin()), end(files.end());
+         it != end;
+         ++it)
+      unlink(it->c_str());
+    rmdir((dir + "/objects").c_str());
+    rmdir(dir.c_str());
+  }
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,86 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include "com/centreon/engine/commands/native_check.hh"
+
+/*
+** Native counterpart of check_sleep, used as a sample plugin and by
+** the native check bench.
+**
+** Usage: native_check_sleep.so [-s status] [-t milliseconds] [text]
+*/
+
+NATIVE_CHECK_API_VERSION(CURRENT_NATIVE_CHECK_API_VERSION)
+
+static char const* const status_name[] = {
+  "OK",
+  "WARNING",
+  "CRITICAL",
+  "UNKNOWN"
+};
+
+/**
+ *  Run the check.
+ *
+ *  @param[in,out] args  Check arguments and output buffer.
+ *
+ *  @return Requested status.
+ */
+extern "C" int native_check(native_check_args* args) {
+  int status(0);
+  long duration(0);
+  char const* text(NULL);
+  for (int i(1); i < args->argc; ++i) {
+    if (!strcmp(args->argv[i], "-s") && (i + 1 < args->argc))
+      status = atoi(args->argv[++i]);
+    else if (!strcmp(args->argv[i], "-t") && (i + 1 < args->argc))
+      duration = atol(args->argv[++i]);
+    else
+      text = args->argv[i];
+  }
+  if ((status < 0) || (status > 3))
+    status = 3;
+
+  // Sleep by slices to honor cancellation.
+  long slept(0);
+  while ((slept < duration) && !*args->cancelled) {
+    long slice(duration - slept < 10 ? duration - slept : 10);
+    timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = slice * 1000000l;
+    nanosleep(&ts, NULL);
+    slept += slice;
+  }
+
+  snprintf(
+    args->output,
+    args->output_size,
+    "%s: duration=%ld%s%s|duration=%ldms;status=%d",
+    status_name[status],
+    duration,
+    text ? ", output=" : "",
+    text ? text : "",
+    duration,
+    status);
+  return (status);
+}
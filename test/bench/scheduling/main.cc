@@ -0,0 +1,156 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
+#include "com/centreon/engine/objects/service.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Get the current time in microseconds.
+ */
+static double now() {
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  return (tv.tv_sec * 1000000.0 + tv.tv_usec);
+}
+
+/**
+ *  Scan services the way the scheduling parameters computation did,
+ *  through the service list.
+ *
+ *  @return Number of schedulable services.
+ */
+static unsigned int list_scan() {
+  unsigned int scheduled(0);
+  for (service* svc(service_list); svc; svc = svc->next)
+    if ((svc->check_interval > 0.0) && svc->checks_enabled)
+      ++scheduled;
+  return (scheduled);
+}
+
+/**
+ *  Scan services the way the scheduling parameters computation does,
+ *  through the scheduling table.
+ *
+ *  @return Number of schedulable services.
+ */
+static unsigned int table_scan() {
+  unsigned int scheduled(0);
+  for (unsigned int i(0), end(scheduling_table<service_struct>::size());
+       i < end;
+       ++i) {
+    service_struct const& svc(*scheduling_table<service_struct>::at(i));
+    if ((svc.check_interval > 0.0) && svc.checks_enabled)
+      ++scheduled;
+  }
+  return (scheduled);
+}
+
+/**
+ *  Bench the scans of the scheduling and freshness loops over a large
+ *  synthetic service set, through the service list and through the
+ *  scheduling table.
+ *
+ *  Usage: centengine_bench_scheduling [services] [iterations]
+ */
+int main_test(int argc, char** argv) {
+  unsigned int services(argc > 1 ? strtoul(argv[1], NULL, 0) : 500000);
+  unsigned int iterations(argc > 2 ? strtoul(argv[2], NULL, 0) : 20);
+  unsigned int const per_host(20);
+  if (!services)
+    services = 1;
+  if (!iterations)
+    iterations = 1;
+
+  host* hst(NULL);
+  for (unsigned int i(0); i < services; ++i) {
+    if (!(i % per_host)) {
+      std::ostringstream name;
+      name << "host_" << i / per_host;
+      hst = add_host(
+              i / per_host + 1, name.str().c_str(), NULL, "127.0.0.1",
+              NULL, 0, 5.0, 1.0, 3, 60, NULL, 1, NULL, 0, 0, 0.0, 0.0,
+              0, 0, 0, 0, 0, 1, 0, NULL);
+      if (!hst)
+        throw (engine_error() << "cannot create host " << name.str());
+    }
+    std::ostringstream description;
+    description << "service_" << i % per_host;
+    if (!add_service(
+           hst->id, hst->name, i + 1, description.str().c_str(), NULL,
+           0, 3, 60, 5.0, 1.0, 0, NULL, 0, "check_dummy", 1, 0, 0.0,
+           0.0, 0, 0, 0, 0, 0, 0, 0, NULL))
+      throw (engine_error() << "cannot create service "
+             << description.str());
+  }
+
+  config->check_host_freshness(true);
+  config->check_service_freshness(true);
+
+  double start(now());
+  unsigned int scheduled(0);
+  for (unsigned int i(0); i < iterations; ++i)
+    scheduled += list_scan();
+  double list(now() - start);
+
+  start = now();
+  unsigned int in_table(0);
+  for (unsigned int i(0); i < iterations; ++i)
+    in_table += table_scan();
+  double table(now() - start);
+  if (in_table != scheduled)
+    throw (engine_error() << "scans disagree: " << in_table
+           << " != " << scheduled);
+
+  start = now();
+  for (unsigned int i(0); i < iterations; ++i) {
+    check_service_result_freshness();
+    check_host_result_freshness();
+  }
+  double freshness(now() - start);
+
+  std::cout
+    << "services:        " << services << " (" << scheduled / iterations
+    << " schedulable)\n"
+    << "list scan:       "
+    << list * 1000.0 / iterations / services << " ns/service\n"
+    << "table scan:      "
+    << table * 1000.0 / iterations / services << " ns/service\n"
+    << "freshness scan:  "
+    << freshness * 1000.0 / iterations / services << " ns/service\n";
+  return (0);
+}
+
+/**
+ *  Init the bench.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,116 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+static int dummy_module;
+static int calls(0);
+
+/**
+ *  First callback.
+ */
+static int first(int type, void* data) {
+  (void)type;
+  (void)data;
+  ++calls;
+  return (0);
+}
+
+/**
+ *  Second callback.
+ */
+static int second(int type, void* data) {
+  (void)type;
+  (void)data;
+  ++calls;
+  return (0);
+}
+
+/**
+ *  Check that the subscription bitmap follows callback registration.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  if (neb_init_callback_list() != OK)
+    throw (engine_error() << "neb_init_callback_list failed.");
+  for (int type(0); type < NEBCALLBACK_NUMITEMS; ++type)
+    if (neb_has_callbacks(type))
+      throw (engine_error() << "callback type " << type
+             << " subscribed after init.");
+
+  if ((neb_register_callback(
+         NEBCALLBACK_TIMED_EVENT_DATA,
+         &dummy_module,
+         0,
+         &first) != OK)
+      || (neb_register_callback(
+            NEBCALLBACK_TIMED_EVENT_DATA,
+            &dummy_module,
+            1,
+            &second) != OK))
+    throw (engine_error() << "neb_register_callback failed.");
+  if (!neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA)
+      || neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA - 1)
+      || neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA + 1))
+    throw (engine_error() << "invalid bitmap after registration.");
+
+  // Removing the head of the list must keep the other callbacks.
+  if (neb_deregister_callback(NEBCALLBACK_TIMED_EVENT_DATA, &first) != OK)
+    throw (engine_error() << "neb_deregister_callback failed.");
+  if (!neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA))
+    throw (engine_error() << "bitmap cleared while subscribed.");
+  neb_make_callbacks(NEBCALLBACK_TIMED_EVENT_DATA, NULL);
+  if (calls != 1)
+    throw (engine_error() << "remaining callback was lost.");
+
+  if (neb_deregister_callback(NEBCALLBACK_TIMED_EVENT_DATA, &second) != OK)
+    throw (engine_error() << "neb_deregister_callback failed.");
+  if (neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA))
+    throw (engine_error() << "bitmap set without subscriber.");
+
+  // Freeing the callback list clears the bitmap.
+  if (neb_register_callback(
+        NEBCALLBACK_SERVICE_CHECK_DATA,
+        &dummy_module,
+        0,
+        &first) != OK)
+    throw (engine_error() << "neb_register_callback failed.");
+  if (neb_free_callback_list() != OK)
+    throw (engine_error() << "neb_free_callback_list failed.");
+  if (neb_has_callbacks(NEBCALLBACK_SERVICE_CHECK_DATA))
+    throw (engine_error() << "bitmap set after free.");
+
+  return (0);
+}
+
+/**
+ *  Init the unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,122 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <list>
+#include "com/centreon/engine/broker/callback_stats.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+static int dummy_module;
+
+/**
+ *  Callback that accepts the event.
+ */
+static int accept_event(int type, void* data) {
+  (void)type;
+  (void)data;
+  return (0);
+}
+
+/**
+ *  Callback that cancels the event.
+ */
+static int cancel_event(int type, void* data) {
+  (void)type;
+  (void)data;
+  return (NEBERROR_CALLBACKCANCEL);
+}
+
+/**
+ *  Check that callback costs are accounted per module and type.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  if (neb_init_callback_list() != OK)
+    throw (engine_error() << "neb_init_callback_list failed.");
+  if (neb_register_callback(
+        NEBCALLBACK_HOST_CHECK_DATA,
+        &dummy_module,
+        0,
+        &accept_event) != OK
+      || neb_register_callback(
+           NEBCALLBACK_SERVICE_CHECK_DATA,
+           &dummy_module,
+           0,
+           &cancel_event) != OK)
+    throw (engine_error() << "neb_register_callback failed.");
+
+  // Callbacks are not measured by default.
+  neb_make_callbacks(NEBCALLBACK_HOST_CHECK_DATA, NULL);
+  std::list<broker::callback_stats::entry> entries;
+  broker::callback_stats::get(entries);
+  if (!entries.empty())
+    throw (engine_error() << "callbacks measured while disabled.");
+
+  config->enable_neb_callback_stats(true);
+  for (unsigned int i(0); i < 3; ++i)
+    neb_make_callbacks(NEBCALLBACK_HOST_CHECK_DATA, NULL);
+  neb_make_callbacks(NEBCALLBACK_SERVICE_CHECK_DATA, NULL);
+  broker::callback_stats::get(entries);
+  if (entries.size() != 2)
+    throw (engine_error() << "invalid statistics size.");
+  broker::callback_stats::entry const* host(NULL);
+  broker::callback_stats::entry const* service(NULL);
+  for (std::list<broker::callback_stats::entry>::const_iterator
+         it(entries.begin()), end(entries.end());
+       it != end;
+       ++it)
+    if (it->callback_type == NEBCALLBACK_HOST_CHECK_DATA)
+      host = &*it;
+    else if (it->callback_type == NEBCALLBACK_SERVICE_CHECK_DATA)
+      service = &*it;
+  if (!host || !service)
+    throw (engine_error() << "missing callback statistics.");
+  if ((host->calls != 3)
+      || (host->cancels != 0)
+      || (host->overrides != 0)
+      || (host->max_time > host->total_time))
+    throw (engine_error() << "invalid host check statistics.");
+  if ((service->calls != 1) || (service->cancels != 1))
+    throw (engine_error() << "invalid service check statistics.");
+
+  broker::callback_stats::reset();
+  entries.clear();
+  broker::callback_stats::get(entries);
+  if (!entries.empty())
+    throw (engine_error() << "statistics were not reset.");
+
+  neb_free_callback_list();
+  return (0);
+}
+
+/**
+ *  Init the unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,140 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#include "com/centreon/engine/checks/admission.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/events/defines.hh"
+#include "com/centreon/engine/events/hash_timed_event.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/command.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Create a service.
+ *
+ *  @param[in] host_name    Host name.
+ *  @param[in] id           Service ID.
+ *  @param[in] description  Service description.
+ *  @param[in] cmd          Check command.
+ *
+ *  @return New service.
+ */
+static service* create_service(
+                  char const* host_name,
+                  unsigned int id,
+                  char const* description,
+                  command* cmd) {
+  service* svc(add_service(
+                 1, host_name, id, description, NULL, 0, 42, 0, 42.0,
+                 0.0, 0, NULL, 0, "command", 1, 0, 0.0, 0.0, 0, 0, 0, 0,
+                 0, 0, 0, NULL));
+  if (!svc)
+    throw (engine_error() << "create service failed");
+  svc->check_command_ptr = cmd;
+  return (svc);
+}
+
+/**
+ *  Check per-host and per-command limits of service checks.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  command* cmd(add_command("command", "/bin/true"));
+  if (!cmd)
+    throw (engine_error() << "create command failed");
+  service* svc1(create_service("name", 1, "description1", cmd));
+  service* svc2(create_service("name", 2, "description2", cmd));
+  service* svc3(create_service("other", 3, "description3", cmd));
+  checks::admission& adm(checks::admission::instance());
+
+  // A second check of the same host waits.
+  config->max_concurrent_checks_per_host(1);
+  if (!adm.acquire(svc1))
+    throw (engine_error() << "first check was not admitted");
+  if (adm.acquire(svc2) || (adm.deferred() != 1))
+    throw (engine_error() << "per-host limit was not enforced");
+  if (!adm.acquire(svc3))
+    throw (engine_error() << "check of another host was deferred");
+
+  // Releasing the slot moves the deferred check to now.
+  time_t now(time(NULL));
+  schedule_new_event(
+    EVENT_SERVICE_CHECK,
+    false,
+    now + 3600,
+    false,
+    0,
+    NULL,
+    true,
+    svc2,
+    NULL,
+    0);
+  adm.release("name", "description1");
+  timed_event* evt(quick_timed_event.find(
+                                       events::hash_timed_event::low,
+                                       events::hash_timed_event::service_check,
+                                       svc2));
+  if (!evt || (evt->run_time > time(NULL)))
+    throw (engine_error() << "deferred check was not woken up");
+  if (!adm.acquire(svc2) || adm.deferred())
+    throw (engine_error() << "woken up check was not admitted");
+
+  // Forced checks ignore limits.
+  if (!adm.acquire(svc1, true))
+    throw (engine_error() << "forced check was deferred");
+
+  // Checks using the same command are limited too.
+  adm.release("name", "description1");
+  adm.release("other", "description3");
+  config->max_concurrent_checks_per_host(0);
+  config->max_concurrent_checks_per_command(2);
+  if (!adm.acquire(svc1))
+    throw (engine_error() << "check was not admitted");
+  if (adm.acquire(svc3))
+    throw (engine_error() << "per-command limit was not enforced");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
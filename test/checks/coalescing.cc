@@ -0,0 +1,125 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/commands/set.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/command.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Create a service checked by the test command.
+ *
+ *  @param[in] hst          Host of the service.
+ *  @param[in] id           Service ID.
+ *  @param[in] description  Service description.
+ *  @param[in] cmd          Check command.
+ *
+ *  @return New service.
+ */
+static service* create_service(
+                  host* hst,
+                  unsigned int id,
+                  char const* description,
+                  command* cmd) {
+  service* svc(add_service(
+                 1, "name", id, description, NULL, 0, 42, 0, 42.0, 0.0,
+                 0, NULL, 0, "command", 1, 0, 0.0, 0.0, 0, 0, 0, 0, 0,
+                 0, 0, NULL));
+  if (!svc)
+    throw (engine_error() << "create service failed");
+  svc->host_ptr = hst;
+  svc->check_command_ptr = cmd;
+  return (svc);
+}
+
+/**
+ *  Check that identical concurrent check commands are executed once.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Objects sharing the same check command.
+  host* hst(unittest::add_generic_host());
+  if (!hst)
+    throw (engine_error() << "create host failed");
+  command* cmd(add_command("command", "/bin/sleep 1"));
+  if (!cmd)
+    throw (engine_error() << "create command failed");
+  commands::set::instance().add_command(
+    commands::raw("command", "/bin/sleep 1"));
+  service* svc1(create_service(hst, 1, "description1", cmd));
+  service* svc2(create_service(hst, 2, "description2", cmd));
+  service* svc3(create_service(hst, 3, "description3", cmd));
+  checks::checker& checker(checks::checker::instance());
+
+  // Without a window, every check executes its command.
+  config->check_coalescing_window(0);
+  checker.run(svc1, CHECK_OPTION_FORCE_EXECUTION);
+  if ((checker.executed_checks() != 1) || checker.coalesced_checks())
+    throw (engine_error() << "check was not executed");
+
+  // With a window, identical checks attach to the first one.
+  config->check_coalescing_window(10);
+  checker.run(svc2, CHECK_OPTION_FORCE_EXECUTION);
+  checker.run(svc3, CHECK_OPTION_FORCE_EXECUTION);
+  if ((checker.executed_checks() != 2)
+      || (checker.coalesced_checks() != 1))
+    throw (engine_error() << "identical checks were not coalesced");
+
+  // Every check gets a result.
+  time_t limit(time(NULL) + 10);
+  while (svc1->is_executing || svc2->is_executing || svc3->is_executing) {
+    if (time(NULL) > limit)
+      throw (engine_error() << "coalesced checks did not complete");
+    checker.reap();
+    usleep(10000);
+  }
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
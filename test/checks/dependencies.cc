@@ -0,0 +1,126 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/servicedependency.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Make a service depend on another one.
+ *
+ *  @param[out] dep        Dependency.
+ *  @param[in]  dependent  Dependent service.
+ *  @param[in]  master     Master service.
+ */
+static void link(
+              servicedependency& dep,
+              service& dependent,
+              service& master) {
+  dep.dependent_service_ptr = &dependent;
+  dep.master_service_ptr = &master;
+  dep.fail_on_critical = true;
+  dep.next_dependency = dependent.dependencies;
+  dependent.dependencies = &dep;
+  return ;
+}
+
+/**
+ *  Check service dependencies evaluation.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Chain of services: each one depends on the next one.
+  unsigned int const count(64);
+  std::vector<service> services(count);
+  std::vector<servicedependency> deps(count - 1);
+  memset(&services[0], 0, services.size() * sizeof(services[0]));
+  memset(&deps[0], 0, deps.size() * sizeof(deps[0]));
+  for (unsigned int i(0); i < count; ++i) {
+    services[i].current_state = STATE_OK;
+    services[i].state_type = HARD_STATE;
+    services[i].has_been_checked = true;
+  }
+  for (unsigned int i(0); i + 1 < count; ++i)
+    link(deps[i], services[i], services[i + 1]);
+
+  if (check_service_dependencies(&services[0]) != DEPENDENCIES_OK)
+    throw (engine_error() << "dependencies on OK services failed");
+
+  // Only the direct master is considered without inheritance.
+  services[count - 1].current_state = STATE_CRITICAL;
+  services[count - 1].last_hard_state = STATE_CRITICAL;
+  if (check_service_dependencies(&services[0]) != DEPENDENCIES_OK)
+    throw (engine_error() << "non-inherited dependency failed");
+  if (check_service_dependencies(&services[count - 2])
+      != DEPENDENCIES_FAILED)
+    throw (engine_error() << "direct dependency did not fail");
+
+  // With inheritance, the failure propagates along the chain.
+  for (unsigned int i(0); i + 1 < count; ++i)
+    deps[i].inherits_parent = true;
+  if (check_service_dependencies(&services[0]) != DEPENDENCIES_FAILED)
+    throw (engine_error() << "inherited dependency did not fail");
+
+  // Soft states of the master are ignored by default.
+  services[count - 1].state_type = SOFT_STATE;
+  services[count - 1].last_hard_state = STATE_OK;
+  if (check_service_dependencies(&services[0]) != DEPENDENCIES_OK)
+    throw (engine_error() << "soft state failed a dependency");
+
+  // A dependency loop does not recurse forever.
+  services[count - 1].state_type = HARD_STATE;
+  services[count - 1].current_state = STATE_OK;
+  servicedependency loop;
+  memset(&loop, 0, sizeof(loop));
+  link(loop, services[count - 1], services[0]);
+  loop.inherits_parent = true;
+  if (check_service_dependencies(&services[0]) != DEPENDENCIES_OK)
+    throw (engine_error() << "dependency loop failed");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
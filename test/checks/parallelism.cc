@@ -0,0 +1,158 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/checks/admission.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/parallelism.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/commands/set.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/command.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+// Check taking one second.
+#define CHECK_SLEEP "./check_sleep -s 0 -t 1"
+
+/**
+ *  Run admitted checks of a set of services with a high latency and
+ *  wait for their completion.
+ *
+ *  @param[in] services  Services to check.
+ *
+ *  @return Number of checks run.
+ */
+static unsigned int run_round(std::vector<service*> const& services) {
+  checks::admission& adm(checks::admission::instance());
+  checks::checker& checker(checks::checker::instance());
+  unsigned int count(0);
+  for (std::vector<service*>::const_iterator
+         it(services.begin()), end(services.end());
+       it != end;
+       ++it)
+    if (adm.acquire(*it)) {
+      checker.run(*it, CHECK_OPTION_FORCE_EXECUTION, 5.0);
+      ++count;
+    }
+  time_t limit(time(NULL) + 15);
+  while (currently_running_service_checks) {
+    if (time(NULL) > limit)
+      throw (engine_error() << "checks did not complete");
+    checker.reap();
+    usleep(10000);
+  }
+  return (count);
+}
+
+/**
+ *  Check that the concurrent check limit follows latency and load.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Services running the check_sleep plugin.
+  host* hst(unittest::add_generic_host());
+  if (!hst)
+    throw (engine_error() << "create host failed");
+  command* cmd(add_command("command", CHECK_SLEEP));
+  if (!cmd)
+    throw (engine_error() << "create command failed");
+  commands::set::instance().add_command(
+    commands::raw("command", CHECK_SLEEP));
+  std::vector<service*> services;
+  for (unsigned int i(0); i < 16; ++i) {
+    std::ostringstream oss;
+    oss << "description" << i;
+    service* svc(add_service(
+                   1, "name", i + 1, oss.str().c_str(), NULL, 0, 42, 0,
+                   42.0, 0.0, 0, NULL, 0, "command", 1, 0, 0.0, 0.0, 0,
+                   0, 0, 0, 0, 0, 0, NULL));
+    if (!svc)
+      throw (engine_error() << "create service failed");
+    svc->host_ptr = hst;
+    svc->check_command_ptr = cmd;
+    services.push_back(svc);
+  }
+
+  checks::parallelism& ctrl(checks::parallelism::instance());
+  config->max_parallel_service_checks(8);
+  config->min_concurrent_checks(4);
+  if (ctrl.limit() != 8)
+    throw (engine_error() << "static limit is not max_concurrent_checks");
+  config->use_adaptive_concurrent_checks(true);
+  if (ctrl.limit() != 8)
+    throw (engine_error() << "adaptive limit does not start at maximum");
+
+  // An overloaded run queue lowers the limit down to the minimum.
+  time_t now(time(NULL));
+  ctrl.update(now, 0.0);
+  for (unsigned int i(0); i < 4; ++i) {
+    now += 5;
+    ctrl.update(now, 10.0);
+  }
+  if (ctrl.limit() != 4)
+    throw (engine_error() << "limit did not go down to the minimum");
+
+  // Late checks waiting for a slot raise the limit up to the maximum.
+  unsigned int previous(ctrl.limit());
+  for (unsigned int i(0); i < 5; ++i) {
+    if (run_round(services) != previous)
+      throw (engine_error() << "round " << i << " did not run "
+             << previous << " checks");
+    now += 5;
+    ctrl.update(now, 0.0);
+    if ((ctrl.limit() < previous) || (ctrl.limit() > 8))
+      throw (engine_error() << "limit went from " << previous
+             << " to " << ctrl.limit() << " under latency");
+    previous = ctrl.limit();
+  }
+  if (previous != 8)
+    throw (engine_error() << "limit did not reach the maximum");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,93 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/string.hh"
+#include "com/centreon/engine/utils.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Parse some plugin output and compare the results.
+ *
+ *  @param[in] output        Raw plugin output.
+ *  @param[in] short_output  Expected short output, NULL if none.
+ *  @param[in] long_output   Expected long output, NULL if none.
+ *  @param[in] perf_data     Expected perf data, NULL if none.
+ */
+static void check(
+              char const* output,
+              char const* short_output,
+              char const* long_output,
+              char const* perf_data) {
+  char* buf(string::dup(output));
+  char* so(NULL);
+  char* lo(NULL);
+  char* pd(NULL);
+  parse_check_output(buf, &so, &lo, &pd, true, true);
+  bool ok(((!so && !short_output)
+           || (so && short_output && !strcmp(so, short_output)))
+          && ((!lo && !long_output)
+              || (lo && long_output && !strcmp(lo, long_output)))
+          && ((!pd && !perf_data)
+              || (pd && perf_data && !strcmp(pd, perf_data))));
+  delete[] buf;
+  delete[] so;
+  delete[] lo;
+  delete[] pd;
+  if (!ok)
+    throw (engine_error() << "invalid parsing of '" << output << "'");
+  return ;
+}
+
+/**
+ *  Check plugin output parsing.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  check("", NULL, NULL, NULL);
+  check("OK", "OK", NULL, NULL);
+  check(" OK - all good  ", "OK - all good", NULL, NULL);
+  check("OK|time=1s", "OK", NULL, "time=1s");
+  check("||", NULL, NULL, NULL);
+  check("|OK|time=1s", "OK", NULL, "time=1s");
+  check("OK\\nline 2\\nline 3", "OK", "line 2\\nline 3", NULL);
+  check("OK\nline 2\nline 3", "OK", "line 2\\nline 3", NULL);
+  check("OK\\nC:\\\\dir", "OK", "C:\\\\dir", NULL);
+  check(
+    "OK|a=1\\nline 2\\nline 3|b=2\\nc=3\\nd=4",
+    "OK",
+    "line 2\\nline 3",
+    "a=1b=2 c=3 d=4");
+  check("OK\\n|a=1\\nb=2", "OK", NULL, "a=1 b=2");
+  check("OK\\nlong|\\na=1", "OK", "long", "a=1");
+  return (0);
+}
+
+/**
+ *  Init the unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,102 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include "com/centreon/engine/commands/handler_runner.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  Reap until every command completed.
+ *
+ *  @param[in] runner  Handler runner.
+ *
+ *  @return true if every command completed in time.
+ */
+static bool reap_all(handler_runner& runner) {
+  time_t limit(time(NULL) + 10);
+  while (runner.running() || runner.waiting()) {
+    if (time(NULL) > limit)
+      return (false);
+    runner.reap();
+    usleep(10000);
+  }
+  return (true);
+}
+
+/**
+ *  Check that commands are run asynchronously within the concurrency
+ *  limit.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  handler_runner& runner(handler_runner::instance());
+  handler_runner::job j;
+  j.command_line = "./bin_test_run --timeout=off";
+  j.timeout = 5;
+
+  // Without limit, every command starts immediately.
+  config->max_concurrent_event_handlers(0);
+  runner.run(j);
+  runner.run(j);
+  if ((runner.running() != 2) || runner.waiting())
+    throw (engine_error() << "unlimited handlers were not all started");
+  if (!reap_all(runner))
+    throw (engine_error() << "unlimited handlers did not complete");
+
+  // With a limit, extra commands wait for a free slot.
+  config->max_concurrent_event_handlers(1);
+  runner.run(j);
+  runner.run(j);
+  runner.run(j);
+  if ((runner.running() != 1) || (runner.waiting() != 2))
+    throw (engine_error() << "concurrency limit was not enforced");
+  if (!reap_all(runner))
+    throw (engine_error() << "limited handlers did not complete");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
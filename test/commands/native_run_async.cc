@@ -0,0 +1,167 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "com/centreon/engine/commands/native.hh"
+#include "com/centreon/engine/commands/set.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/process.hh"
+#include "test/commands/wait_process.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  Check if the native check result is ok without timeout.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool run_without_timeout() {
+  // Native command object and its waiter.
+  shared_ptr<native> cmd(new native(
+                               __func__,
+                               "./native_check_sleep.so -s 2 'some text'"));
+  wait_process wait_proc(cmd.get());
+  set::instance().add_command(cmd);
+
+  // Run command and wait for it to complete.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  unsigned long id(cmd->run(cmd->get_command_line(), mac, 0));
+  wait_proc.wait();
+
+  // Check result.
+  result const& res = wait_proc.get_result();
+  return (!((res.command_id != id)
+            || (res.exit_code != STATE_CRITICAL)
+            || (res.exit_status != process::normal)
+            || (res.output != "CRITICAL: duration=0, output=some text"
+                              "|duration=0ms;status=2")));
+}
+
+/**
+ *  Check that a check whose timeout expires is reported on time and
+ *  cancelled.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool run_with_timeout() {
+  // Native command object and its waiter.
+  shared_ptr<native> cmd(new native(
+                               __func__,
+                               "./native_check_sleep.so -t 30000"));
+  wait_process wait_proc(cmd.get());
+  set::instance().add_command(cmd);
+
+  // Run command and wait for it to complete.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  timestamp start(timestamp::now());
+  unsigned long id(cmd->run(cmd->get_command_line(), mac, 1));
+  wait_proc.wait();
+  timestamp end(timestamp::now());
+
+  // Check result.
+  result const& res = wait_proc.get_result();
+  return (!((res.command_id != id)
+            || (res.exit_code != STATE_UNKNOWN)
+            || (res.exit_status != process::timeout)
+            || (res.output != "(Process Timeout)")
+            || ((end - start).to_seconds() > 5)));
+}
+
+/**
+ *  Check that an invalid plugin is refused.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool run_invalid_plugin() {
+  shared_ptr<native> cmd(new native(
+                               __func__,
+                               "./native_check_missing.so"));
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  try {
+    cmd->run(cmd->get_command_line(), mac, 0);
+  }
+  catch (std::exception const& e) {
+    (void)e;
+    return (true);
+  }
+  return (false);
+}
+
+/**
+ *  Check that command lines are split like a shell would.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool split_command_line() {
+  std::vector<std::string> args;
+  native::split(" ./plugin.so  -H 'a b'  \"c\\\"d\" e\\ f ''", args);
+  return ((args.size() == 6)
+          && (args[0] == "./plugin.so")
+          && (args[1] == "-H")
+          && (args[2] == "a b")
+          && (args[3] == "c\"d")
+          && (args[4] == "e f")
+          && args[5].empty());
+}
+
+/**
+ *  Check the asynchronous system for the native command.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  if (!split_command_line())
+    throw (engine_error() << "native::split failed");
+  if (!run_without_timeout())
+    throw (engine_error() << "native::run without timeout failed");
+  if (!run_with_timeout())
+    throw (engine_error() << "native::run with timeout failed");
+  if (!run_invalid_plugin())
+    throw (engine_error() << "native::run with invalid plugin failed");
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
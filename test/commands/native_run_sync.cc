@@ -0,0 +1,108 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include "com/centreon/engine/commands/native.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/process.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  Check if the native check result is ok without timeout.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool run_without_timeout() {
+  // Native command object.
+  native cmd(__func__, "./native_check_sleep.so -s 0 -t 100");
+
+  // Run command.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  result res;
+  cmd.run(cmd.get_command_line(), mac, 0, res);
+
+  // Check result.
+  return (!((res.command_id == 0)
+            || (res.exit_code != STATE_OK)
+            || (res.exit_status != process::normal)
+            || (res.output != "OK: duration=100|duration=100ms;status=0")
+            || ((res.end_time - res.start_time).to_mseconds() < 100)));
+}
+
+/**
+ *  Check if the native check result is ok with timeout.
+ *
+ *  @return true if ok, false otherwise.
+ */
+static bool run_with_timeout() {
+  // Native command object.
+  native cmd(__func__, "./native_check_sleep.so -t 30000");
+
+  // Run command.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  result res;
+  cmd.run(cmd.get_command_line(), mac, 1, res);
+
+  // Check result.
+  return (!((res.command_id == 0)
+            || (res.exit_code != STATE_UNKNOWN)
+            || (res.exit_status != process::timeout)
+            || (res.output != "(Process Timeout)")));
+}
+
+/**
+ *  Check the synchronous system for the native command.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  if (!run_without_timeout())
+    throw (engine_error() << "native::run without timeout failed");
+  if (!run_with_timeout())
+    throw (engine_error() << "native::run with timeout failed");
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
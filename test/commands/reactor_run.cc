@@ -0,0 +1,178 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <vector>
+#include "com/centreon/concurrency/condvar.hh"
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/commands/command.hh"
+#include "com/centreon/engine/commands/command_listener.hh"
+#include "com/centreon/engine/commands/reactor.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/process.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+/**
+ *  Collect the results of the reactor.
+ */
+class                  collector : public command_listener {
+public:
+                       collector() : _batches(0) {}
+                       ~collector() throw () {}
+  unsigned int         batches() const {
+    concurrency::locker lock(&_lock);
+    return (_batches);
+  }
+  void                 finished(result const& res) throw () {
+    concurrency::locker lock(&_lock);
+    _results.push_back(res);
+    _cv.wake_all();
+  }
+  void                 finished_batch(
+                         std::vector<result> const& results) throw () {
+    concurrency::locker lock(&_lock);
+    ++_batches;
+    _results.insert(_results.end(), results.begin(), results.end());
+    _cv.wake_all();
+  }
+  result               get(unsigned long command_id) const {
+    concurrency::locker lock(&_lock);
+    for (std::vector<result>::const_iterator
+           it(_results.begin()), end(_results.end());
+         it != end;
+         ++it)
+      if (it->command_id == command_id)
+        return (*it);
+    throw (engine_error() << "no result for command "
+           << static_cast<unsigned long long>(command_id));
+  }
+  void                 wait(unsigned int count) {
+    concurrency::locker lock(&_lock);
+    while (_results.size() < count)
+      _cv.wait(&_lock);
+  }
+
+private:
+  unsigned int         _batches;
+  concurrency::condvar _cv;
+  mutable concurrency::mutex
+                       _lock;
+  std::vector<result>  _results;
+};
+
+/**
+ *  Run a command line with the reactor.
+ */
+static void run(
+              unsigned long id,
+              char const* command_line,
+              unsigned int timeout,
+              collector& c) {
+  std::vector<std::string> args;
+  commands::command::split(command_line, args);
+  reactor::instance().run(id, args, timeout, &c);
+  return ;
+}
+
+/**
+ *  Check that the reactor collects output, exit status and timeouts.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  collector c;
+
+  // Output is stdout only, exit code is kept.
+  run(1, "/bin/sh -c 'echo out; echo err >&2; exit 2'", 0, c);
+  // Exit codes out of range and crashes are unknown.
+  run(2, "/bin/sh -c 'exit 42'", 0, c);
+  run(3, "/bin/sh -c 'kill -9 $$'", 0, c);
+  // Timeout kills the process.
+  run(4, "/bin/sleep 30", 1, c);
+  // Many concurrent processes.
+  for (unsigned long id(100); id < 200; ++id)
+    run(id, "/bin/sh -c 'echo ok'", 10, c);
+  c.wait(104);
+
+  result res(c.get(1));
+  if ((res.exit_code != 2)
+      || (res.exit_status != process::normal)
+      || (res.output != "out\n"))
+    throw (engine_error() << "invalid result of normal process: code="
+           << res.exit_code << ", output='" << res.output << "'");
+  res = c.get(2);
+  if ((res.exit_code != STATE_UNKNOWN)
+      || (res.exit_status != process::normal))
+    throw (engine_error() << "invalid result of process exiting with 42");
+  res = c.get(3);
+  if ((res.exit_code != STATE_UNKNOWN)
+      || (res.exit_status != process::crash))
+    throw (engine_error() << "invalid result of killed process");
+  res = c.get(4);
+  if ((res.exit_code != STATE_UNKNOWN)
+      || (res.exit_status != process::timeout)
+      || (res.output != "(Process Timeout)")
+      || ((res.end_time - res.start_time).to_seconds() > 5))
+    throw (engine_error() << "invalid result of timed out process");
+  for (unsigned long id(100); id < 200; ++id)
+    if (c.get(id).output != "ok\n")
+      throw (engine_error() << "invalid output of process "
+             << static_cast<unsigned long long>(id));
+  if (reactor::instance().running())
+    throw (engine_error() << "reactor still has running processes");
+
+  // Failure to execute is reported to the caller.
+  bool thrown(false);
+  try {
+    run(5, "/nonexistent/plugin", 0, c);
+  }
+  catch (std::exception const& e) {
+    (void)e;
+    thrown = true;
+  }
+  if (!thrown)
+    throw (engine_error() << "execution of missing plugin did not fail");
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,115 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include "com/centreon/engine/configuration/applier/reference_index.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Check that the reverse index follows the references of objects.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Objects.
+  shared_ptr<configuration::host> router(new configuration::host("router"));
+  shared_ptr<configuration::host> central(new configuration::host("central"));
+  central->parse("parents", "router");
+  central->parse("check_command", "check_ping!100!80%");
+  central->parse("check_period", "24x7");
+  shared_ptr<configuration::service> ping(new configuration::service);
+  ping->parse("host_name", "central");
+  ping->parse("service_description", "ping");
+  ping->parse("event_handler", "restart");
+  shared_ptr<configuration::timeperiod>
+    workhours(new configuration::timeperiod("workhours"));
+  workhours->parse("exclude", "holidays");
+
+  applier::reference_index index;
+  index.add(router);
+  index.add(central);
+  index.add(ping);
+  index.add(workhours);
+
+  // Users.
+  applier::reference_index::users const* u(index.host_users("router"));
+  if (!u || (u->hosts.size() != 1) || !u->hosts.count("central"))
+    throw (engine_error() << "host parent is not indexed");
+  u = index.host_users("central");
+  if (!u || (u->services.size() != 1)
+      || !u->services.count(std::make_pair(
+                              std::string("central"),
+                              std::string("ping"))))
+    throw (engine_error() << "service host is not indexed");
+  u = index.command_users("check_ping");
+  if (!u || !u->hosts.count("central"))
+    throw (engine_error() << "host check command is not indexed");
+  u = index.command_users("restart");
+  if (!u || (u->services.size() != 1))
+    throw (engine_error() << "service event handler is not indexed");
+  u = index.timeperiod_users("24x7");
+  if (!u || !u->hosts.count("central"))
+    throw (engine_error() << "host check period is not indexed");
+  u = index.timeperiod_users("holidays");
+  if (!u || !u->timeperiods.count("workhours"))
+    throw (engine_error() << "time period exclusion is not indexed");
+  if (index.host_users("unknown"))
+    throw (engine_error() << "unknown host has users");
+
+  // Removal.
+  index.remove(central);
+  if (index.host_users("router") || index.command_users("check_ping"))
+    throw (engine_error() << "host references were not removed");
+  if (!index.host_users("central"))
+    throw (engine_error() << "users of a removed host were removed");
+  index.remove(ping);
+  if (index.host_users("central") || index.command_users("restart"))
+    throw (engine_error() << "service references were not removed");
+  index.clear();
+  if (index.timeperiod_users("holidays"))
+    throw (engine_error() << "index was not cleared");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,373 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include "com/centreon/engine/configuration/applier/difference.hh"
+#include "com/centreon/engine/configuration/applier/reference_index.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Create an object from configuration lines.
+ *
+ *  @param[in] lines  NULL-terminated property lines.
+ *
+ *  @return New object.
+ */
+template <typename T>
+static shared_ptr<T> create(char const* const* lines) {
+  shared_ptr<T> obj(new T);
+  for (; *lines; ++lines)
+    if (!static_cast<object&>(*obj).parse(*lines))
+      throw (engine_error() << "invalid line '" << *lines << "'");
+  return (obj);
+}
+
+/**
+ *  Fill the configuration used by every reload: a router, a central
+ *  host with two services and a poller that depends on it.
+ *
+ *  @param[out] cfg  Configuration.
+ */
+static void fill(configuration::state& cfg) {
+  static char const* const tp_24x7[] = {
+    "timeperiod_name 24x7", "monday 00:00-24:00", NULL };
+  static char const* const tp_workhours[] = {
+    "timeperiod_name workhours", "monday 09:00-17:00", NULL };
+  static char const* const cmd_ping[] = {
+    "command_name check_ping", "command_line /bin/ping $HOSTADDRESS$",
+    NULL };
+  static char const* const cmd_http[] = {
+    "command_name check_http", "command_line /bin/http $HOSTADDRESS$",
+    NULL };
+  static char const* const hst_router[] = {
+    "host_name router", "address 10.0.0.1", "check_command check_ping",
+    NULL };
+  static char const* const hst_central[] = {
+    "host_name central", "address 10.0.0.2", "parents router",
+    "check_command check_ping", "check_period 24x7", NULL };
+  static char const* const hst_poller[] = {
+    "host_name poller", "address 10.0.0.3", "parents router",
+    "check_command check_ping", NULL };
+  static char const* const svc_central_ping[] = {
+    "host_name central", "service_description ping",
+    "check_command check_ping", NULL };
+  static char const* const svc_central_http[] = {
+    "host_name central", "service_description http",
+    "check_command check_http", "check_period workhours", NULL };
+  static char const* const svc_poller_ping[] = {
+    "host_name poller", "service_description ping",
+    "check_command check_ping", NULL };
+  static char const* const hdep[] = {
+    "host_name central", "dependent_host_name poller", NULL };
+  static char const* const sdep[] = {
+    "host_name central", "service_description ping",
+    "dependent_host_name poller", "dependent_service_description ping",
+    NULL };
+
+  cfg.timeperiods().insert(create<configuration::timeperiod>(tp_24x7));
+  cfg.timeperiods().insert(
+    create<configuration::timeperiod>(tp_workhours));
+  cfg.commands().insert(create<configuration::command>(cmd_ping));
+  cfg.commands().insert(create<configuration::command>(cmd_http));
+  cfg.hosts().insert(create<configuration::host>(hst_router));
+  cfg.hosts().insert(create<configuration::host>(hst_central));
+  cfg.hosts().insert(create<configuration::host>(hst_poller));
+  cfg.services().insert(
+    create<configuration::service>(svc_central_ping));
+  cfg.services().insert(
+    create<configuration::service>(svc_central_http));
+  cfg.services().insert(create<configuration::service>(svc_poller_ping));
+  cfg.hostdependencies().insert(
+    create<configuration::hostdependency>(hdep));
+  cfg.servicedependencies().insert(
+    create<configuration::servicedependency>(sdep));
+  return ;
+}
+
+/**
+ *  Replace an object of a set by a modified copy.
+ *
+ *  @param[in,out] objects  Objects.
+ *  @param[in]     key      Key of the object to modify.
+ *  @param[in]     line     Property line to apply to the copy.
+ */
+template <typename T>
+static void modify(
+              std::set<shared_ptr<T> >& objects,
+              typename T::key_type const& key,
+              char const* line) {
+  for (typename std::set<shared_ptr<T> >::iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it)
+    if ((*it)->key() == key) {
+      shared_ptr<T> obj(new T(**it));
+      if (!static_cast<object&>(*obj).parse(line))
+        throw (engine_error() << "invalid line '" << line << "'");
+      objects.erase(it);
+      objects.insert(obj);
+      return ;
+    }
+  throw (engine_error() << "cannot modify missing object");
+}
+
+/**
+ *  Get the keys of some objects.
+ */
+static std::string keys(set_string const& names) {
+  std::ostringstream oss;
+  for (set_string::const_iterator
+         it(names.begin()), end(names.end());
+       it != end;
+       ++it)
+    oss << (it == names.begin() ? "" : ",") << *it;
+  return (oss.str());
+}
+
+template <typename T>
+static std::string keys(std::set<shared_ptr<T> > const& objects) {
+  set_string names;
+  for (typename std::set<shared_ptr<T> >::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it)
+    names.insert((*it)->key());
+  return (keys(names));
+}
+
+static std::string keys(set_service const& objects) {
+  set_string names;
+  for (set_service::const_iterator
+         it(objects.begin()), end(objects.end());
+       it != end;
+       ++it)
+    names.insert((*it)->key().first + "/" + (*it)->key().second);
+  return (keys(names));
+}
+
+/**
+ *  Select the objects to resolve when a reload replaces a
+ *  configuration by another, and check them.
+ *
+ *  @param[in] name          Name of the case.
+ *  @param[in] old_cfg       Current configuration.
+ *  @param[in] new_cfg       New configuration.
+ *  @param[in] timeperiods   Expected time periods.
+ *  @param[in] commands      Expected commands.
+ *  @param[in] hosts         Expected hosts.
+ *  @param[in] services      Expected services (host/description).
+ *  @param[in] dependencies  Expected number of host and service
+ *                           dependencies.
+ */
+static void check(
+              char const* name,
+              configuration::state const& old_cfg,
+              configuration::state const& new_cfg,
+              char const* timeperiods,
+              char const* commands,
+              char const* hosts,
+              char const* services,
+              unsigned int dependencies) {
+  applier::reference_index index;
+  for (set_timeperiod::const_iterator
+         it(old_cfg.timeperiods().begin()), end(old_cfg.timeperiods().end());
+       it != end;
+       ++it)
+    index.add(*it);
+  for (set_command::const_iterator
+         it(old_cfg.commands().begin()), end(old_cfg.commands().end());
+       it != end;
+       ++it)
+    index.add(*it);
+  for (set_host::const_iterator
+         it(old_cfg.hosts().begin()), end(old_cfg.hosts().end());
+       it != end;
+       ++it)
+    index.add(*it);
+  for (set_service::const_iterator
+         it(old_cfg.services().begin()), end(old_cfg.services().end());
+       it != end;
+       ++it)
+    index.add(*it);
+  for (set_hostdependency::const_iterator
+         it(old_cfg.hostdependencies().begin()),
+         end(old_cfg.hostdependencies().end());
+       it != end;
+       ++it)
+    index.add(*it);
+  for (set_servicedependency::const_iterator
+         it(old_cfg.servicedependencies().begin()),
+         end(old_cfg.servicedependencies().end());
+       it != end;
+       ++it)
+    index.add(*it);
+
+  configuration::state changed;
+  index.select_changes(
+    new_cfg,
+    applier::difference<set_timeperiod>(
+      old_cfg.timeperiods(),
+      new_cfg.timeperiods()),
+    applier::difference<set_connector>(
+      old_cfg.connectors(),
+      new_cfg.connectors()),
+    applier::difference<set_command>(
+      old_cfg.commands(),
+      new_cfg.commands()),
+    applier::difference<set_host>(old_cfg.hosts(), new_cfg.hosts()),
+    applier::difference<set_service>(
+      old_cfg.services(),
+      new_cfg.services()),
+    applier::difference<set_hostdependency>(
+      old_cfg.hostdependencies(),
+      new_cfg.hostdependencies()),
+    applier::difference<set_servicedependency>(
+      old_cfg.servicedependencies(),
+      new_cfg.servicedependencies()),
+    changed);
+
+  if ((keys(changed.timeperiods()) != timeperiods)
+      || (keys(changed.commands()) != commands)
+      || (keys(changed.hosts()) != hosts)
+      || (keys(changed.services()) != services)
+      || (changed.hostdependencies().size()
+          + changed.servicedependencies().size() != dependencies))
+    throw (engine_error() << name << ": resolved time periods '"
+           << keys(changed.timeperiods()) << "', commands '"
+           << keys(changed.commands()) << "', hosts '"
+           << keys(changed.hosts()) << "', services '"
+           << keys(changed.services()) << "' and "
+           << static_cast<unsigned int>(
+                changed.hostdependencies().size()
+                + changed.servicedependencies().size())
+           << " dependencies");
+  return ;
+}
+
+/**
+ *  Check that a partial reload resolves every object depending on
+ *  the objects that changed.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  configuration::state current;
+  fill(current);
+
+  // Nothing changed.
+  check("no change", current, current, "", "", "", "", 0);
+
+  // A host changed, for example through its template: its services
+  // and dependencies are resolved with it.
+  {
+    configuration::state cfg(current);
+    modify(cfg.hosts(), std::string("central"), "check_interval 2");
+    check(
+      "modified host",
+      current,
+      cfg,
+      "",
+      "",
+      "central",
+      "central/http,central/ping",
+      2);
+  }
+
+  // The check command of a service changed: the service is resolved,
+  // with its host and the other services of the host.
+  {
+    configuration::state cfg(current);
+    modify(
+      cfg.services(),
+      std::make_pair(std::string("poller"), std::string("ping")),
+      "check_command check_http");
+    check(
+      "modified service",
+      current,
+      cfg,
+      "",
+      "",
+      "poller",
+      "poller/ping",
+      2);
+  }
+
+  // A command changed in place: its users keep valid pointers.
+  {
+    configuration::state cfg(current);
+    modify(
+      cfg.commands(),
+      std::string("check_http"),
+      "command_line /bin/http -S $HOSTADDRESS$");
+    check("modified command", current, cfg, "", "check_http", "", "", 0);
+  }
+
+  // A time period was removed: its users must drop their pointer.
+  {
+    configuration::state cfg(current);
+    for (set_timeperiod::iterator
+           it(cfg.timeperiods().begin()), end(cfg.timeperiods().end());
+         it != end;
+         ++it)
+      if ((*it)->key() == "workhours") {
+        cfg.timeperiods().erase(it);
+        break ;
+      }
+    check(
+      "removed time period",
+      current,
+      cfg,
+      "",
+      "",
+      "central",
+      "central/http,central/ping",
+      2);
+  }
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -0,0 +1,80 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#include "com/centreon/engine/configuration/applier/scheduler.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Check that heavy checks are spread according to their execution
+ *  time.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  applier::scheduler& sched(applier::scheduler::instance());
+  time_t now(time(NULL));
+  time_t preferred(now + 300);
+
+  // Checks are not moved by default.
+  if (sched.spread_check(now, preferred, 10.0) != preferred)
+    throw (engine_error() << "check moved without load aware scheduling");
+
+  // Checks of 10 seconds with a 30 seconds slack do not overlap.
+  config->use_load_aware_scheduling(true);
+  for (unsigned int i(0); i < 4; ++i) {
+    time_t next(sched.spread_check(now, preferred, 10.0));
+    if (next != preferred + static_cast<time_t>(i) * 10)
+      throw (engine_error() << "check " << i << " scheduled at "
+             << next - preferred << " instead of " << i * 10);
+  }
+
+  // Without a free second, the least loaded one is chosen.
+  if (sched.spread_check(now, preferred, 10.0) != preferred)
+    throw (engine_error() << "check not scheduled at the least loaded time");
+
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
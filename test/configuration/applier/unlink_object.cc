@@ -0,0 +1,212 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <string>
+#include "com/centreon/engine/configuration/applier/object.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/hostdependency.hh"
+#include "com/centreon/engine/objects/service.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration::applier;
+
+/**
+ *  Link objects in a list the way objects are registered, each new
+ *  object being prepended to the list.
+ *
+ *  @param[in]  objects  Objects.
+ *  @param[in]  count    Number of objects.
+ *  @param[in]  linked   If false, predecessors are not set.
+ *
+ *  @return Head of the list.
+ */
+template <typename T>
+static T* build_list(T* objects, unsigned int count, bool linked) {
+  memset(objects, 0, count * sizeof(*objects));
+  T* head(NULL);
+  for (unsigned int i(0); i < count; ++i) {
+    objects[i].next = head;
+    if (head && linked)
+      head->prev = objects + i;
+    head = objects + i;
+  }
+  return (head);
+}
+
+/**
+ *  Check that a list holds the expected objects in both directions.
+ *
+ *  @param[in] name      Name of the checked case.
+ *  @param[in] head      Head of the list.
+ *  @param[in] expected  Expected objects, from head to tail.
+ *  @param[in] count     Number of expected objects.
+ */
+template <typename T>
+static void check_list(
+              std::string const& name,
+              T* head,
+              T* const* expected,
+              unsigned int count) {
+  if (count && head->prev)
+    throw (engine_error() << name << ": head has a predecessor");
+  T* last(NULL);
+  unsigned int i(0);
+  for (T* obj(head); obj; obj = obj->next, ++i) {
+    if ((i >= count) || (obj != expected[i]))
+      throw (engine_error() << name
+             << ": invalid forward link at position " << i);
+    last = obj;
+  }
+  if (i != count)
+    throw (engine_error() << name << ": got " << i
+           << " objects forward, expected " << count);
+  i = count;
+  for (T* obj(last); obj; obj = obj->prev) {
+    if (!i || (obj != expected[--i]))
+      throw (engine_error() << name
+             << ": invalid backward link at position " << i);
+  }
+  if (i)
+    throw (engine_error() << name << ": backward walk stopped at "
+           << i);
+  return ;
+}
+
+/**
+ *  Remove objects from the middle, the head and the tail of a list
+ *  and check links in both directions.
+ *
+ *  @param[in] name    Object type name.
+ *  @param[in] linked  If false, predecessors are not set and removal
+ *                     walks the list.
+ */
+template <typename T>
+static void check_unlink(std::string const& name, bool linked) {
+  std::string prefix(name + (linked ? " list" : " unlinked list"));
+  T objects[5];
+  T* head(build_list(objects, 5, linked));
+  if (linked) {
+    T* const all[] = {
+      objects + 4, objects + 3, objects + 2, objects + 1, objects };
+    check_list(prefix, head, all, 5);
+  }
+
+  // Middle of the list.
+  unlink_object(&head, objects + 2);
+  {
+    T* const expected[] = {
+      objects + 4, objects + 3, objects + 1, objects };
+    if (linked)
+      check_list(prefix + ", middle removed", head, expected, 4);
+  }
+
+  // Next to the head, after a walk the predecessor is set.
+  unlink_object(&head, objects + 3);
+  {
+    T* const expected[] = { objects + 4, objects + 1, objects };
+    if (linked)
+      check_list(prefix + ", second removed", head, expected, 3);
+    else if ((head != objects + 4)
+             || (head->next != objects + 1)
+             || (objects[1].prev != objects + 4))
+      throw (engine_error() << prefix
+             << ", second removed: invalid links");
+  }
+
+  if (!linked)
+    return ;
+
+  // Head.
+  unlink_object(&head, objects + 4);
+  {
+    T* const expected[] = { objects + 1, objects };
+    check_list(prefix + ", head removed", head, expected, 2);
+  }
+
+  // Tail.
+  unlink_object(&head, objects);
+  {
+    T* const expected[] = { objects + 1 };
+    check_list(prefix + ", tail removed", head, expected, 1);
+  }
+
+  // Last object.
+  unlink_object(&head, objects + 1);
+  check_list<T>(prefix + ", all removed", head, NULL, 0);
+  return ;
+}
+
+/**
+ *  Remove dependencies from the dependency list of their dependent
+ *  host and check the remaining list.
+ */
+static void check_unregister_dependency() {
+  hostdependency_struct deps[3];
+  memset(deps, 0, sizeof(deps));
+  host_struct hst;
+  memset(&hst, 0, sizeof(hst));
+  for (unsigned int i(0); i < 3; ++i) {
+    deps[i].next_dependency = hst.dependencies;
+    hst.dependencies = deps + i;
+  }
+
+  unregister_dependency(&hst.dependencies, deps + 1);
+  if ((hst.dependencies != deps + 2)
+      || (deps[2].next_dependency != deps)
+      || deps[0].next_dependency
+      || deps[1].next_dependency)
+    throw (engine_error()
+           << "host dependency not removed from the middle of its list");
+
+  unregister_dependency(&hst.dependencies, deps + 2);
+  unregister_dependency(&hst.dependencies, deps);
+  if (hst.dependencies)
+    throw (engine_error() << "host dependency list not emptied");
+  return ;
+}
+
+/**
+ *  Check that unlink_object() keeps host and service lists linked in
+ *  both directions, and that unregister_dependency() unlinks removed
+ *  dependencies.
+ *
+ *  @return 0 on success.
+ */
+int main_test(int argc, char* argv[]) {
+  (void)argc;
+  (void)argv;
+
+  check_unlink<host_struct>("host", true);
+  check_unlink<host_struct>("host", false);
+  check_unlink<service_struct>("service", true);
+  check_unlink<service_struct>("service", false);
+  check_unregister_dependency();
+  return (0);
+}
+
+/**
+ *  Init unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
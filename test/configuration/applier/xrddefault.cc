@@ -771,8 +771,8 @@ int xrddefault_read_state_information() {
               delete[] tempval;
 
               if (temp_command != NULL && temp_ptr != NULL) {
-                delete[] temp_host->host_check_command;
-                temp_host->host_check_command = temp_ptr;
+                string::setintern(temp_host->host_check_command, temp_ptr);
+                delete[] temp_ptr;
               }
               else
                 temp_host->modified_attributes -= MODATTR_CHECK_COMMAND;
@@ -785,8 +785,8 @@ int xrddefault_read_state_information() {
               temp_ptr = string::dup(val);
 
               if (temp_timeperiod != NULL && temp_ptr != NULL) {
-                delete[] temp_host->check_period;
-                temp_host->check_period = temp_ptr;
+                string::setintern(temp_host->check_period, temp_ptr);
+                delete[] temp_ptr;
               }
               else
                 temp_host->modified_attributes -= MODATTR_CHECK_TIMEPERIOD;
@@ -802,8 +802,8 @@ int xrddefault_read_state_information() {
               delete[] tempval;
 
               if (temp_command != NULL && temp_ptr != NULL) {
-                delete[] temp_host->event_handler;
-                temp_host->event_handler = temp_ptr;
+                string::setintern(temp_host->event_handler, temp_ptr);
+                delete[] temp_ptr;
               }
               else
                 temp_host->modified_attributes -= MODATTR_EVENT_HANDLER_COMMAND;
@@ -985,8 +985,8 @@ int xrddefault_read_state_information() {
             delete[] tempval;
 
             if (temp_command != NULL && temp_ptr != NULL) {
-              delete[] temp_service->service_check_command;
-              temp_service->service_check_command = temp_ptr;
+              string::setintern(temp_service->service_check_command, temp_ptr);
+              delete[] temp_ptr;
             }
             else
               temp_service->modified_attributes -= MODATTR_CHECK_COMMAND;
@@ -999,8 +999,8 @@ int xrddefault_read_state_information() {
             temp_ptr = string::dup(val);
 
             if (temp_timeperiod != NULL && temp_ptr != NULL) {
-              delete[] temp_service->check_period;
-              temp_service->check_period = temp_ptr;
+              string::setintern(temp_service->check_period, temp_ptr);
+              delete[] temp_ptr;
             }
             else
               temp_service->modified_attributes -= MODATTR_CHECK_TIMEPERIOD;
@@ -1016,8 +1016,8 @@ int xrddefault_read_state_information() {
             delete[] tempval;
 
             if (temp_command != NULL && temp_ptr != NULL) {
-              delete[] temp_service->event_handler;
-              temp_service->event_handler = temp_ptr;
+              string::setintern(temp_service->event_handler, temp_ptr);
+              delete[] temp_ptr;
             }
             else
               temp_service->modified_attributes -= MODATTR_EVENT_HANDLER_COMMAND;
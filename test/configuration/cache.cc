@@ -0,0 +1,284 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <utime.h>
+#include "com/centreon/engine/configuration/cache.hh"
+#include "com/centreon/engine/configuration/command.hh"
+#include "com/centreon/engine/configuration/connector.hh"
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/hostdependency.hh"
+#include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/servicedependency.hh"
+#include "com/centreon/engine/configuration/timeperiod.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Compare two objects with the operator of their type.
+ *
+ *  @param[in] left   First object.
+ *  @param[in] right  Second object.
+ *
+ *  @return True if both objects are equal.
+ */
+template <typename T>
+static bool is_equal(object const& left, object const& right) {
+  return (static_cast<T const&>(left) == static_cast<T const&>(right));
+}
+
+/**
+ *  Compare two objects of any type.
+ *
+ *  @param[in] left   First object.
+ *  @param[in] right  Second object.
+ *
+ *  @return True if both objects are equal.
+ */
+static bool is_equal(object_ptr const& left, object_ptr const& right) {
+  if (left->type() != right->type())
+    return (false);
+  switch (left->type()) {
+  case object::command:
+    return (is_equal<configuration::command>(*left, *right));
+  case object::connector:
+    return (is_equal<configuration::connector>(*left, *right));
+  case object::host:
+    return (is_equal<configuration::host>(*left, *right));
+  case object::hostdependency:
+    return (is_equal<configuration::hostdependency>(*left, *right));
+  case object::service:
+    return (is_equal<configuration::service>(*left, *right));
+  case object::servicedependency:
+    return (is_equal<configuration::servicedependency>(*left, *right));
+  case object::timeperiod:
+    return (is_equal<configuration::timeperiod>(*left, *right));
+  }
+  return (false);
+}
+
+/**
+ *  Create an object from configuration lines.
+ *
+ *  @param[in] type   Object type name.
+ *  @param[in] lines  NULL-terminated property lines.
+ *
+ *  @return New object.
+ */
+static object_ptr create(char const* type, char const* const* lines) {
+  object_ptr obj(object::create(type));
+  for (; *lines; ++lines)
+    if (!obj->parse(*lines))
+      throw (engine_error() << "invalid " << type << " line '"
+             << *lines << "'");
+  return (obj);
+}
+
+/**
+ *  Read a whole file.
+ *
+ *  @param[in] path  File path.
+ *
+ *  @return File content.
+ */
+static std::string read_file(char const* path) {
+  std::ifstream ifs(path, std::ios::binary);
+  return (std::string(
+                std::istreambuf_iterator<char>(ifs),
+                std::istreambuf_iterator<char>()));
+}
+
+/**
+ *  Check that resolved objects are saved in the configuration cache
+ *  and loaded back only when their sources did not change.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  char path[] = "/tmp/centengine_cache.XXXXXX";
+  int fd(mkstemp(path));
+  if (fd < 0)
+    throw (engine_error() << "cannot create temporary file");
+  close(fd);
+
+  try {
+    static char const* const command_lines[] = {
+      "command_name check_ping",
+      "command_line $USER1$/check_ping -H $HOSTADDRESS$",
+      "connector perl",
+      NULL
+    };
+    static char const* const connector_lines[] = {
+      "connector_name perl",
+      "connector_line /usr/lib/centreon-connector/centreon_connector_perl",
+      NULL
+    };
+    static char const* const host_lines[] = {
+      "host_name central",
+      "host_id 1",
+      "address 127.0.0.1",
+      "check_command check_ping",
+      "check_interval 5",
+      "parents +poller",
+      "_SNMPCOMMUNITY public",
+      NULL
+    };
+    static char const* const hostdependency_lines[] = {
+      "host_name central",
+      "dependent_host_name poller",
+      "execution_failure_options d,u",
+      NULL
+    };
+    static char const* const service_lines[] = {
+      "host_name central",
+      "service_description ping",
+      "service_id 1",
+      "check_command check_ping",
+      "flap_detection_options o,w",
+      "timezone :Europe/Paris",
+      NULL
+    };
+    static char const* const servicedependency_lines[] = {
+      "host_name central",
+      "service_description ping",
+      "dependent_host_name poller",
+      "dependent_service_description ping",
+      NULL
+    };
+    static char const* const timeperiod_lines[] = {
+      "timeperiod_name workhours",
+      "alias Work Hours",
+      "monday 09:00-12:00,14:00-18:00",
+      "2015-12-25 00:00-24:00",
+      "day 1 - 15 / 2 10:00-11:00",
+      "thursday -1 november 00:00-24:00",
+      "exclude holidays",
+      NULL
+    };
+    list_object objects;
+    objects.push_back(create("command", command_lines));
+    objects.push_back(create("connector", connector_lines));
+    objects.push_back(create("host", host_lines));
+    objects.push_back(create("hostdependency", hostdependency_lines));
+    objects.push_back(create("service", service_lines));
+    objects.push_back(create("servicedependency", servicedependency_lines));
+    objects.push_back(create("timeperiod", timeperiod_lines));
+
+    // Missing cache.
+    std::list<std::string> sources;
+    unlink(path);
+    list_object loaded;
+    if (cache(path, sources, 1).load(loaded) || !loaded.empty())
+      throw (engine_error() << "missing cache loaded");
+
+    // Round trip.
+    cache(path, sources, 1).save(objects);
+    if (!cache(path, sources, 1).load(loaded))
+      throw (engine_error() << "cannot load cache");
+    if (loaded.size() != objects.size())
+      throw (engine_error()
+             << static_cast<unsigned int>(loaded.size())
+             << " objects loaded instead of "
+             << static_cast<unsigned int>(objects.size()));
+    for (list_object::const_iterator
+           it(objects.begin()),
+           end(objects.end()),
+           it_loaded(loaded.begin());
+         it != end;
+         ++it, ++it_loaded)
+      if (!is_equal(*it, *it_loaded))
+        throw (engine_error() << (*it)->type_name()
+               << " changed in cache");
+
+    // Other sources.
+    loaded.clear();
+    if (cache(path, sources, 2).load(loaded) || !loaded.empty())
+      throw (engine_error() << "cache loaded with other read options");
+    sources.push_back(path);
+    if (cache(path, sources, 1).load(loaded) || !loaded.empty())
+      throw (engine_error() << "cache loaded with other sources");
+
+    // Sources that were just modified cannot be trusted, the cache
+    // file is left as it is. The source is dated in the future so
+    // that the check does not depend on the current second.
+    std::string const source(std::string(path) + ".cfg");
+    std::ofstream(source.c_str()) << "# object file\n";
+    utimbuf times;
+    times.actime = times.modtime = time(NULL) + 3600;
+    if (utime(source.c_str(), &times))
+      throw (engine_error() << "cannot set times of " << source);
+    std::list<std::string> unstable;
+    unstable.push_back(source);
+    std::string const before(read_file(path));
+    cache(path, unstable, 1).save(objects);
+    unlink(source.c_str());
+    if (read_file(path) != before)
+      throw (engine_error() << "cache saved with unstable sources");
+
+    // Corrupted cache.
+    sources.clear();
+    cache(path, sources, 1).save(objects);
+    {
+      std::fstream fs(
+                     path,
+                     std::ios::in | std::ios::out | std::ios::binary);
+      fs.seekp(-1, std::ios::end);
+      fs.put('\xff');
+    }
+    if (cache(path, sources, 1).load(loaded) || !loaded.empty())
+      throw (engine_error() << "corrupted cache loaded");
+  }
+  catch (...) {
+    unlink(path);
+    unlink((std::string(path) + ".cfg").c_str());
+    throw ;
+  }
+  unlink(path);
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
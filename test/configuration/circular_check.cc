@@ -0,0 +1,203 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+#include <vector>
+#include "com/centreon/engine/config.hh"
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/globals.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+static char name[] = "name";
+
+/**
+ *  Run the circular check.
+ *
+ *  @return Number of errors found.
+ */
+static int run_check() {
+  int warnings(0);
+  int errors(0);
+  int retval(pre_flight_circular_check(&warnings, &errors));
+  if ((retval == OK) != (errors == 0))
+    throw (engine_error() << "circular check return value is "
+           "inconsistent with its error count");
+  return (errors);
+}
+
+/**
+ *  Check parent/child loops between hosts.
+ */
+static void check_host_parents() {
+  std::vector<host> hosts(4);
+  std::vector<hostsmember> children(4);
+  memset(&hosts[0], 0, hosts.size() * sizeof(hosts[0]));
+  memset(&children[0], 0, children.size() * sizeof(children[0]));
+  for (unsigned int i(0); i < hosts.size(); ++i) {
+    hosts[i].name = name;
+    hosts[i].next = ((i + 1 < hosts.size()) ? &hosts[i + 1] : NULL);
+  }
+  host_list = &hosts[0];
+
+  // 0 -> 1 -> 2, 3 is alone.
+  children[0].host_ptr = &hosts[1];
+  hosts[0].child_hosts = &children[0];
+  children[1].host_ptr = &hosts[2];
+  hosts[1].child_hosts = &children[1];
+  if (run_check())
+    throw (engine_error() << "hosts without loop reported as circular");
+
+  // 0 -> 1 -> 2 -> 0.
+  children[2].host_ptr = &hosts[0];
+  hosts[2].child_hosts = &children[2];
+  if (run_check() != 1)
+    throw (engine_error() << "host loop was not reported");
+
+  // 3 is its own parent.
+  hosts[2].child_hosts = NULL;
+  children[3].host_ptr = &hosts[3];
+  hosts[3].child_hosts = &children[3];
+  if (run_check() != 1)
+    throw (engine_error() << "self parent host was not reported");
+
+  host_list = NULL;
+  return ;
+}
+
+/**
+ *  Check circular service dependencies, on a long dependency chain.
+ */
+static void check_service_dependencies() {
+  unsigned int const count(20000);
+  std::vector<service> services(count + 1);
+  std::vector<servicedependency> deps(count + 1);
+  memset(&services[0], 0, services.size() * sizeof(services[0]));
+  memset(&deps[0], 0, deps.size() * sizeof(deps[0]));
+
+  // Service i depends on service i + 1.
+  for (unsigned int i(0); i < count; ++i) {
+    deps[i].host_name = name;
+    deps[i].service_description = name;
+    deps[i].dependent_service_ptr = &services[i];
+    deps[i].master_service_ptr = &services[i + 1];
+    deps[i].next = ((i + 1 < count) ? &deps[i + 1] : NULL);
+  }
+  servicedependency_list = &deps[0];
+
+  timeval start;
+  gettimeofday(&start, NULL);
+  if (run_check())
+    throw (engine_error() << "service dependency chain reported "
+           "as circular");
+  timeval end;
+  gettimeofday(&end, NULL);
+  if (end.tv_sec - start.tv_sec > 5)
+    throw (engine_error() << "circular check of " << count
+           << " service dependencies is too slow");
+
+  // The last service depends on the first one.
+  deps[count - 1].next = &deps[count];
+  deps[count].host_name = name;
+  deps[count].service_description = name;
+  deps[count].dependent_service_ptr = &services[count];
+  deps[count].master_service_ptr = &services[0];
+  if (run_check() != static_cast<int>(count + 1))
+    throw (engine_error() << "circular service dependencies were "
+           "not all reported");
+
+  // A single dependency of a service on itself is harmless.
+  servicedependency* self(&deps[count]);
+  self->dependent_service_ptr = &services[0];
+  self->next = NULL;
+  servicedependency_list = self;
+  if (run_check())
+    throw (engine_error() << "self service dependency reported "
+           "as circular");
+
+  servicedependency_list = NULL;
+  return ;
+}
+
+/**
+ *  Check circular host dependencies.
+ */
+static void check_host_dependencies() {
+  std::vector<host> hosts(3);
+  std::vector<hostdependency> deps(3);
+  memset(&hosts[0], 0, hosts.size() * sizeof(hosts[0]));
+  memset(&deps[0], 0, deps.size() * sizeof(deps[0]));
+
+  // 0 depends on 1, 1 on 2, 2 on 0.
+  for (unsigned int i(0); i < deps.size(); ++i) {
+    deps[i].host_name = name;
+    deps[i].dependent_host_ptr = &hosts[i];
+    deps[i].master_host_ptr = &hosts[(i + 1) % hosts.size()];
+    deps[i].next = ((i + 1 < deps.size()) ? &deps[i + 1] : NULL);
+  }
+  hostdependency_list = &deps[0];
+  if (run_check() != 3)
+    throw (engine_error() << "circular host dependencies were "
+           "not all reported");
+
+  // Break the loop.
+  deps[1].next = NULL;
+  if (run_check())
+    throw (engine_error() << "host dependency chain reported "
+           "as circular");
+
+  hostdependency_list = NULL;
+  return ;
+}
+
+/**
+ *  Check the detection of circular paths and dependencies.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  verify_circular_paths = true;
+  check_host_parents();
+  check_service_dependencies();
+  check_host_dependencies();
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
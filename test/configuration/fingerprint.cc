@@ -0,0 +1,113 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check that two objects compare as expected.
+ *
+ *  @param[in] obj1   First object.
+ *  @param[in] obj2   Second object.
+ *  @param[in] equal  Expected result.
+ *  @param[in] step   Test step, for error messages.
+ */
+static void expect(
+              configuration::object const& obj1,
+              configuration::object const& obj2,
+              bool equal,
+              char const* step) {
+  if ((obj1 == obj2) != equal)
+    throw (engine_error() << step << ": objects should "
+           << (equal ? "" : "not ") << "be equal");
+  if ((obj1.get_fingerprint() == obj2.get_fingerprint()) != equal)
+    throw (engine_error() << step << ": fingerprints should "
+           << (equal ? "" : "not ") << "be equal");
+  return ;
+}
+
+/**
+ *  Check that fingerprints follow the modifications of objects.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Hosts.
+  configuration::host h1("central");
+  h1.parse("address", "10.0.0.1");
+  h1.parse("_SNMP_COMMUNITY", "public");
+  configuration::host h2(h1);
+  expect(h1, h2, true, "host copy");
+  h2.parse("_SNMP_COMMUNITY", "private");
+  expect(h1, h2, false, "host custom variable");
+  h1.parse("_SNMP_COMMUNITY", "private");
+  expect(h1, h2, true, "host same custom variable");
+  h2.parents().push_back("gateway");
+  expect(h1, h2, false, "host parents");
+  h2 = h1;
+  expect(h1, h2, true, "host assignment");
+  h2.host_name() = "remote";
+  expect(h1, h2, false, "host name");
+
+  // Services.
+  configuration::service s1;
+  s1.hosts().push_back("central");
+  s1.service_description() = "ping";
+  configuration::service s2(s1);
+  expect(s1, s2, true, "service copy");
+  s2.service_description() = "cpu";
+  expect(s1, s2, false, "service description");
+  s2.service_description() = "ping";
+  expect(s1, s2, true, "service same description");
+
+  // Templates.
+  configuration::service tmpl;
+  tmpl.parse("check_command", "check_ping");
+  s2.merge(tmpl);
+  expect(s1, s2, false, "service template");
+  s1.merge(tmpl);
+  expect(s1, s2, true, "service same template");
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
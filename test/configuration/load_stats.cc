@@ -0,0 +1,95 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <sstream>
+#include "com/centreon/engine/configuration/load_stats.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check that configuration load phases are timed and published.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Nothing is published before a load completes.
+  configuration::load_stats::report r;
+  configuration::load_stats::phase("ignored");
+  configuration::load_stats::end();
+  if (configuration::load_stats::get(r))
+    throw (engine_error() << "timings published without load");
+
+  // Phases of the same name are summed.
+  configuration::load_stats::begin(true);
+  configuration::load_stats::phase("parse");
+  configuration::load_stats::phase("apply");
+  configuration::load_stats::phase("parse");
+  configuration::load_stats::end(0.5);
+  if (!configuration::load_stats::get(r))
+    throw (engine_error() << "timings not published");
+  if (!r.reload || (r.paused_time != 0.5))
+    throw (engine_error() << "invalid load summary");
+  if ((r.phases.size() != 2)
+      || (r.phases.front().phase != "parse")
+      || (r.phases.back().phase != "apply"))
+    throw (engine_error() << "invalid phases");
+  if (r.phases.front().duration + r.phases.back().duration
+      > r.total_time)
+    throw (engine_error() << "phases last longer than the load");
+
+  // Phases are ignored once the load is over.
+  configuration::load_stats::phase("late");
+  configuration::load_stats::end();
+  configuration::load_stats::get(r);
+  if (r.phases.size() != 2)
+    throw (engine_error() << "phase recorded after the load");
+
+  // Status file format.
+  std::ostringstream oss;
+  configuration::load_stats::save(oss);
+  if ((oss.str().find("configurationloadstatus {\n") != 0)
+      || (oss.str().find("\treload=1\n") == std::string::npos)
+      || (oss.str().find("\tphase=apply,") == std::string::npos))
+    throw (engine_error() << "invalid status: " << oss.str());
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
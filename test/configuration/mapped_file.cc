@@ -0,0 +1,158 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/mapped_file.hh"
+#include "com/centreon/engine/error.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check the next line of a file.
+ *
+ *  @param[in,out] file      Mapped file.
+ *  @param[in,out] pos       Line number.
+ *  @param[in]     join      Join continuations.
+ *  @param[in]     expected  Expected line.
+ *  @param[in]     line      Expected line number.
+ */
+static void expect(
+              configuration::mapped_file& file,
+              unsigned int& pos,
+              bool join,
+              char const* expected,
+              unsigned int line) {
+  char* value;
+  if (!file.next_line(value, pos, join))
+    throw (engine_error() << "missing line '" << expected << "'");
+  if (strcmp(value, expected) || (pos != line))
+    throw (engine_error() << "got '" << value << "' on line " << pos
+           << " instead of '" << expected << "' on line " << line);
+  return ;
+}
+
+/**
+ *  Replace the content of a file.
+ *
+ *  @param[in] path     File path.
+ *  @param[in] content  File content.
+ */
+static void write(std::string const& path, char const* content) {
+  std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+  ofs << content;
+  return ;
+}
+
+/**
+ *  Check that mapped files are split in lines like
+ *  string::get_next_line() does.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  char path[] = "/tmp/centengine_mapped_file.XXXXXX";
+  int fd(mkstemp(path));
+  if (fd < 0)
+    throw (engine_error() << "cannot create temporary file");
+  close(fd);
+
+  try {
+    // Missing file.
+    configuration::mapped_file file;
+    if (file.open(std::string(path) + ".missing"))
+      throw (engine_error() << "missing file opened");
+
+    // Empty file.
+    unsigned int pos(0);
+    char* line;
+    write(path, "");
+    if (!file.open(path) || file.next_line(line, pos))
+      throw (engine_error() << "empty file has lines");
+
+    // Comments, blank lines and trimming.
+    write(
+      path,
+      "# comment\n"
+      "\n"
+      "  define host {\r\n"
+      "\t; comment\n"
+      "  host_name   central  \n"
+      "}\n");
+    pos = 0;
+    if (!file.open(path))
+      throw (engine_error() << "cannot open file");
+    expect(file, pos, false, "define host {", 3);
+    expect(file, pos, false, "host_name   central", 5);
+    expect(file, pos, false, "}", 6);
+    if (file.next_line(line, pos))
+      throw (engine_error() << "unexpected line '" << line << "'");
+
+    // Continuations and missing final newline.
+    write(
+      path,
+      "check_command check_ping!100.0,20%\\\n"
+      "# comment\n"
+      "   !500.0,60% \\\n"
+      "!3\n"
+      "notes not\\\n"
+      "joined\n"
+      "last line");
+    pos = 0;
+    if (!file.open(path))
+      throw (engine_error() << "cannot open file");
+    expect(file, pos, true, "check_command check_ping!100.0,20%!500.0,60% !3", 4);
+    expect(file, pos, false, "notes not\\", 5);
+    expect(file, pos, true, "joined", 6);
+    expect(file, pos, true, "last line", 7);
+    if (file.next_line(line, pos, true))
+      throw (engine_error() << "unexpected line '" << line << "'");
+  }
+  catch (...) {
+    unlink(path);
+    throw ;
+  }
+  unlink(path);
+  return (EXIT_SUCCESS);
+}
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
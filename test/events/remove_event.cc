@@ -0,0 +1,112 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/events/defines.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/globals.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check that the event list links match the expected order.
+ *
+ *  @param[in] events    Events.
+ *  @param[in] expected  Expected indexes in events, -1 terminated.
+ */
+static void check_list(timed_event* events, int const* expected) {
+  timed_event* prev(NULL);
+  timed_event* evt(event_list_low);
+  for (; *expected >= 0; ++expected, prev = evt, evt = evt->next) {
+    if (evt != events + *expected)
+      throw (engine_error() << "event " << *expected
+             << " is not at its place");
+    if (evt->prev != prev)
+      throw (engine_error() << "event " << *expected
+             << " has an invalid predecessor");
+  }
+  if (evt)
+    throw (engine_error() << "event list is too long");
+  if (event_list_low_tail != prev)
+    throw (engine_error() << "event list tail is invalid");
+  return ;
+}
+
+/**
+ *  Check that events are removed from anywhere in the list.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argv Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  timed_event events[5];
+  memset(events, 0, sizeof(events));
+  for (unsigned int i(0); i < sizeof(events) / sizeof(*events); ++i) {
+    events[i].event_type = EVENT_USER_FUNCTION;
+    events[i].run_time = 1000 + i;
+    add_event(events + i, &event_list_low, &event_list_low_tail);
+  }
+  static int const all[] = { 0, 1, 2, 3, 4, -1 };
+  check_list(events, all);
+
+  // Middle, head and tail.
+  remove_event(events + 2, &event_list_low, &event_list_low_tail);
+  static int const no_middle[] = { 0, 1, 3, 4, -1 };
+  check_list(events, no_middle);
+  remove_event(events, &event_list_low, &event_list_low_tail);
+  static int const no_head[] = { 1, 3, 4, -1 };
+  check_list(events, no_head);
+  remove_event(events + 4, &event_list_low, &event_list_low_tail);
+  static int const no_tail[] = { 1, 3, -1 };
+  check_list(events, no_tail);
+
+  // Events that are not in the list are ignored.
+  remove_event(events + 2, &event_list_low, &event_list_low_tail);
+  check_list(events, no_tail);
+
+  // Last events.
+  remove_event(events + 3, &event_list_low, &event_list_low_tail);
+  remove_event(events + 1, &event_list_low, &event_list_low_tail);
+  static int const empty[] = { -1 };
+  check_list(events, empty);
+  return (EXIT_SUCCESS);
+}
+
+/**
+ *  Init unit test.
+ *
+ *  @param[in] argc Argument count.
+ *  @param[in] argc Argument values.
+ *
+ *  @return Same as main_test().
+ *
+ *  @see main_test
+ */
+int main(int argc, char* argv[]) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
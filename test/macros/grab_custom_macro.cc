@@ -0,0 +1,141 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "test/macros/minimal_setup.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check one custom macro.
+ *
+ *  @param[in] mac       Macro object.
+ *  @param[in] name      Macro name.
+ *  @param[in] expected  Expected value, NULL if the macro should not
+ *                       be found.
+ *
+ *  @return 0 on success.
+ */
+static int check(
+             nagios_macros* mac,
+             char const* name,
+             char const* expected) {
+  char* output(NULL);
+  int result(grab_custom_macro_value_r(
+               mac,
+               const_cast<char*>(name),
+               NULL,
+               NULL,
+               &output));
+  int retval(0);
+  if (!expected) {
+    if (result == OK) {
+      std::cout << "macro " << name << " should not exist" << std::endl;
+      retval = 1;
+    }
+  }
+  else if ((result != OK) || !output || strcmp(output, expected)) {
+    std::cout << "failing macro: " << name << " ("
+              << (output ? output : "(null)") << " != "
+              << expected << ")" << std::endl;
+    retval = 1;
+  }
+  delete [] output;
+  return (retval);
+}
+
+/**
+ *  Check that custom macros are found with and without index.
+ *
+ *  @return 0 on success.
+ */
+int main_test(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+
+  // Create minimal context.
+  test::minimal_setup();
+
+  // Set custom variables, the last one shadows the first one.
+  add_custom_variable_to_host(host_list, "SNMP_COMMUNITY", "public");
+  add_custom_variable_to_host(host_list, "LOCATION", "paris");
+  add_custom_variable_to_host(host_list, "SNMP_COMMUNITY", "private");
+  add_custom_variable_to_service(service_list, "WARNING", "80");
+  add_custom_variable_to_service(service_list, "CRITICAL", "90");
+  char varname[16];
+  for (unsigned int i(0); i < 40; ++i) {
+    snprintf(varname, sizeof(varname), "VAR%u", i);
+    add_custom_variable_to_service(service_list, varname, varname);
+  }
+
+  // Macro object.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  mac.host_ptr = host_list;
+  mac.service_ptr = service_list;
+
+  int retval(0);
+  for (unsigned int pass(0); pass < 2; ++pass) {
+    // Second pass uses the index.
+    if (pass) {
+      index_customvariables(
+        host_list->custom_variables_index,
+        host_list->custom_variables);
+      index_customvariables(
+        service_list->custom_variables_index,
+        service_list->custom_variables);
+    }
+    else if (host_list->custom_variables_index
+             || service_list->custom_variables_index)
+      retval |= 1;
+
+    retval |= check(&mac, "_HOSTSNMP_COMMUNITY", "private");
+    retval |= check(&mac, "_HOSTLOCATION", "paris");
+    retval |= check(&mac, "_HOSTUNKNOWN", NULL);
+    retval |= check(&mac, "_HOSTlocation", NULL);
+    retval |= check(&mac, "_SERVICEWARNING", "80");
+    retval |= check(&mac, "_SERVICECRITICAL", "90");
+    retval |= check(&mac, "_SERVICEVAR0", "VAR0");
+    retval |= check(&mac, "_SERVICEVAR39", "VAR39");
+    retval |= check(&mac, "_SERVICEVAR40", NULL);
+    retval |= check(&mac, "_SERVICESNMP_COMMUNITY", NULL);
+  }
+
+  // Adding a variable drops the index.
+  add_custom_variable_to_host(host_list, "ROOM", "42");
+  if (host_list->custom_variables_index)
+    retval |= 1;
+  retval |= check(&mac, "_HOSTROOM", "42");
+
+  return (retval);
+}
+
+/**
+ *  Init unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
@@ -84,8 +84,7 @@ int main_test(int argc, char** argv) {
   service_list->last_hard_state = 0;
 
   // Set host values.
-  delete [] host_list->name;
-  host_list->name = string::dup(STR(NAME));
+  string::setintern(host_list->name, STR(NAME));
   delete [] host_list->alias;
   host_list->alias = string::dup(STR(ALIAS));
   delete [] host_list->address;
@@ -100,8 +99,7 @@ int main_test(int argc, char** argv) {
   host_list->long_plugin_output = string::dup(STR(LONG_OUTPUT));
   delete [] host_list->perf_data;
   host_list->perf_data = string::dup(STR(PERF_DATA));
-  delete [] host_list->host_check_command;
-  host_list->host_check_command = string::dup(STR(CHECK_COMMAND));
+  string::setintern(host_list->host_check_command, STR(CHECK_COMMAND));
   host_list->current_attempt = ATTEMPT;
   host_list->max_attempts = MAX_ATTEMPTS;
   host_list->percent_state_change = PERCENT_CHANGE;
@@ -75,16 +75,16 @@ int main_test(int argc, char** argv) {
   test::minimal_setup();
 
   // Set service values.
-  delete [] service_list->description;
-  service_list->description = string::dup(STR(DESCRIPTION));
+  string::setintern(service_list->description, STR(DESCRIPTION));
   delete [] service_list->plugin_output;
   service_list->plugin_output = string::dup(STR(OUTPUT));
   delete [] service_list->long_plugin_output;
   service_list->long_plugin_output = string::dup(STR(LONG_OUTPUT));
   delete [] service_list->perf_data;
   service_list->perf_data = string::dup(STR(PERF_DATA));
-  delete [] service_list->service_check_command;
-  service_list->service_check_command = string::dup(STR(CHECK_COMMAND));
+  string::setintern(
+    service_list->service_check_command,
+    STR(CHECK_COMMAND));
   service_list->check_type = SERVICE_CHECK_PASSIVE;
   service_list->state_type = SOFT_STATE;
   service_list->current_state = STATE_ID;
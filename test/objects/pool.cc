@@ -0,0 +1,94 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/objects/hostsmember.hh"
+#include "com/centreon/engine/objects/pool.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check that object list nodes are reused and that slabs are freed
+ *  once no node is in use anymore.
+ *
+ *  @return 0 on success.
+ */
+int main_test(int argc, char* argv[]) {
+  (void)argc;
+  (void)argv;
+
+  typedef node_pool<hostsmember> pool;
+  unsigned int const count(10000);
+
+  // Allocate enough nodes to fill several slabs.
+  hostsmember* head(NULL);
+  for (unsigned int i(0); i < count; ++i) {
+    hostsmember* obj(pool::allocate());
+    memset(obj, 0, sizeof(*obj));
+    obj->next = head;
+    head = obj;
+  }
+  if (pool::used() != count)
+    throw (engine_error() << "invalid number of nodes in use: got "
+           << static_cast<unsigned int>(pool::used())
+           << ", expected " << count);
+  unsigned long slabs(pool::slabs());
+  if (slabs < 2)
+    throw (engine_error() << "nodes were not allocated from slabs");
+
+  // Slabs must not be freed while nodes are in use.
+  pool::purge();
+  if (pool::slabs() != slabs)
+    throw (engine_error() << "slabs were freed while in use");
+
+  // Released nodes are reused before growing the pool.
+  hostsmember* released(head);
+  head = head->next;
+  pool::release(released);
+  if (pool::allocate() != released)
+    throw (engine_error() << "released node was not reused");
+  if (pool::slabs() != slabs)
+    throw (engine_error() << "pool grew while a node was free");
+  released->next = head;
+  head = released;
+
+  // Release everything and purge.
+  while (head) {
+    hostsmember* next(head->next);
+    pool::release(head);
+    head = next;
+  }
+  pool::release(NULL);
+  if (pool::used())
+    throw (engine_error() << "nodes still in use after release");
+  pool::purge();
+  if (pool::slabs())
+    throw (engine_error() << "slabs were not freed by purge");
+  return (0);
+}
+
+/**
+ *  Init unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
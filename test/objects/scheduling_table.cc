@@ -0,0 +1,98 @@
+/*
+** Copyright 2015 Merethis
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/objects/scheduling_table.hh"
+#include "com/centreon/engine/objects/service.hh"
+#include "test/unittest.hh"
+
+using namespace com::centreon::engine;
+
+typedef scheduling_table<service_struct> table;
+
+/**
+ *  Check that every registered service is found at its index.
+ *
+ *  @param[in] services  Services.
+ *  @param[in] count     Number of services.
+ */
+static void check_entries(
+              service_struct const* services,
+              unsigned int count) {
+  unsigned int registered(0);
+  for (unsigned int i(0); i < count; ++i) {
+    service_struct const& svc(services[i]);
+    if (!svc.scheduling_index)
+      continue;
+    ++registered;
+    if (table::at(svc.scheduling_index - 1) != &svc)
+      throw (engine_error() << "invalid entry of service " << i);
+  }
+  if (registered != table::size())
+    throw (engine_error() << "invalid table size: got "
+           << table::size() << ", expected " << registered);
+  return ;
+}
+
+/**
+ *  Check that the scheduling table follows registration and removal
+ *  of services.
+ *
+ *  @return 0 on success.
+ */
+int main_test(int argc, char* argv[]) {
+  (void)argc;
+  (void)argv;
+
+  unsigned int const count(8);
+  service_struct services[count];
+  memset(services, 0, sizeof(services));
+  for (unsigned int i(0); i < count; ++i)
+    table::add(services + i);
+  check_entries(services, count);
+
+  // Removed entries are replaced by the last one.
+  table::remove(services + 2);
+  table::remove(services + count - 1);
+  table::remove(services);
+  if (services[0].scheduling_index || services[2].scheduling_index)
+    throw (engine_error() << "removed services are still indexed");
+  check_entries(services, count);
+
+  // Registered services are not added twice, unregistered services
+  // are ignored.
+  table::add(services + 3);
+  table::remove(services);
+  check_entries(services, count);
+
+  for (unsigned int i(0); i < count; ++i)
+    table::remove(services + i);
+  if (table::size())
+    throw (engine_error() << "table is not empty");
+  return (0);
+}
+
+/**
+ *  Init unit test.
+ */
+int main(int argc, char** argv) {
+  unittest utest(argc, argv, &main_test);
+  return (utest.run());
+}
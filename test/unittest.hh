@@ -26,7 +26,12 @@
 #  include "com/centreon/clib.hh"
 #  include "com/centreon/engine/broker/compatibility.hh"
 #  include "com/centreon/engine/broker/loader.hh"
+#  include "com/centreon/engine/checks/admission.hh"
 #  include "com/centreon/engine/checks/checker.hh"
+#  include "com/centreon/engine/checks/parallelism.hh"
+#  include "com/centreon/engine/commands/handler_runner.hh"
+#  include "com/centreon/engine/commands/native_pool.hh"
+#  include "com/centreon/engine/commands/reactor.hh"
 #  include "com/centreon/engine/commands/set.hh"
 #  include "com/centreon/engine/configuration/applier/state.hh"
 #  include "com/centreon/engine/configuration/state.hh"
@@ -143,7 +148,12 @@ private:
       timezone_manager::load();
       commands::set::load();
       configuration::applier::state::load();
+      checks::admission::load();
+      checks::parallelism::load();
       checks::checker::load();
+      commands::handler_runner::load();
+      commands::native_pool::load();
+      commands::reactor::load();
       events::loop::load();
       broker::loader::load();
       broker::compatibility::load();
@@ -166,7 +176,12 @@ private:
       broker::compatibility::unload();
       broker::loader::unload();
       events::loop::unload();
+      commands::reactor::unload();
+      commands::native_pool::unload();
+      commands::handler_runner::unload();
       checks::checker::unload();
+      checks::parallelism::unload();
+      checks::admission::unload();
       configuration::applier::state::unload();
       commands::set::unload();
       delete config;